@@ -365,6 +365,28 @@ struct Tag<TagClass::Gbxmodel>
 
 	struct RegionEntry
 	{
+		char          Name[32];
+		std::uint32_t Unknown20[8];
+
+		struct PermutationEntry
+		{
+			char          Name[32];
+			std::uint32_t Flags;
+			std::uint32_t Unknown24[7];
+
+			// Index into `Geometries` for each level-of-detail, from the
+			// super-low level to the super-high level. -1 if unused
+			std::int16_t SuperLowGeometry;
+			std::int16_t LowGeometry;
+			std::int16_t MediumGeometry;
+			std::int16_t HighGeometry;
+			std::int16_t SuperHighGeometry;
+
+			std::uint16_t Unknown4A;
+
+			TagBlock<void> Markers;
+		};
+		TagBlock<PermutationEntry> Permutations;
 	};
 	TagBlock<RegionEntry> Regions;
 
@@ -467,6 +489,89 @@ struct Tag<TagClass::Gbxmodel>
 	TagBlock<ShaderEntry> Shaders;
 };
 static_assert(sizeof(Tag<TagClass::Gbxmodel>) == 0xE8);
+static_assert(sizeof(Tag<TagClass::Gbxmodel>::RegionEntry) == 0x4C);
+static_assert(
+	sizeof(Tag<TagClass::Gbxmodel>::RegionEntry::PermutationEntry) == 0x58
+);
+static_assert(
+	offsetof(
+		Tag<TagClass::Gbxmodel>::RegionEntry::PermutationEntry, SuperLowGeometry
+	)
+	== 0x40
+);
+
+// All object tags(scenery, bipeds, vehicles, etc) begin with these fields
+template<>
+struct Tag<TagClass::Object>
+{
+	std::uint16_t ObjectType;
+	std::uint16_t Flags;
+	float         BoundingRadius;
+	Vector3f      BoundingOffset;
+	Vector3f      OriginOffset;
+	float         AccelerationScale;
+	std::uint32_t _Padding24;
+	TagReference  Model;
+	TagReference  AnimationGraph;
+};
+static_assert(offsetof(Tag<TagClass::Object>, BoundingRadius) == 0x4);
+static_assert(offsetof(Tag<TagClass::Object>, Model) == 0x28);
+static_assert(offsetof(Tag<TagClass::Object>, AnimationGraph) == 0x38);
+
+template<>
+struct Tag<TagClass::Decal>
+{
+	std::uint16_t Flags;
+
+	enum class DecalType : std::uint16_t
+	{
+		Scratch,
+		Splatter,
+		Burn,
+		PaintedSign,
+	} Type;
+
+	enum class DecalLayer : std::uint16_t
+	{
+		Primary,
+		Secondary,
+		Light,
+		AlphaTested,
+		Water,
+	} Layer;
+
+	std::uint16_t _Padding6;
+
+	TagReference NextDecalInChain;
+
+	// [Lower, Upper] bounds of each instance's randomized properties
+	Vector2f  Radius;
+	std::byte _Padding20[12];
+	Vector2f  Intensity;
+	Vector3f  ColorLowerBound;
+	Vector3f  ColorUpperBound;
+	std::byte _Padding4C[12];
+
+	std::uint16_t AnimationLoopFrame;
+	std::uint16_t AnimationSpeed;
+	std::byte     _Padding5C[28];
+
+	Vector2f  Lifetime;
+	Vector2f  DecayTime;
+	std::byte _Padding88[56];
+
+	std::uint16_t FramebufferBlendFunction;
+	std::uint16_t _PaddingC2;
+	std::byte     _PaddingC4[20];
+
+	TagReference Map;
+	std::byte    _PaddingE8[20];
+
+	float MaximumSpriteExtent;
+};
+static_assert(offsetof(Tag<TagClass::Decal>, Radius) == 0x18);
+static_assert(offsetof(Tag<TagClass::Decal>, ColorLowerBound) == 0x34);
+static_assert(offsetof(Tag<TagClass::Decal>, Map) == 0xD8);
 
 template<>
 struct Tag<TagClass::Shader>
@@ -1067,7 +1172,41 @@ struct Tag<TagClass::Scenario>
 	std::byte _Padding124[0xE0];
 
 	TagBlock<std::array<char, 32>> ObjectNames;
-	TagBlock<void> /*Todo*/        Scenery;
+
+	// All object-placements begin with these fields, followed by data
+	// specific to the type of object
+	struct ObjectPlacement
+	{
+		// Index into the placement's palette, 0xFFFF if unused
+		std::uint16_t PaletteIndex;
+		// Index into `ObjectNames`, -1 if unnamed
+		std::int16_t  NameIndex;
+		// Bit 0: Automatically
+		std::uint16_t NotPlaced;
+		std::int16_t  DesiredPermutation;
+		Vector3f      Position;
+		// Yaw, pitch, and roll in radians
+		Vector3f      Rotation;
+	};
+	static_assert(sizeof(ObjectPlacement) == 0x20);
+
+	template<std::size_t Size>
+	struct ObjectPlacementEntry : public ObjectPlacement
+	{
+		std::byte _Padding20[Size - sizeof(ObjectPlacement)];
+	};
+
+	using SceneryPlacement      = ObjectPlacementEntry<0x48>;
+	using BipedPlacement        = ObjectPlacementEntry<0x78>;
+	using VehiclePlacement      = ObjectPlacementEntry<0x78>;
+	using EquipmentPlacement    = ObjectPlacementEntry<0x28>;
+	using WeaponPlacement       = ObjectPlacementEntry<0x5C>;
+	using MachinePlacement      = ObjectPlacementEntry<0x40>;
+	using ControlPlacement      = ObjectPlacementEntry<0x40>;
+	using LightFixturePlacement = ObjectPlacementEntry<0x58>;
+	using SoundSceneryPlacement = ObjectPlacementEntry<0x28>;
+
+	TagBlock<SceneryPlacement> Scenery;
 
 	// A lot of the palettes are really just TagReference aligned up to a
 	// size of 0x30. So this is just a utility-wrapper for TagReference that
@@ -1078,24 +1217,24 @@ struct Tag<TagClass::Scenario>
 	};
 	static_assert(sizeof(PaletteEntry) == 0x30);
 
-	TagBlock<PaletteEntry>  SceneryPalette;
-	TagBlock<void> /*Todo*/ Bipeds;
-	TagBlock<PaletteEntry>  BipedPalette;
-	TagBlock<void> /*Todo*/ Vehicles;
-	TagBlock<PaletteEntry>  VehiclePalette;
-	TagBlock<void> /*Todo*/ Equipment;
-	TagBlock<PaletteEntry>  EquipmentPalette;
-	TagBlock<void> /*Todo*/ Weapons;
-	TagBlock<PaletteEntry>  WeaponPalette;
-	TagBlock<void> /*Todo*/ DeviceGroups;
-	TagBlock<void> /*Todo*/ Machines;
-	TagBlock<PaletteEntry>  MachinePalette;
-	TagBlock<void> /*Todo*/ Controls;
-	TagBlock<PaletteEntry>  ControlPalette;
-	TagBlock<void> /*Todo*/ LightFixtures;
-	TagBlock<PaletteEntry>  LightFixturePalette;
-	TagBlock<void> /*Todo*/ SoundScenery;
-	TagBlock<PaletteEntry>  SoundSceneryPalette;
+	TagBlock<PaletteEntry>          SceneryPalette;
+	TagBlock<BipedPlacement>        Bipeds;
+	TagBlock<PaletteEntry>          BipedPalette;
+	TagBlock<VehiclePlacement>      Vehicles;
+	TagBlock<PaletteEntry>          VehiclePalette;
+	TagBlock<EquipmentPlacement>    Equipment;
+	TagBlock<PaletteEntry>          EquipmentPalette;
+	TagBlock<WeaponPlacement>       Weapons;
+	TagBlock<PaletteEntry>          WeaponPalette;
+	TagBlock<void> /*Todo*/         DeviceGroups;
+	TagBlock<MachinePlacement>      Machines;
+	TagBlock<PaletteEntry>          MachinePalette;
+	TagBlock<ControlPlacement>      Controls;
+	TagBlock<PaletteEntry>          ControlPalette;
+	TagBlock<LightFixturePlacement> LightFixtures;
+	TagBlock<PaletteEntry>          LightFixturePalette;
+	TagBlock<SoundSceneryPlacement> SoundScenery;
+	TagBlock<PaletteEntry>          SoundSceneryPalette;
 
 	std::byte _Padding2F4[0x54];
 
@@ -1223,6 +1362,7 @@ static_assert(offsetof(Tag<TagClass::Scenario>, EditorData) == 0x104);
 static_assert(offsetof(Tag<TagClass::Scenario>, Comments) == 0x118);
 
 static_assert(offsetof(Tag<TagClass::Scenario>, ObjectNames) == 0x204);
+static_assert(offsetof(Tag<TagClass::Scenario>, Scenery) == 0x210);
 static_assert(offsetof(Tag<TagClass::Scenario>, Bipeds) == 0x228);
 static_assert(offsetof(Tag<TagClass::Scenario>, Vehicles) == 0x240);
 static_assert(offsetof(Tag<TagClass::Scenario>, Equipment) == 0x258);
@@ -1275,11 +1415,80 @@ struct Tag<TagClass::ScenarioStructureBsp>
 	std::byte _PaddingA0[0x4];
 
 	TagBlock<void> /*Todo*/ CollisionMaterials;
-	TagBlock<void> /*Todo*/ CollisionBSPs;
-	TagBlock<void> /*Todo*/ Nodes;
-	Bounds3D                WorldBounds;
-	TagBlock<void> /*Todo*/ Leaves;
-	TagBlock<void> /*Todo*/ LeafSurfaces;
+
+	struct CollisionBSP
+	{
+		struct BSP3DNode
+		{
+			// Index into `Planes`
+			std::int32_t Plane;
+
+			// If the high-bit of a child is set, then the lower 31 bits are
+			// an index into `Leaves`. A value of -1 is solid/outside space.
+			std::int32_t BackChild;
+			std::int32_t FrontChild;
+		};
+		static_assert(sizeof(BSP3DNode) == 0xC);
+		TagBlock<BSP3DNode> BSP3DNodes;
+
+		struct Plane
+		{
+			// Points where `dot(Normal, Point) - Distance >= 0` are in-front
+			Vector3f Normal;
+			float    Distance;
+		};
+		static_assert(sizeof(Plane) == 0x10);
+		TagBlock<Plane> Planes;
+
+		// Collision-leaves map 1:1 with the render-leaves of the parent BSP
+		struct Leaf
+		{
+			std::uint16_t Flags;
+			std::uint16_t BSP2DReferenceCount;
+			std::uint32_t FirstBSP2DReference;
+		};
+		static_assert(sizeof(Leaf) == 0x8);
+		TagBlock<Leaf> Leaves;
+
+		TagBlock<void> /*Todo*/ BSP2DReferences;
+		TagBlock<void> /*Todo*/ BSP2DNodes;
+		TagBlock<void> /*Todo*/ Surfaces;
+		TagBlock<void> /*Todo*/ Edges;
+		TagBlock<void> /*Todo*/ Vertices;
+	};
+	static_assert(sizeof(CollisionBSP) == 0x60);
+	TagBlock<CollisionBSP> CollisionBSPs;
+
+	struct Node
+	{
+		std::array<std::int16_t, 3> Unknown0;
+	};
+	static_assert(sizeof(Node) == 0x6);
+	TagBlock<Node> Nodes;
+
+	Bounds3D WorldBounds;
+
+	struct Leaf
+	{
+		std::array<std::int16_t, 3> Unknown0;
+		std::uint16_t               _Padding6;
+
+		// Index into `Clusters`
+		std::int16_t  Cluster;
+		std::uint16_t SurfaceReferenceCount;
+		std::int32_t  FirstSurfaceReferenceIndex;
+	};
+	static_assert(sizeof(Leaf) == 0x10);
+	TagBlock<Leaf> Leaves;
+
+	struct LeafSurface
+	{
+		// Index into `Surfaces`
+		std::int32_t Surface;
+		std::int32_t Node;
+	};
+	static_assert(sizeof(LeafSurface) == 0x8);
+	TagBlock<LeafSurface> LeafSurfaces;
 
 	using Surface = std::array<std::uint16_t, 3>;
 	TagBlock<Surface> Surfaces;
@@ -1432,7 +1641,55 @@ struct Tag<TagClass::ScenarioStructureBsp>
 	std::byte _Padding228[0x18];
 
 	TagBlock<void> /*Todo*/ Markers;
-	TagBlock<void> /*Todo*/ DetailObjects;
+
+	// Detail objects(grass, pebbles, etc) are placed within a grid of cells.
+	// The instances of each cell are grouped by their type, with one count
+	// for each set bit of the cell's `ValidLayers`
+	struct DetailObjectData
+	{
+		struct Cell
+		{
+			// Grid-coordinates of the cell
+			std::int16_t CellX;
+			std::int16_t CellY;
+			std::int16_t CellZ;
+			// Index into `ZReferenceVectors`
+			std::int16_t OffsetZ;
+			// One bit for each type of detail object within the cell
+			std::uint32_t ValidLayers;
+			// Index of the cell's first instance within `Instances`
+			std::int32_t StartIndex;
+			// Index of the cell's first count within `Counts`
+			std::int32_t CountIndex;
+
+			std::byte _Padding14[12];
+		};
+		static_assert(sizeof(Cell) == 0x20);
+		TagBlock<Cell> Cells;
+
+		struct Instance
+		{
+			// Position within the cell, in 1/256ths of the cell
+			std::uint8_t PositionX;
+			std::uint8_t PositionY;
+			std::uint8_t PositionZ;
+			// The lower 6 bits are the type of the detail object
+			std::uint8_t Data;
+			// 5:6:5 tint
+			std::uint16_t Color;
+		};
+		static_assert(sizeof(Instance) == 0x6);
+		TagBlock<Instance> Instances;
+
+		TagBlock<std::int16_t> Counts;
+
+		TagBlock<std::array<float, 4>> ZReferenceVectors;
+
+		std::byte _Padding30[0x10];
+	};
+	static_assert(sizeof(DetailObjectData) == 0x40);
+	TagBlock<DetailObjectData> DetailObjects;
+
 	TagBlock<void> /*Todo*/ RuntimeDecals;
 
 	std::byte _Padding264[0xC];
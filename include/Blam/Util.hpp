@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "Enums.hpp"
 #include "Tags.hpp"
@@ -21,6 +22,8 @@ std::size_t GetVertexStride(VertexFormat Format);
 // WordIndex = SurfaceIndex / 32
 // BitIndex = SurfaceIndex % 32
 using SurfaceOcclusionBitArray = std::span<std::uint32_t, 0x2'0000 / 32>;
+using SurfaceOcclusionBitArrayConst
+	= std::span<const std::uint32_t, 0x2'0000 / 32>;
 
 void GenerateVisibleSurfaceIndices(
 	const VirtualHeap& Heap,
@@ -29,6 +32,122 @@ void GenerateVisibleSurfaceIndices(
 	const Bounds3D& OverlapTest, SurfaceOcclusionBitArray SurfaceOcclusionArray
 );
 
+// Writes the triangles of each visible surface within
+// [SurfaceStart, SurfaceStart + SurfaceCount) into `Dest`, densely packed and
+// in their original order. Returns the number of triangles written.
+// `Dest` must be able to hold at least `SurfaceCount` triangles
+std::size_t CompactVisibleSurfaces(
+	std::span<const std::array<std::uint16_t, 3>> Surfaces,
+	SurfaceOcclusionBitArrayConst SurfaceOcclusionArray,
+	std::uint32_t SurfaceStart, std::uint32_t SurfaceCount,
+	std::span<std::array<std::uint16_t, 3>> Dest
+);
+
+// Returns true if any of the visibility-bits within
+// [SurfaceStart, SurfaceStart + SurfaceCount) differ between `A` and `B`
+bool SurfaceVisibilityChanged(
+	SurfaceOcclusionBitArrayConst A, SurfaceOcclusionBitArrayConst B,
+	std::uint32_t SurfaceStart, std::uint32_t SurfaceCount
+);
+
+// Sub-cluster bounds of a BSP baked into a structure-of-arrays layout so that
+// many bounds may be tested at once. The bound-arrays are padded to a multiple
+// of 8 with empty bounds that never intersect anything
+struct BakedSubClusterBounds
+{
+	std::vector<float> MinX, MaxX;
+	std::vector<float> MinY, MaxY;
+	std::vector<float> MinZ, MaxZ;
+
+	// Surface-indices of each sub-cluster, unpadded
+	std::vector<TagBlock<std::uint32_t>> SurfaceIndices;
+
+	// Sub-clusters of cluster `i` are within
+	// [ClusterSubClusterStart[i], ClusterSubClusterStart[i + 1])
+	std::vector<std::uint32_t> ClusterSubClusterStart;
+
+	std::size_t GetPaddedCount() const
+	{
+		return MinX.size();
+	}
+};
+
+BakedSubClusterBounds BakeSubClusterBounds(
+	const VirtualHeap& Heap, const Tag<TagClass::ScenarioStructureBsp>& BSP
+);
+
+// Tests `OverlapTest` against eight baked bounds per iteration. Bit `i % 8` of
+// `HitMask[i / 8]` is set if bound `i` intersects `OverlapTest`.
+// `HitMask` must hold at least `GetPaddedCount() / 8` bytes
+void IntersectSubClusterBounds(
+	const BakedSubClusterBounds& Bounds, const Bounds3D& OverlapTest,
+	std::span<std::uint8_t> HitMask
+);
+
+// Batched variant of `GenerateVisibleSurfaceIndices` over the baked
+// sub-clusters of a whole BSP. `HitMask` is scratch-memory of at least
+// `GetPaddedCount() / 8` bytes. If `VisibleClusters` is not empty, then only
+// the sub-clusters of the clusters whose bits are set within it are visible
+void GenerateVisibleSurfaceIndices(
+	const VirtualHeap& Heap, const BakedSubClusterBounds& Bounds,
+	const Bounds3D& OverlapTest, std::span<std::uint8_t> HitMask,
+	SurfaceOcclusionBitArray       SurfaceOcclusionArray,
+	std::span<const std::uint32_t> VisibleClusters = {}
+);
+
+// Returns the potentially-visible-set of a cluster as a bit-array in which bit
+// `i` is set if cluster `i` may be visible from within `ClusterIndex`.
+// Returns an empty span if the BSP has no valid PVS data
+std::span<const std::uint32_t> GetClusterPVS(
+	const VirtualHeap& Heap, const Tag<TagClass::ScenarioStructureBsp>& BSP,
+	std::uint16_t ClusterIndex
+);
+
+// Traverses the collision-BSP's 3D-nodes to find the leaf that contains
+// `Point`. Returns -1 if the point is within solid space or outside of the
+// BSP, or if the BSP refers to any node, plane, or leaf that does not exist
+std::int32_t FindCollisionLeaf(
+	const VirtualHeap&                                                    Heap,
+	const Tag<TagClass::ScenarioStructureBsp>::CollisionBSP& CollisionBSP,
+	const Vector3f&                                          Point
+);
+
+// Returns the index of the cluster that contains `Point`, or -1 if the point
+// is not within any cluster
+std::int16_t FindCluster(
+	const VirtualHeap& Heap, const Tag<TagClass::ScenarioStructureBsp>& BSP,
+	const Vector3f& Point
+);
+
+// Batched variant of `FindCluster`. Several points are traversed through the
+// BSP in lock-step so that the plane-tests may be done in SIMD.
+// Clusters[i] is the cluster-index of Points[i], or -1. Malformed BSP-data is
+// handled the same as `FindCollisionLeaf`
+void FindClusters(
+	const VirtualHeap& Heap, const Tag<TagClass::ScenarioStructureBsp>& BSP,
+	std::span<const Vector3f> Points, std::span<std::int16_t> Clusters
+);
+
+using ModelVertex
+	= Tag<TagClass::Gbxmodel>::GeometryEntry::PartEntry::UncompressedVertex;
+using CompressedModelVertex
+	= Tag<TagClass::Gbxmodel>::GeometryEntry::PartEntry::CompressedVertex;
+
+// Decodes a compressed model-vertex. Normals, binormals, and tangents are
+// packed as signed 11.11.10-bit vectors, and texture-coordinates are signed
+// 16-bit normalized integers that are rescaled by the model's base-map scale
+ModelVertex DecodeCompressedVertex(
+	const CompressedModelVertex& Vertex, float UScale, float VScale
+);
+
+// Batched variant of `DecodeCompressedVertex` that unpacks the vectors and
+// texture-coordinates of eight vertices per iteration.
+// `Dest` must hold at least `Source.size()` vertices
+void DecodeCompressedVertices(
+	std::span<const CompressedModelVertex> Source, float UScale, float VScale,
+	std::span<ModelVertex> Dest
+);
+
 // Enums
 const char* ToString(const CacheVersion& Value);
 const char* ToString(const ScenarioType& Value);
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Common
+{
+
+inline constexpr std::uint64_t FNV1aOffsetBasis = 0xCBF29CE484222325ULL;
+
+// 64-bit FNV-1a. Continues from `Hash`, so that several spans may be hashed
+// in sequence
+constexpr std::uint64_t HashFNV1a(
+	std::span<const std::byte> Bytes, std::uint64_t Hash = FNV1aOffsetBasis
+)
+{
+	for( const std::byte& CurByte : Bytes )
+	{
+		Hash ^= std::uint64_t(CurByte);
+		Hash *= 0x100000001B3ULL;
+	}
+	return Hash;
+}
+
+} // namespace Common
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Common
+{
+
+// A fixed set of threads that are kept alive between jobs, so that work that
+// is repeated every few frames does not pay for creating and joining threads
+// each time. Only one job runs at a time
+class WorkerPool
+{
+private:
+	// Held by the calling thread for the whole of a job, so that jobs from
+	// different threads run one after another
+	std::mutex JobMutex;
+
+	// Guards all of the members below, other than `NextIndex` and `Workers`
+	std::mutex Mutex;
+
+	// Signaled when a job is started, or when the workers are stopped
+	std::condition_variable JobCondition;
+	// Signaled when the last busy worker has finished the current job
+	std::condition_variable DoneCondition;
+
+	bool Stopping = false;
+
+	// Incremented by each job, so that each worker takes part in it once
+	std::uint64_t JobGeneration = 0;
+	std::size_t   BusyWorkers   = 0;
+
+	const std::function<void(std::size_t)>* JobProc  = nullptr;
+	std::size_t                             JobCount = 0;
+
+	std::atomic<std::size_t> NextIndex = 0;
+
+	std::vector<std::thread> Workers;
+
+	void WorkerProc();
+	void DrainJob(
+		const std::function<void(std::size_t)>& Proc, std::size_t Count
+	);
+
+public:
+	explicit WorkerPool(std::uint32_t WorkerCount);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&)            = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	std::size_t GetWorkerCount() const
+	{
+		return Workers.size();
+	}
+
+	// Calls `Proc` with each index within [0, Count) across all workers and
+	// the calling thread, and blocks until all of them have returned. Each
+	// thread takes the next index from a shared counter. `Proc` must not
+	// call `ParallelFor` of the same pool
+	void ParallelFor(
+		std::size_t Count, const std::function<void(std::size_t)>& Proc
+	);
+};
+
+} // namespace Common
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <VkBlam/VkBlam.hpp>
+
+namespace VkBlam
+{
+
+// Simplifies an indexed triangle-list with quadric error metrics.
+// Edges are collapsed onto one of their existing vertices, so the simplified
+// indices may be drawn with the unmodified vertex-data of the mesh.
+// Vertices along open edges are never moved. Texture and lightmap seams are
+// split into separate vertices, and each mesh only has a single material, so
+// this keeps all seams and material boundaries in place.
+// Collapses stop once the mesh has at most `TargetIndexCount` indices, or
+// once the next collapse would move the surface by more than `TargetError`,
+// relative to the extent of the mesh
+std::vector<std::uint32_t> SimplifyMesh(
+	std::span<const std::uint32_t> Indices,
+	std::span<const glm::f32vec3> Positions, std::size_t TargetIndexCount,
+	float TargetError
+);
+
+} // namespace VkBlam
\ No newline at end of file
@@ -1,18 +1,24 @@
 #pragma once
 
 #include <Common/Literals.hpp>
+#include <Common/WorkerPool.hpp>
 
 #include <VkBlam/VkBlam.hpp>
 #include <VkBlam/World.hpp>
 
 #include <Vulkan/Debug.hpp>
 #include <Vulkan/DescriptorUpdateBatch.hpp>
+#include <Vulkan/PipelineCache.hpp>
+#include <Vulkan/PipelineRegistry.hpp>
 #include <Vulkan/SamplerCache.hpp>
 #include <Vulkan/ShaderModuleCache.hpp>
 #include <Vulkan/StreamBuffer.hpp>
+#include <Vulkan/UniformRingBuffer.hpp>
 
+#include <filesystem>
 #include <memory>
 #include <optional>
+#include <thread>
 
 namespace VkBlam
 {
@@ -23,8 +29,23 @@ struct RendererConfig
 {
 	vk::DeviceSize StreamBufferSize = 128_MiB;
 
+	// Shared by all transient uniform-data of all frames in flight
+	vk::DeviceSize UniformBufferSize = 1_MiB;
+
 	std::size_t DescriptorWriteMax = 256;
 	std::size_t DescriptorCopyMax  = 256;
+
+	// File that the pipeline-cache is loaded from and saved to when the
+	// renderer is destroyed. Empty to keep the cache within memory
+	std::filesystem::path PipelineCachePath = {};
+
+	// Threads that compile the pipeline-variants of `PipelineRegistry` in
+	// the background
+	std::uint32_t PipelineCompileThreads = 2;
+
+	// Threads that split up the work of loading scenes, including the
+	// loading thread itself. 0 and 1 load on the loading thread only
+	std::uint32_t LoadThreads = std::thread::hardware_concurrency();
 };
 
 // Encapsulates the top-level global state of the renderer.
@@ -40,9 +61,13 @@ private:
 		DefaultRenderPasses = {};
 
 	std::unique_ptr<Vulkan::StreamBuffer>          StreamBuffer;
+	std::unique_ptr<Vulkan::UniformRingBuffer>     UniformRingBuffer;
 	std::unique_ptr<Vulkan::SamplerCache>          SamplerCache;
 	std::unique_ptr<Vulkan::ShaderModuleCache>     ShaderModuleCache;
+	std::unique_ptr<Vulkan::PipelineCache>         PipelineCache;
+	std::unique_ptr<Vulkan::PipelineRegistry>      PipelineRegistry;
 	std::unique_ptr<Vulkan::DescriptorUpdateBatch> DescriptorUpdateBatch;
+	std::unique_ptr<Common::WorkerPool>            LoadWorkers;
 
 	Renderer(const Vulkan::Context& VulkanContext);
 
@@ -61,6 +86,11 @@ public:
 		return *StreamBuffer.get();
 	}
 
+	Vulkan::UniformRingBuffer& GetUniformRingBuffer() const
+	{
+		return *UniformRingBuffer.get();
+	}
+
 	Vulkan::SamplerCache& GetSamplerCache() const
 	{
 		return *SamplerCache.get();
@@ -71,11 +101,27 @@ public:
 		return *ShaderModuleCache.get();
 	}
 
+	Vulkan::PipelineCache& GetPipelineCache() const
+	{
+		return *PipelineCache.get();
+	}
+
+	Vulkan::PipelineRegistry& GetPipelineRegistry() const
+	{
+		return *PipelineRegistry.get();
+	}
+
 	Vulkan::DescriptorUpdateBatch& GetDescriptorUpdateBatch() const
 	{
 		return *DescriptorUpdateBatch.get();
 	}
 
+	// Shared by the loading of all scenes
+	Common::WorkerPool& GetLoadWorkers() const
+	{
+		return *LoadWorkers.get();
+	}
+
 	const vk::RenderPass&
 		GetDefaultRenderPass(vk::SampleCountFlagBits SampleCount);
 
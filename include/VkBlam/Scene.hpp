@@ -1,16 +1,138 @@
 #pragma once
 
+#include <filesystem>
 #include <optional>
+#include <tuple>
 
 #include <VkBlam/Renderer.hpp>
 #include <VkBlam/SceneView.hpp>
 #include <VkBlam/World.hpp>
 
+#include <Common/WorkerPool.hpp>
+
 #include <Vulkan/DescriptorHeap.hpp>
 
 namespace VkBlam
 {
 
+// How the visible surfaces of each BSP are compacted into the index-buffer
+// that is drawn
+enum class SurfaceCompaction
+{
+	// All surfaces are always drawn
+	None,
+	// Visible surfaces are compacted on the CPU and streamed to the GPU
+	CPU,
+	// Visibility bits are streamed to the GPU and compacted by a
+	// compute-shader that also writes the indirect draw-commands
+	GPU,
+};
+
+struct SceneConfig
+{
+	// Without compaction, surfaces are still culled per-cluster using the
+	// potentially-visible-set of the view's cluster
+	SurfaceCompaction VisibleSurfaceCompaction = SurfaceCompaction::None;
+
+	// With surface-compaction, each `PrepareRender` sets the visible
+	// surfaces of each BSP to those of its sub-clusters that intersect the
+	// bounds of the view-frustum, within the potentially-visible-set of
+	// `SetViewPosition`. Disable to only set them with `SetVisibleSurfaces`
+	bool FrustumSurfaceVisibility = true;
+
+	// Frustum-cull the cluster-ranges of each mesh within a compute-shader
+	// and draw the survivors with `drawIndexedIndirectCount`. Requires the
+	// Vulkan 1.2 `drawIndirectCount` feature. Ignored with surface-compaction
+	bool GPUCulling = false;
+
+	// Whether the `drawIndirectFirstInstance` feature is enabled.
+	// GPU-culling and GPU surface-compaction pass the material-index of each
+	// draw through the `firstInstance` of their indirect draws. Without it,
+	// GPU-culling is disabled and GPU surface-compaction falls back to CPU
+	// surface-compaction
+	bool DrawIndirectFirstInstance = false;
+
+	// Whether the `multiDrawIndirect` feature is enabled. Along with
+	// `DrawIndirectFirstInstance`, all levels-of-detail of all scenario
+	// objects are drawn with a single multi-draw. Without either, each model
+	// is drawn with a direct draw of all of its placements at its most
+	// detailed level
+	bool MultiDrawIndirect = false;
+
+	// Cull the draws of GPU-culling against a depth-pyramid of the scene in
+	// two phases. The draws that were visible in the previous frame are
+	// drawn by `Render`, after which `PrepareLateRender` builds the
+	// depth-pyramid from them and `RenderLate` draws anything that has
+	// become visible since. Requires GPU-culling
+	bool OcclusionCulling = false;
+
+	// Place all bitmaps into a single descriptor-set and index them through
+	// a storage-buffer of materials, so that the BSP is drawn with one
+	// descriptor-set bind. Requires the Vulkan 1.2 `runtimeDescriptorArray`
+	// and `shaderSampledImageArrayNonUniformIndexing` features. The decals of
+	// the scenario are only drawn with bindless textures
+	bool BindlessTextures = false;
+
+	// Amount of threads that record the draw-list in parallel, each into a
+	// secondary command-buffer from its own command-pool. 0 and 1 record on
+	// the calling thread
+	std::uint32_t RecordingThreads = 0;
+
+	// Draw the depth of all meshes from a position-only vertex-stream before
+	// shading them with an equal depth-test, so that each sample is only
+	// shaded once. Alpha-tested meshes are not part of the pre-pass and are
+	// shaded with a regular depth-test
+	bool DepthPrepass = false;
+
+	// Amount of simplified levels-of-detail that are generated for each mesh
+	// at load-time, each with about half of the triangles of the previous
+	// level. Each mesh is drawn at the most detailed level whose triangles
+	// still cover an average of `LODTrianglePixels` pixels of the view.
+	// Requires merged meshes, so it is ignored with surface-compaction. At
+	// most 3
+	std::uint32_t LODCount          = 0;
+	float         LODTrianglePixels = 16.0f;
+
+	// Directory to cache the simplified levels-of-detail within, keyed by a
+	// hash of the source geometry. Empty to always generate them
+	std::filesystem::path LODCachePath = {};
+
+	// Budget of device-memory for the geometry of all BSPs, in bytes. The BSP
+	// that contains the view is always resident, and the BSPs that its
+	// potentially-visible clusters transition into are streamed in ahead of
+	// time. The least-recently requested BSPs are evicted to stay within the
+	// budget. 0 keeps all BSPs resident. Requires merged meshes, so it is
+	// ignored with surface-compaction
+	vk::DeviceSize BSPMemoryBudget = 0;
+
+	// Distance from the view within which the detail-objects of the BSPs,
+	// such as grass and pebbles, are drawn. 0 disables detail-objects
+	float DetailObjectDistance = 32.0f;
+
+	// Pipeline-statistics that may be queried by the primary command-buffer
+	// while it executes the scene's draws. Requires the `inheritedQueries`
+	// feature
+	vk::QueryPipelineStatisticFlags InheritedPipelineStatistics = {};
+};
+
+// Amount of work executed by the last frame's `Scene::Render` and
+// `Scene::RenderLate`
+struct RenderStats
+{
+	// Draws of the shading passes
+	std::uint32_t Draws = 0;
+	// Pipeline and descriptor-set binds of the shading passes
+	std::uint32_t Binds = 0;
+	// Amount of times that the pipeline or descriptor-sets differed from the
+	// previous draw
+	std::uint32_t StateChanges = 0;
+	// Draws of the depth pre-pass
+	std::uint32_t DepthPrepassDraws = 0;
+	// Triangles of scenario objects that were not drawn due to their
+	// levels-of-detail
+	std::uint32_t ObjectTrianglesSaved = 0;
+};
+
 // All rendering state associated with a world.
 class Scene
 {
@@ -18,7 +140,12 @@ private:
 	const World& TargetWorld;
 	Renderer&    TargetRenderer;
 
-	Scene(Renderer& TargetRenderer, const World& TargetWorld);
+	const SceneConfig Config;
+
+	Scene(
+		Renderer& TargetRenderer, const World& TargetWorld,
+		const SceneConfig& Config
+	);
 
 	// Temporary
 	std::unordered_map<std::uint32_t, vk::DescriptorSet>
@@ -30,6 +157,16 @@ private:
 	vk::UniquePipeline       DebugDrawPipeline       = {};
 	vk::UniquePipelineLayout DebugDrawPipelineLayout = {};
 
+	// Keys of all of the pipeline-variants that this scene has requested
+	// from the renderer's `PipelineRegistry`, each requested once. Released
+	// when the scene is destroyed, along with the layout that they are
+	// compiled against
+	std::vector<std::uint64_t> PipelineVariants;
+
+	// Keys of `PipelineVariants` that are still compiling. The draws are
+	// re-recorded as each of them becomes ready
+	std::vector<std::uint64_t> PendingPipelines;
+
 	std::unique_ptr<Vulkan::DescriptorHeap> UnlitDescriptorPool;
 
 	vk::UniquePipeline       UnlitDrawPipeline       = {};
@@ -39,18 +176,101 @@ private:
 	vk::ShaderModule DefaultFragmentShaderModule;
 	vk::ShaderModule UnlitFragmentShaderModule;
 
-	// Contains _both_ the vertex buffers and the index buffer
-	vk::UniqueDeviceMemory BSPGeometryMemory = {};
+	// The buffers of a geometry-region, within a single allocation
+	struct GeometryBuffers
+	{
+		vk::UniqueDeviceMemory Memory = {};
+
+		vk::UniqueBuffer VertexBuffer         = {};
+		vk::UniqueBuffer LightmapVertexBuffer = {};
+		vk::UniqueBuffer IndexBuffer          = {};
+		// Tightly packed positions of all vertices within `VertexBuffer`.
+		// Only with the depth pre-pass
+		vk::UniqueBuffer PositionBuffer = {};
+	};
+
+	// The geometry of each BSP is within its own region so that it may be
+	// streamed in and out on its own. Surface-compaction indexes the surfaces
+	// of all BSPs through a single index-buffer, so all of them share one
+	// region
+	struct GeometryRegion
+	{
+		// Vertices of a mesh and where they are placed within the region
+		struct VertexSource
+		{
+			std::span<const Blam::Vertex>         Vertices;
+			std::span<const Blam::LightmapVertex> LightmapVertices;
+			std::uint32_t                         VertexOffset = 0;
+		};
+
+		// Kept to upload the region again after it has been evicted
+		std::vector<VertexSource> VertexSources;
+		std::uint32_t             VertexCount = 0;
+		// Already in the format of `BSPIndexType`
+		std::vector<std::byte> IndexData;
+		// Only with the depth pre-pass
+		std::vector<glm::f32vec3> Positions;
+
+		// Bytes of device-memory that the region occupies while loaded
+		vk::DeviceSize MemorySize = 0;
+
+		GeometryBuffers Buffers = {};
+
+		enum class State
+		{
+			Evicted,
+			// Uploading until the stream-buffer reaches `UploadTick`
+			Loading,
+			Resident,
+		};
+		State         Residency  = State::Evicted;
+		std::uint64_t UploadTick = 0;
+
+		// Value of `ResidencyFrame` when the region was last requested
+		std::uint64_t LastRequestFrame = 0;
+	};
+	std::vector<GeometryRegion> GeometryRegions;
+
+	// 32-bit only if merged meshes have indices that do not fit into 16-bits
+	vk::IndexType BSPIndexType = vk::IndexType::eUint16;
+
+	//// BSP streaming
+	bool StreamGeometry = false;
+
+	// Incremented by each `UpdateResidency`
+	std::uint64_t ResidencyFrame = 0;
+
+	// The BSP that most recently contained the view
+	std::uint32_t ViewBSPIndex = 0;
+
+	// Buffers of evicted regions that pending submissions may still read.
+	// Freed once the uniform ring-buffer's semaphore reaches `Tick`
+	struct RetiredGeometry
+	{
+		std::uint64_t   Tick    = 0;
+		GeometryBuffers Buffers = {};
+	};
+	std::vector<RetiredGeometry> RetiredGeometries;
+
+	// Creates the buffers of a region and queues the upload of its geometry
+	bool LoadGeometry(std::size_t GeometryIndex);
 
-	vk::UniqueBuffer BSPVertexBuffer         = {};
-	vk::UniqueBuffer BSPLightmapVertexBuffer = {};
-	vk::UniqueBuffer BSPIndexBuffer          = {};
+	// Requests the regions that the view may soon see, loading them in the
+	// background and evicting the least-recently requested regions that no
+	// longer fit into the budget. The view's own BSP is waited upon. Returns
+	// true if the resident regions have changed
+	bool UpdateResidency(const SceneView& View);
+
+	// Including the full-detail level
+	static constexpr std::size_t MaxLODCount = 4;
 
 	struct LightmapMesh
 	{
+		// Offsets within the buffers of the mesh's geometry-region
 		std::uint32_t VertexIndexOffset = 0;
 		std::uint32_t IndexCount        = 0;
 		std::uint32_t IndexOffset       = 0;
+		std::uint32_t GeometryIndex     = 0;
 
 		std::span<const Blam::Vertex>         VertexData;
 		std::span<const Blam::LightmapVertex> LightmapVertexData;
@@ -60,9 +280,491 @@ private:
 		// Some lightmap meshes don't have a lightmap!
 		std::optional<std::uint32_t> LightmapTag;
 		std::optional<std::uint32_t> LightmapIndex;
+
+		// The BSP that this mesh belongs to and its range of surfaces within
+		// the BSP's surface-array
+		std::uint32_t BSPIndex     = 0;
+		std::uint32_t SurfaceStart = 0;
+		std::uint32_t SurfaceCount = 0;
+
+		// Amount of indices within the mesh's region of the visible-index
+		// buffer. Only used with CPU-compaction
+		std::uint32_t VisibleIndexCount = 0;
+
+		// Range of `ClusterRanges` that make up this mesh
+		std::uint32_t ClusterRangeStart = 0;
+		std::uint32_t ClusterRangeCount = 0;
+
+		glm::f32vec3 Centroid = {};
+
+		// Index-ranges of each level-of-detail. The first level is the full
+		// mesh, which is drawn through its cluster-ranges. The simplified
+		// levels follow the full-detail indices within the mesh's region
+		std::uint32_t                          LODCount        = 1;
+		std::array<std::uint32_t, MaxLODCount> LODIndexOffsets = {};
+		std::array<std::uint32_t, MaxLODCount> LODIndexCounts  = {};
+
+		// Bounding-box of the mesh, to select its level-of-detail and to
+		// cull its simplified levels. Only with levels-of-detail
+		glm::f32vec3 BoundsMin = {};
+		glm::f32vec3 BoundsMax = {};
+
+		// Excluded from the depth pre-pass
+		bool AlphaTested = false;
 	};
 	std::vector<LightmapMesh> LightmapMeshs;
 
+	// The level-of-detail that each mesh is drawn at
+	std::vector<std::uint32_t> MeshLODs;
+
+	// Selects the level-of-detail of each mesh from its projected size within
+	// the view. Returns true if any of them have changed
+	bool SelectLODs(const SceneView& View);
+
+	// The state needed to draw a lightmap mesh, resolved once at load-time.
+	// Sorted by state so that consecutive draws may share binds
+	struct DrawItem
+	{
+		// Draws of the same geometry-region share their vertex and index
+		// buffers
+		std::uint32_t     GeometryIndex = 0;
+		// Generic pipeline, used until the variant of `VariantKey` is ready
+		vk::Pipeline      Pipeline      = {};
+		// Null if the mesh's shader has no descriptor-set
+		vk::DescriptorSet ShaderSet     = {};
+		vk::DescriptorSet LightmapSet   = {};
+
+		// Also the index of the mesh's bindless material, passed to the
+		// shaders through `firstInstance`
+		std::uint32_t MeshIndex = 0;
+
+		// Key of the specialized pipeline-variant of the draw within the
+		// renderer's `PipelineRegistry`, or zero if it has none
+		std::uint64_t VariantKey = 0;
+
+		// Distance from the view to the mesh's centroid, updated each frame
+		float ViewDistance = 0.0f;
+
+		auto GetStateKey() const
+		{
+			return std::tie(
+				GeometryIndex, Pipeline, VariantKey, ShaderSet, LightmapSet
+			);
+		}
+	};
+	std::vector<DrawItem> DrawList;
+
+	RenderStats LastRenderStats = {};
+
+	// The draws of `Render` and of `RenderLate`. The late phase is only
+	// used with occlusion-culling
+	static constexpr std::size_t RenderPhaseCount = 2;
+
+	// Work of the recorded draws of each render-phase, counted into
+	// `LastRenderStats` as each phase is executed
+	std::array<RenderStats, RenderPhaseCount> RecordedStats = {};
+
+	// Command-pools are externally synchronized, so each recording-thread
+	// gets its own. The command-buffers are indexed by render-phase
+	struct RecordingContext
+	{
+		vk::UniqueCommandPool CommandPool = {};
+		std::array<vk::UniqueCommandBuffer, RenderPhaseCount> CommandBuffers
+			= {};
+		// Only allocated with the depth pre-pass. Executed before all of the
+		// other command-buffers of the same phase
+		std::array<vk::UniqueCommandBuffer, RenderPhaseCount>
+			DepthCommandBuffers = {};
+	};
+	std::vector<RecordingContext> RecordingContexts;
+
+	// One worker for each recording-context other than the first, which is
+	// recorded by the calling thread
+	std::unique_ptr<Common::WorkerPool> RecordingWorkers;
+
+	// The draws are recorded once into the secondary command-buffers and
+	// executed by each `Render` until anything that they depend on changes.
+	// Camera data is read from `SceneGlobalsBuffer`
+	std::array<std::vector<vk::CommandBuffer>, RenderPhaseCount>
+				RecordedCommandBuffers;
+	glm::uvec2 RecordedViewport = {};
+	bool       DrawsDirty       = true;
+
+	// Tick of the uniform ring-buffer of the last frame that has executed
+	// `RecordedCommandBuffers`
+	std::uint64_t ExecutedTick = 0;
+
+	vk::UniqueDeviceMemory SceneGlobalsMemory = {};
+	vk::UniqueBuffer       SceneGlobalsBuffer = {};
+
+	// Seconds
+	float SimulationTime = 0.0f;
+
+	// Re-records `RecordedCommandBuffers` from the draw-list, split across
+	// all recording-contexts. Waits for the last frame that executed them.
+	// Returns false without re-recording if they could not be waited upon,
+	// or if that frame is the one currently being recorded
+	bool RecordDrawStream(const SceneView& View);
+
+	// Records the draws within [DrawBegin, DrawEnd) along with all of the
+	// state that they need. Indexes `CullGroups` when GPU-culling and
+	// `DrawList` otherwise. `DepthOnly` records the depth pre-pass of the
+	// draws instead. `Late` draws the late phase of occlusion-culling
+	void RecordDraws(
+		const SceneView& View, vk::CommandBuffer CommandBuffer,
+		std::size_t DrawBegin, std::size_t DrawEnd, bool DepthOnly, bool Late,
+		RenderStats& Stats
+	) const;
+
+	// The surfaces of each mesh are sorted by the cluster that they belong to
+	// so that each cluster's surfaces are a contiguous range of indices
+	static constexpr std::uint16_t NoCluster = 0xFFFF;
+	struct ClusterRange
+	{
+		// `NoCluster` for surfaces that do not belong to any cluster
+		std::uint16_t Cluster     = NoCluster;
+		std::uint32_t IndexOffset = 0;
+		std::uint32_t IndexCount  = 0;
+
+		// Bounding-box of the range's vertices. Only used with GPU-culling
+		glm::f32vec3 BoundsMin = {};
+		glm::f32vec3 BoundsMax = {};
+	};
+	std::vector<ClusterRange> ClusterRanges;
+
+	//// Visible surface compaction
+	struct BSPVisibility
+	{
+		std::span<const std::array<std::uint16_t, 3>> Surfaces;
+
+		// Element-offset of the BSP's first index within `BSPIndexBuffer`
+		std::uint32_t IndexOffset = 0;
+
+		// Visibility-bits of the last update
+		std::vector<std::uint32_t> VisibleSurfaces;
+
+		// Bit-array of the clusters to draw. Empty to draw all clusters
+		std::vector<std::uint32_t> VisibleClusters;
+
+		// Baked once at load-time. Only used with surface-compaction
+		Blam::BakedSubClusterBounds SubClusterBounds;
+		// Scratch-memory of `Blam::GenerateVisibleSurfaceIndices`
+		std::vector<std::uint8_t> SubClusterHitMask;
+	};
+	std::vector<BSPVisibility> BSPVisibilities;
+
+	// Sets the visible surfaces of each BSP from the bounds of the view's
+	// frustum, see `SceneConfig::FrustumSurfaceVisibility`
+	void UpdateVisibleSurfaces(const SceneView& View);
+
+	// Same layout as `BSPIndexBuffer` where each mesh's region only contains
+	// its visible surfaces. 16-bit indices with CPU-compaction, and 32-bit
+	// indices with GPU-compaction
+	vk::UniqueDeviceMemory VisibleSurfaceMemory = {};
+	vk::UniqueBuffer       VisibleIndexBuffer   = {};
+
+	// GPU-compaction
+	vk::UniqueBuffer VisibleSurfaceBitsBuffer = {};
+	vk::UniqueBuffer CompactionMeshBuffer     = {};
+	vk::UniqueBuffer DirtyMeshBuffer          = {};
+	vk::UniqueBuffer VisibleDrawCommandBuffer = {};
+	vk::UniqueBuffer SurfaceIDBuffer          = {};
+
+	// Indices of the meshes that must be re-compacted by the GPU
+	std::vector<std::uint32_t> DirtyMeshes;
+
+	std::unique_ptr<Vulkan::DescriptorHeap> CompactionDescriptorPool;
+	vk::DescriptorSet                       CompactionDescriptor = {};
+
+	vk::ShaderModule         CompactSurfacesShaderModule;
+	vk::UniquePipeline       CompactionPipeline       = {};
+	vk::UniquePipelineLayout CompactionPipelineLayout = {};
+
+	//// Bindless textures
+	std::unique_ptr<Vulkan::DescriptorHeap> BindlessDescriptorPool;
+	vk::DescriptorSet                       BindlessDescriptor = {};
+
+	// One material for each lightmap mesh
+	vk::UniqueDeviceMemory BindlessMaterialMemory = {};
+	vk::UniqueBuffer       BindlessMaterialBuffer = {};
+
+	vk::ShaderModule         BindlessFragmentShaderModule;
+	vk::UniquePipeline       BindlessDrawPipeline       = {};
+	vk::UniquePipelineLayout BindlessDrawPipelineLayout = {};
+
+	//// Depth pre-pass
+	vk::ShaderModule         DepthPrepassVertexShaderModule;
+	vk::UniquePipeline       DepthPrepassPipeline       = {};
+	vk::UniquePipelineLayout DepthPrepassPipelineLayout = {};
+
+	// Variants of the draw-pipelines with an equal depth-test and without
+	// depth-writes, used by all draws that are part of the depth pre-pass
+	vk::UniquePipeline DebugDrawDepthEqualPipeline    = {};
+	vk::UniquePipeline BindlessDrawDepthEqualPipeline = {};
+
+	//// Material table
+	// The flattened parameters of each shader-environment tag, read by the
+	// fragment shaders of both the bound and bindless draws. Animations are
+	// evaluated on the GPU from the simulation-time
+	vk::UniqueDeviceMemory MaterialTableMemory     = {};
+	vk::UniqueBuffer       MaterialTableBuffer     = {};
+	// Index into the material-table of each lightmap mesh
+	vk::UniqueBuffer       MeshMaterialIndexBuffer = {};
+
+	//// GPU culling
+	// A run of `DrawList` that shares the same state and is drawn with a
+	// single `drawIndexedIndirectCount`
+	struct CullGroup
+	{
+		// Draw-item with the group's state
+		std::uint32_t DrawItemIndex = 0;
+		// Range of draw-commands that the culling-shader writes into
+		std::uint32_t CommandStart = 0;
+		std::uint32_t CommandCount = 0;
+	};
+	std::vector<CullGroup> CullGroups;
+	std::uint32_t          CullItemCount = 0;
+
+	vk::UniqueDeviceMemory CullMemory        = {};
+	vk::UniqueBuffer       CullItemBuffer    = {};
+	vk::UniqueBuffer       CullCommandBuffer = {};
+	vk::UniqueBuffer       CullCountBuffer   = {};
+	// `MeshLODs`, copied out of the uniform ring-buffer by `PrepareRender`.
+	// Only the cull-items of each mesh's current level-of-detail are drawn
+	vk::UniqueBuffer       CullMeshLODBuffer = {};
+
+	std::unique_ptr<Vulkan::DescriptorHeap> CullDescriptorPool;
+	vk::DescriptorSet                       CullDescriptor = {};
+
+	vk::ShaderModule         CullDrawsShaderModule;
+	vk::UniquePipeline       CullPipeline       = {};
+	vk::UniquePipelineLayout CullPipelineLayout = {};
+
+	// Must match the `CullPhase` constants of CullDraws.comp
+	enum class CullPhase : std::uint32_t
+	{
+		// Without occlusion-culling
+		All   = 0,
+		Early = 1,
+		Late  = 2,
+	};
+
+	// Writes the cull-globals of a phase into the uniform ring-buffer and
+	// dispatches the culling-shader
+	void DispatchCull(
+		const SceneView& View, vk::CommandBuffer CommandBuffer, CullPhase Phase
+	);
+
+	//// Occlusion culling
+	// Whether each cull-item was visible at the end of the previous late
+	// phase. Allocated along with the other culling buffers
+	vk::UniqueBuffer CullVisibilityBuffer = {};
+
+	// Each texel of a level holds the furthest depth of the 2x2 texels that
+	// it covers within the previous level. The culling-shader always reads
+	// the pyramid, so without occlusion-culling it is a single texel that is
+	// cleared to the far-plane
+	glm::uvec2                       DepthPyramidSize   = {};
+	vk::UniqueDeviceMemory           DepthPyramidMemory = {};
+	vk::UniqueImage                  DepthPyramidImage  = {};
+	vk::UniqueImageView              DepthPyramidView   = {};
+	std::vector<vk::UniqueImageView> DepthPyramidLevelViews;
+
+	// One descriptor-set for each level of the pyramid that is written to
+	static constexpr std::size_t MaxDepthPyramidLevels = 16;
+	std::array<vk::DescriptorSet, MaxDepthPyramidLevels>
+		DepthPyramidDescriptors = {};
+	// The depth-attachment that the first level is currently built from
+	vk::ImageView DepthPyramidSource = {};
+
+	std::unique_ptr<Vulkan::DescriptorHeap> DepthPyramidDescriptorPool;
+
+	vk::ShaderModule         DepthPyramidBaseShaderModule;
+	vk::UniquePipeline       DepthPyramidBasePipeline       = {};
+	vk::UniquePipelineLayout DepthPyramidBasePipelineLayout = {};
+
+	vk::ShaderModule         DepthPyramidReduceShaderModule;
+	vk::UniquePipeline       DepthPyramidReducePipeline       = {};
+	vk::UniquePipelineLayout DepthPyramidReducePipelineLayout = {};
+
+	// (Re)creates the depth-pyramid and records its initial clear into
+	// `CommandBuffer`
+	bool CreateDepthPyramid(glm::uvec2 Size, vk::CommandBuffer CommandBuffer);
+
+	//// Scenario objects
+	// The placements of the objects that share the same model and
+	// level-of-detail are drawn with a single instanced draw
+	static constexpr std::size_t ObjectLODCount = 5;
+	struct ObjectModel
+	{
+		std::uint32_t ModelTag = 0;
+
+		// Range of `ObjectIndexBuffer` for each level-of-detail, from the
+		// super-high level to the super-low level, indexing the model's
+		// vertices within `ObjectVertexBuffer`
+		std::array<std::uint32_t, ObjectLODCount> LODIndexOffsets = {};
+		std::array<std::uint32_t, ObjectLODCount> LODIndexCounts  = {};
+		std::uint32_t                             VertexOffset    = 0;
+
+		// Range of `ObjectInstanceBuffer`
+		std::uint32_t InstanceOffset = 0;
+		std::uint32_t InstanceCount  = 0;
+	};
+	std::vector<ObjectModel> ObjectModels;
+
+	// The rows of each placement's object-to-world transform
+	using InstanceTransform = std::array<glm::f32vec4, 3>;
+
+	// All placements in the order of `ObjectModels`. The bounds are kept as
+	// separate arrays so that the levels-of-detail are selected in batches
+	struct ObjectInstanceSet
+	{
+		std::vector<InstanceTransform> Transforms;
+
+		// World-space bounding-sphere of each placement
+		std::vector<float> CenterX;
+		std::vector<float> CenterY;
+		std::vector<float> CenterZ;
+		std::vector<float> Radius;
+
+		// The detail-cutoffs of each placement's model, in pixels, from the
+		// high-detail cutoff to the super-low cutoff. Each cutoff that the
+		// projected size of the placement does not exceed lowers its detail
+		// by one level
+		std::array<std::vector<float>, ObjectLODCount - 1> Cutoffs;
+
+		// The level-of-detail that each placement is drawn at
+		std::vector<std::uint32_t> LODs;
+	};
+	ObjectInstanceSet ObjectInstances;
+
+	// Selects the level-of-detail of each placement from its projected size
+	// within the view. Returns true if any of them have changed
+	bool SelectObjectLODs(const SceneView& View);
+
+	// Whether the placements are drawn at their selected levels-of-detail
+	bool HasObjectLODs() const
+	{
+		return Config.MultiDrawIndirect && Config.DrawIndirectFirstInstance;
+	}
+
+	vk::UniqueDeviceMemory ObjectMemory            = {};
+	vk::UniqueBuffer       ObjectVertexBuffer      = {};
+	vk::UniqueBuffer       ObjectIndexBuffer       = {};
+	// The transforms of all placements, sorted by model and level-of-detail
+	vk::UniqueBuffer       ObjectInstanceBuffer    = {};
+	// One indirect draw-command for each level-of-detail of each model
+	vk::UniqueBuffer       ObjectDrawCommandBuffer = {};
+
+	vk::ShaderModule         ObjectVertexShaderModule;
+	vk::ShaderModule         ObjectFragmentShaderModule;
+	vk::UniquePipeline       ObjectPipeline       = {};
+	vk::UniquePipelineLayout ObjectPipelineLayout = {};
+
+	// Sorts the placements by their level-of-detail and writes the
+	// draw-commands and transforms of each model's levels into
+	// `DrawCommands` and `Transforms`. Returns the amount of triangles that
+	// the levels do not draw, compared to drawing every placement at its
+	// most detailed level
+	std::uint32_t SortObjectInstances(
+		std::vector<vk::DrawIndexedIndirectCommand>& DrawCommands,
+		std::vector<InstanceTransform>&              Transforms
+	) const;
+
+	// Records the indirect draws of all levels of all models
+	void RecordObjectDraws(
+		vk::CommandBuffer CommandBuffer, RenderStats& Stats
+	) const;
+
+	//// Scenario decals
+	// All visible decals are drawn with a single instanced draw that samples
+	// the bitmap of each decal from the bindless textures, so decals are only
+	// drawn with bindless textures. Must match the inputs of Decal.vert
+	struct DecalInstance
+	{
+		glm::f32vec3  Position;
+		std::uint32_t PaletteIndex;
+		// Yaw and pitch, in radians
+		glm::f32vec2  Orientation;
+	};
+	std::vector<DecalInstance> Decals;
+
+	// The BSP and cluster of each decal of `Decals`. Decals outside of all
+	// clusters are always drawn
+	struct DecalLocation
+	{
+		std::uint16_t BSPIndex = 0;
+		std::uint16_t Cluster  = NoCluster;
+	};
+	std::vector<DecalLocation> DecalLocations;
+
+	// Set when the visible clusters have changed since the visible decals
+	// were last gathered
+	bool DecalsDirty = true;
+
+	// Writes the decals of all visible clusters into `VisibleDecals`
+	void GatherVisibleDecals(std::vector<DecalInstance>& VisibleDecals) const;
+
+	vk::UniqueDeviceMemory DecalMemory            = {};
+	vk::UniqueBuffer       DecalPaletteBuffer     = {};
+	// The decals of the visible clusters
+	vk::UniqueBuffer       DecalInstanceBuffer    = {};
+	// A single indirect draw-command of all visible decals
+	vk::UniqueBuffer       DecalDrawCommandBuffer = {};
+
+	std::unique_ptr<Vulkan::DescriptorHeap> DecalDescriptorPool;
+	vk::DescriptorSet                       DecalDescriptor = {};
+
+	vk::ShaderModule         DecalVertexShaderModule;
+	vk::ShaderModule         DecalFragmentShaderModule;
+	vk::UniquePipeline       DecalPipeline       = {};
+	vk::UniquePipelineLayout DecalPipelineLayout = {};
+
+	// Records the indirect draw of all visible decals
+	void RecordDecalDraws(
+		vk::CommandBuffer CommandBuffer, RenderStats& Stats
+	) const;
+
+	//// Detail objects
+	// The detail-objects of all BSPs are expanded and culled within a
+	// compute-shader that writes the visible ones and their instance-count
+	// for a single `drawIndirect`, so that they cost the CPU the same no
+	// matter how many there are
+	std::uint32_t DetailObjectCount = 0;
+
+	vk::UniqueDeviceMemory DetailObjectMemory            = {};
+	vk::UniqueBuffer       DetailCellBuffer              = {};
+	vk::UniqueBuffer       DetailInstanceBuffer          = {};
+	// Written by the culling-shader
+	vk::UniqueBuffer       DetailVisibleBuffer           = {};
+	vk::UniqueBuffer       DetailObjectDrawCommandBuffer = {};
+
+	std::unique_ptr<Vulkan::DescriptorHeap> DetailCullDescriptorPool;
+	vk::DescriptorSet                       DetailCullDescriptor = {};
+
+	vk::ShaderModule         DetailCullShaderModule;
+	vk::UniquePipeline       DetailCullPipeline       = {};
+	vk::UniquePipelineLayout DetailCullPipelineLayout = {};
+
+	std::unique_ptr<Vulkan::DescriptorHeap> DetailObjectDescriptorPool;
+	vk::DescriptorSet                       DetailObjectDescriptor = {};
+
+	vk::ShaderModule         DetailObjectVertexShaderModule;
+	vk::ShaderModule         DetailObjectFragmentShaderModule;
+	vk::UniquePipeline       DetailObjectPipeline       = {};
+	vk::UniquePipelineLayout DetailObjectPipelineLayout = {};
+
+	// Writes the detail-globals of the view into the uniform ring-buffer and
+	// dispatches the culling-shader
+	void DispatchDetailObjectCull(
+		const SceneView& View, vk::CommandBuffer CommandBuffer
+	);
+
+	// Records the indirect draw of all visible detail-objects
+	void RecordDetailObjectDraws(
+		vk::CommandBuffer CommandBuffer, RenderStats& Stats
+	) const;
+
 	vk::UniqueDeviceMemory BitmapHeapMemory = {};
 	BitmapHeapT            BitmapHeap       = {};
 
@@ -75,9 +777,81 @@ public:
 
 	Scene(Scene&&) = default;
 
+	// Sets the visible surfaces of a BSP. Only the meshes with surfaces
+	// whose visibility has changed since the previous update are
+	// re-compacted. Has no effect if surface-compaction is disabled
+	void SetVisibleSurfaces(
+		std::size_t                         BSPIndex,
+		Blam::SurfaceOcclusionBitArrayConst VisibleSurfaces
+	);
+
+	// Only draws the clusters of a BSP whose bits are set within
+	// `VisibleClusters`. An empty span draws all clusters. Has no effect if
+	// surface-compaction is enabled
+	void SetVisibleClusters(
+		std::size_t BSPIndex, std::span<const std::uint32_t> VisibleClusters
+	);
+
+	// Sets the visible clusters of each BSP to the potentially-visible-set of
+	// the cluster containing `Position`. BSPs that do not contain `Position`
+	// draw all of their clusters
+	void SetViewPosition(const glm::f32vec3& Position);
+
+	// Time that animated shaders are evaluated at, in seconds
+	void SetSimulationTime(float Time);
+
+	// Records any work that must happen outside of the render pass, before
+	// `Render`. This includes writing the view's camera into the scene's
+	// uniform-buffer, selecting the level-of-detail of each mesh, and
+	// streaming BSPs in and out. Pushes into the renderer's uniform
+	// ring-buffer, which must be fenced by the submission of `CommandBuffer`
+	void PrepareRender(const SceneView& View, vk::CommandBuffer CommandBuffer);
+
+	// Must be called within the scene's render pass. The subpass must have
+	// been begun with the contents returned by `GetSubpassContents`.
+	// Re-records the scene's draws only if the visibility, the
+	// levels-of-detail, the resident BSPs, or the viewport has changed, first
+	// waiting on the uniform ring-buffer for the last submitted frame that
+	// executed them. The draws may not be re-recorded again within the same
+	// frame, such as by rendering two views of different viewports, so the
+	// previous recording is executed instead and an error is reported
 	void Render(const SceneView& View, vk::CommandBuffer CommandBuffer);
 
-	static std::optional<Scene>
-		Create(Renderer& TargetRenderer, const World& TargetWorld);
+	// Whether `PrepareLateRender` and `RenderLate` must follow `Render`
+	bool HasLatePhase() const
+	{
+		return bool(DepthPyramidReducePipeline);
+	}
+
+	// Must be called outside of the render pass, after the render pass of
+	// `Render` has ended. Builds the depth-pyramid from `DepthImage`, which
+	// must be in the depth-stencil attachment layout, and culls the draws of
+	// `RenderLate` against it. `DepthImage` is returned to the same layout.
+	// Changing the viewport or `DepthImageView` must not happen while a
+	// previous submission is still pending
+	void PrepareLateRender(
+		const SceneView& View, vk::CommandBuffer CommandBuffer,
+		vk::Image DepthImage, vk::ImageView DepthImageView
+	);
+
+	// Must be called within a render pass that loads the attachments that
+	// `Render` drew into, begun with the contents returned by
+	// `GetSubpassContents`
+	void RenderLate(const SceneView& View, vk::CommandBuffer CommandBuffer);
+
+	vk::SubpassContents GetSubpassContents() const
+	{
+		return vk::SubpassContents::eSecondaryCommandBuffers;
+	}
+
+	const RenderStats& GetRenderStats() const
+	{
+		return LastRenderStats;
+	}
+
+	static std::optional<Scene> Create(
+		Renderer& TargetRenderer, const World& TargetWorld,
+		const SceneConfig& Config = {}
+	);
 };
 } // namespace VkBlam
\ No newline at end of file
@@ -10,13 +10,12 @@ namespace VkBlam
 {
 
 // Each shader creates a derived graphics pipeline as well as a
-// descriptor set+buffer that flattens out all of the material
-// parameters that need to be passed onto the fragment shader
-// itself into a uniform buffer
-// There might possibly be some runtime overhead needed for the
-// animated U/V functions and other animation phases but they might
-// just be able to be derived at runtime from the current time
-// without having to maintain a per-shader animation-state
+// descriptor set for its bitmaps. The rest of the material parameters
+// are flattened into a record within the scene's material-table
+// storage-buffer, indexed through the draw's material-index.
+// Animated U/V functions and other animation phases are derived by the
+// fragment shader from the current simulation-time without having to
+// maintain a per-shader animation-state
 class Shader
 {
 protected:
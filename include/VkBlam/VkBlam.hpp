@@ -32,6 +32,7 @@ struct BitmapHeapT
 	{
 		vk::UniqueImage     Image;
 		vk::UniqueImageView View;
+		vk::ImageViewType   ViewType = vk::ImageViewType::e2D;
 	};
 	std::unordered_map<std::uint32_t, std::map<std::uint16_t, Bitmap>> Bitmaps;
 
@@ -85,4 +86,12 @@ struct PassGlobals
 	alignas(16) glm::f32vec4 ScreenSize; // {width, height, 1/width, 1/height}
 };
 
+// Contents of the `SceneGlobalsBuffer` uniform-buffer
+struct SceneGlobals
+{
+	CameraGlobals     Camera;
+	PassGlobals       Pass;
+	SimulationGlobals Simulation;
+};
+
 } // namespace VkBlam
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <span>
 
 namespace VkBlam
 {
@@ -40,6 +41,19 @@ public:
 		return glm::f32mat2x3(WorldBoundMin, WorldBoundMax);
 	}
 
+	// Returns the index of the cluster within the specified BSP that contains
+	// `Position`
+	std::optional<std::uint16_t> FindCluster(
+		const glm::f32vec3& Position, std::size_t BSPIndex = 0
+	) const;
+
+	// Batched variant of `FindCluster`. Clusters[i] is the cluster-index of
+	// Positions[i] or -1 if the position is not within any cluster
+	void FindClusters(
+		std::span<const glm::f32vec3> Positions,
+		std::span<std::int16_t> Clusters, std::size_t BSPIndex = 0
+	) const;
+
 	static std::optional<World> Create(const Blam::MapFile& MapFile);
 };
 } // namespace VkBlam
\ No newline at end of file
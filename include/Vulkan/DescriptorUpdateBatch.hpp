@@ -50,7 +50,8 @@ public:
 	void AddImage(
 		vk::DescriptorSet TargetDescriptor, std::uint8_t TargetBinding,
 		vk::ImageView   ImageView,
-		vk::ImageLayout ImageLayout = vk::ImageLayout::eGeneral
+		vk::ImageLayout ImageLayout        = vk::ImageLayout::eGeneral,
+		std::uint32_t   TargetArrayElement = 0
 	);
 	void AddSampler(
 		vk::DescriptorSet TargetDescriptor, std::uint8_t TargetBinding,
@@ -65,7 +66,8 @@ public:
 	void AddBuffer(
 		vk::DescriptorSet TargetDescriptor, std::uint8_t TargetBinding,
 		vk::Buffer Buffer, vk::DeviceSize Offset,
-		vk::DeviceSize Size = VK_WHOLE_SIZE
+		vk::DeviceSize     Size           = VK_WHOLE_SIZE,
+		vk::DescriptorType DescriptorType = vk::DescriptorType::eStorageBuffer
 	);
 
 	void CopyBinding(
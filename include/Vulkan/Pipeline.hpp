@@ -2,7 +2,9 @@
 
 #include <Vulkan/VulkanAPI.hpp>
 
+#include <cstddef>
 #include <span>
+#include <vector>
 
 namespace Vulkan
 {
@@ -17,4 +19,42 @@ inline vk::VertexInputBindingDescription CreateVertexInputBinding(
 		BindingIndex, sizeof(T), InputRate
 	);
 }
+
+// All of the state that a graphics-pipeline is created from. Owns copies of
+// everything that it refers to, so that it may outlive the state that it
+// was described from
+struct GraphicsPipelineState
+{
+	vk::PipelineLayout Layout     = {};
+	vk::ShaderModule   VertModule = {};
+	// Pipelines without a fragment shader only write depth
+	vk::ShaderModule FragModule = {};
+
+	std::vector<vk::VertexInputBindingDescription>   VertexBindings;
+	std::vector<vk::VertexInputAttributeDescription> VertexAttributes;
+
+	vk::RenderPass          RenderPass       = {};
+	vk::SampleCountFlagBits RenderSamples    = vk::SampleCountFlagBits::e1;
+	vk::PolygonMode         PolygonMode      = vk::PolygonMode::eFill;
+	vk::CompareOp           DepthCompareOp   = vk::CompareOp::eLessOrEqual;
+	bool                    DepthWriteEnable = true;
+	bool                    BlendEnable      = false;
+
+	// Specializes the constants of the fragment shader, if not empty
+	std::vector<vk::SpecializationMapEntry> FragSpecializationEntries;
+	std::vector<std::byte>                  FragSpecializationData;
+
+	// Equal states always have equal hashes, but the hashes of different
+	// states may collide
+	std::uint64_t Hash() const;
+
+	bool operator==(const GraphicsPipelineState&) const = default;
+};
+
+// Returns a null pipeline upon failure
+vk::UniquePipeline CreateGraphicsPipeline(
+	vk::Device Device, vk::PipelineCache PipelineCache,
+	const GraphicsPipelineState& State
+);
+
 } // namespace Vulkan
\ No newline at end of file
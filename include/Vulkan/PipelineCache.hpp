@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Vulkan/VulkanAPI.hpp>
+
+#include <filesystem>
+#include <optional>
+
+namespace Vulkan
+{
+
+// A `vk::PipelineCache` that is persisted to a file between runs, so that
+// pipelines that have been compiled before are only loaded from the cache.
+// The file is only used if it was written by the same device and driver,
+// otherwise the cache starts out empty and the file is replaced upon `Save`
+class PipelineCache
+{
+private:
+	const Vulkan::Context& VulkanContext;
+
+	// Empty to keep the cache within memory
+	std::filesystem::path CachePath;
+
+	vk::UniquePipelineCache Cache;
+
+	explicit PipelineCache(const Vulkan::Context& VulkanContext);
+
+public:
+	~PipelineCache() = default;
+
+	PipelineCache(PipelineCache&&) = default;
+
+	const vk::PipelineCache& GetPipelineCache() const;
+
+	// Writes the current contents of the cache to `CachePath`
+	bool Save() const;
+
+	static std::optional<PipelineCache> Create(
+		const Vulkan::Context&       VulkanContext,
+		const std::filesystem::path& CachePath = {}
+	);
+};
+} // namespace Vulkan
\ No newline at end of file
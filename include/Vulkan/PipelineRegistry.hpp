@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Vulkan/Pipeline.hpp>
+#include <Vulkan/VulkanAPI.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Vulkan
+{
+
+// Compiles variants of graphics-pipelines on background threads so that
+// requesting one never blocks. Requests of an equal `GraphicsPipelineState`
+// share the same variant, which is owned by the registry until each of its
+// requests has been released. All of the layouts, shader-modules, and
+// render-passes of a requested variant must outlive the variant, see
+// `WaitIdle` and `ReleasePipeline`
+class PipelineRegistry
+{
+private:
+	const Vulkan::Context&  VulkanContext;
+	const vk::PipelineCache PipelineCache;
+
+	// Guards all of the members below, other than `Workers`
+	mutable std::mutex Mutex;
+
+	// Signaled when a job is queued, or when the workers are stopped
+	std::condition_variable JobCondition;
+	// Signaled when the last pending variant has finished compiling
+	std::condition_variable IdleCondition;
+
+	bool Stopping = false;
+
+	struct Variant
+	{
+		GraphicsPipelineState State;
+		std::uint64_t         Hash = 0;
+		// Null until compiled, or if the variant has failed to compile
+		vk::UniquePipeline Pipeline   = {};
+		std::uint32_t      References = 0;
+	};
+	std::unordered_map<std::uint64_t, Variant> Variants;
+
+	// Keys of `Variants` by the hash of their state. Colliding states each
+	// get their own key
+	std::unordered_multimap<std::uint64_t, std::uint64_t> VariantKeys;
+
+	// Zero is never a key
+	std::uint64_t NextKey = 1;
+
+	// Variants that are queued or currently compiling
+	std::unordered_set<std::uint64_t> PendingKeys;
+
+	std::deque<std::pair<std::uint64_t, GraphicsPipelineState>> Jobs;
+
+	std::vector<std::thread> Workers;
+
+	void WorkerProc();
+
+public:
+	PipelineRegistry(
+		const Vulkan::Context& VulkanContext, vk::PipelineCache PipelineCache,
+		std::uint32_t WorkerCount
+	);
+
+	// Waits for the variants that are currently compiling. Queued variants
+	// are dropped
+	~PipelineRegistry();
+
+	PipelineRegistry(const PipelineRegistry&)            = delete;
+	PipelineRegistry& operator=(const PipelineRegistry&) = delete;
+
+	// Queues the variant of `State` to be compiled, if it has not been
+	// requested already. Returns the key of the variant. Each request must be
+	// paired with a `ReleasePipeline`
+	std::uint64_t RequestPipeline(const GraphicsPipelineState& State);
+
+	// Releases a request of the variant of `Key`, destroying the variant once
+	// all of its requests have been released. Before its last request is
+	// released, the variant must no longer be pending or used by the device
+	void ReleasePipeline(std::uint64_t Key);
+
+	// Returns a null pipeline until the variant of `Key` has finished
+	// compiling, or if it has failed to compile
+	vk::Pipeline FindPipeline(std::uint64_t Key) const;
+
+	// True while the variant of `Key` is queued or compiling
+	bool IsPending(std::uint64_t Key) const;
+
+	// Blocks until all requested variants have finished compiling
+	void WaitIdle();
+};
+
+} // namespace Vulkan
\ No newline at end of file
@@ -5,17 +5,27 @@
 #include <optional>
 #include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace Vulkan
 {
 
-// Implements a simple pool of reusable shader module objects
+// Implements a simple pool of reusable shader module objects. Modules are
+// keyed by a hash of their SPIR-V, so identical code is only ever turned into
+// a single module, no matter where it was loaded from. The SPIR-V of each
+// module is kept to tell apart code whose hashes collide
 class ShaderModuleCache
 {
 private:
 	const Vulkan::Context& VulkanContext;
 
-	std::unordered_map<std::size_t, vk::UniqueShaderModule> ShaderModuleMap;
+	struct ShaderModuleEntry
+	{
+		std::vector<std::byte> ShaderCode;
+		vk::UniqueShaderModule ShaderModule;
+	};
+
+	std::unordered_multimap<std::uint64_t, ShaderModuleEntry> ShaderModuleMap;
 
 	explicit ShaderModuleCache(const Vulkan::Context& VulkanContext);
 
@@ -24,9 +34,8 @@ public:
 
 	ShaderModuleCache(ShaderModuleCache&&) = default;
 
-	std::optional<const vk::ShaderModule> GetShaderModule(
-		std::size_t Hash, std::span<const std::byte> ShaderCode
-	);
+	std::optional<const vk::ShaderModule>
+		GetShaderModule(std::span<const std::byte> ShaderCode);
 
 	static std::optional<ShaderModuleCache>
 		Create(const Vulkan::Context& VulkanContext);
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Vulkan/VulkanAPI.hpp>
+
+#include <deque>
+#include <optional>
+#include <span>
+
+namespace Vulkan
+{
+
+// A persistently-mapped ring of uniform-buffer memory for transient uniform
+// data such as per-frame, per-view, and per-pass globals.
+// Data is bound with a `vk::DescriptorType::eUniformBufferDynamic` descriptor
+// of `GetBuffer` so that pushing new data is a single copy, without any
+// allocations or descriptor writes. All data pushed before a call to `Fence`
+// is re-used once the timeline semaphore reaches the returned value
+class UniformRingBuffer
+{
+private:
+	const Vulkan::Context& VulkanContext;
+	const vk::DeviceSize   BufferSize;
+	// Offsets of all pushes are aligned to `minUniformBufferOffsetAlignment`
+	vk::DeviceSize OffsetAlignment;
+
+	// This is a timeline semaphore with a value that increases with each
+	// fence.
+	vk::UniqueSemaphore FenceSemaphore;
+	std::uint64_t       FenceTick;
+
+	vk::UniqueBuffer       RingBuffer;
+	vk::UniqueDeviceMemory RingBufferMemory;
+
+	// The host-mapped vulkan memory for the ring buffer
+	std::span<std::byte> RingMemoryMapped;
+	// Current write-point for the ring buffer.
+	vk::DeviceSize RingOffset;
+	// Amount of bytes, including alignment padding, that are still in use
+	vk::DeviceSize RingUsed;
+	// Amount of bytes that have been pushed since the last fence
+	vk::DeviceSize UnfencedSize;
+
+	struct FencedRegion
+	{
+		vk::DeviceSize Size;
+		std::uint64_t  Tick;
+	};
+	// Regions of the ring in the order that they were pushed
+	std::deque<FencedRegion> FencedRegions;
+
+	// Frees the regions whose fence the GPU has passed. If `Wait` is set
+	// then this will block until the oldest region is free. Returns false
+	// if there is nothing left to free
+	bool Reclaim(bool Wait);
+
+public:
+	UniformRingBuffer(
+		const Vulkan::Context& VulkanContext, vk::DeviceSize BufferSize
+	);
+
+	~UniformRingBuffer();
+
+	// Copies the passed in span of bytes into the ring buffer
+	// Upon success, returns the dynamic-offset of the data within
+	// `GetBuffer`. Blocks if the ring buffer is full of unfinished work
+	std::optional<std::uint32_t> Push(const std::span<const std::byte> Data);
+
+	template<typename T>
+	std::optional<std::uint32_t> Push(const T& Data)
+	{
+		return Push(std::as_bytes(std::span<const T, 1>(&Data, 1)));
+	}
+
+	// Marks all data pushed since the previous fence as in-use until the
+	// timeline semaphore reaches the returned value. The submission that
+	// reads this data must signal this value
+	std::uint64_t Fence();
+
+	// The value that the next call to `Fence` returns. Resources that are
+	// used by the work currently being recorded may be released once the
+	// timeline semaphore reaches it
+	std::uint64_t GetPendingTick() const;
+
+	vk::Buffer GetBuffer() const;
+
+	// The timeline-semaphore used to synchronize re-use of the ring buffer
+	const vk::Semaphore& GetSemaphore() const;
+};
+
+} // namespace Vulkan
\ No newline at end of file
@@ -0,0 +1,41 @@
+#version 460
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_GOOGLE_include_directive : require
+
+#include "vkBlam.glsl"
+
+// Each decal samples the bitmap of its palette-entry from the bindless
+// textures. Decals are tinted by the midpoint of their color-bounds and
+// blended through alpha-to-coverage
+
+layout( location = 0 ) in f32vec2       InUV;
+layout( location = 1 ) flat in uint32_t InPaletteIndex;
+
+layout( location = 0 ) out f32vec4 Attachment0;
+
+// Set 0: Scene Globals
+layout( set = 0, binding = 0 ) uniform sampler Default2DSamplerFiltered;
+
+// Set 1: All bitmaps
+layout( set = 1, binding = 0 ) uniform texture2D Textures2D[];
+
+// Set 2: Decal palette
+layout( set = 2, binding = 0 ) readonly buffer DecalPaletteBuffer {
+	DecalPaletteEntry DecalPalette[];
+};
+
+void main()
+{
+	const DecalPaletteEntry Entry = DecalPalette[InPaletteIndex];
+
+	const f32vec4 Texel = texture(
+		sampler2D(
+			Textures2D[nonuniformEXT(Entry.TextureIndex)],
+			Default2DSamplerFiltered
+		),
+		InUV
+	);
+
+	Attachment0 = f32vec4( Texel.rgb * Entry.Color.rgb, Texel.a * Entry.Color.a );
+}
@@ -0,0 +1,64 @@
+#version 460
+
+#extension GL_GOOGLE_include_directive : require
+
+#include "vkBlam.glsl"
+
+// Draws all visible decals of the scenario with a single instanced draw. Each
+// instance is expanded into a quad that faces along the decal's orientation
+
+// Set 0: Scene Globals
+layout( set = 0, binding = 3 ) uniform SceneGlobalsBuffer {
+	CameraGlobals     Camera;
+	PassGlobals       Pass;
+	SimulationGlobals Simulation;
+};
+
+// Set 2: Decal palette
+layout( set = 2, binding = 0 ) readonly buffer DecalPaletteBuffer {
+	DecalPaletteEntry DecalPalette[];
+};
+
+// Input instance data
+layout( location = 0 ) in f32vec3  InPosition;
+layout( location = 1 ) in uint32_t InPaletteIndex;
+// Yaw and pitch, in radians
+layout( location = 2 ) in f32vec2  InOrientation;
+
+// Output vertex data
+layout( location = 0 ) out f32vec2       OutUV;
+layout( location = 1 ) flat out uint32_t OutPaletteIndex;
+
+// The two triangles of each quad
+const f32vec2 QuadCorners[6] = f32vec2[](
+	f32vec2(-1.0, -1.0), f32vec2( 1.0, -1.0), f32vec2( 1.0,  1.0),
+	f32vec2(-1.0, -1.0), f32vec2( 1.0,  1.0), f32vec2(-1.0,  1.0)
+);
+
+// Decals are lifted off of their surface so that they do not fight with its
+// depth
+const float32_t SurfaceOffset = 1.0 / 256.0;
+
+void main()
+{
+	const DecalPaletteEntry Entry = DecalPalette[InPaletteIndex];
+
+	const float32_t Yaw   = InOrientation.x;
+	const float32_t Pitch = InOrientation.y;
+
+	const f32vec3 Normal = f32vec3(
+		cos(Pitch) * cos(Yaw), cos(Pitch) * sin(Yaw), sin(Pitch)
+	);
+	const f32vec3 Right = f32vec3(-sin(Yaw), cos(Yaw), 0.0);
+	const f32vec3 Up    = cross(Normal, Right);
+
+	const f32vec2 Corner = QuadCorners[gl_VertexIndex % 6];
+
+	const f32vec3 Position = InPosition + Normal * SurfaceOffset
+		+ (Right * Corner.x + Up * Corner.y) * Entry.Radius;
+
+	OutUV           = f32vec2(0.5, -0.5) * Corner + 0.5;
+	OutPaletteIndex = InPaletteIndex;
+
+	gl_Position	= Camera.ViewProjection * vec4( Position, 1.0 );
+}
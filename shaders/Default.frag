@@ -4,10 +4,6 @@
 
 #include "vkBlam.glsl"
 
-layout( push_constant ) uniform PushConstants {
-	CameraGlobals Camera;
-};
-
 // Input vertex data: Standard vertex
 layout( location = 0 ) in f32vec3 InPosition;
 layout( location = 1 ) in f32vec3 InNormal;
@@ -19,12 +15,26 @@ layout( location = 4 ) in f32vec2 InUV;
 layout( location = 5 ) in f32vec3 InLightmapNormal;
 layout( location = 6 ) in f32vec2 InLightmapUV;
 
+layout( location = 7 ) flat in uint32_t InMaterialIndex;
+
 //// Descriptor sets
 
 // Set 0: Scene Globals
 layout( set = 0, binding = 0 ) uniform sampler Default2DSamplerFiltered;
 layout( set = 0, binding = 1 ) uniform sampler Default2DSamplerUnfiltered;
 layout( set = 0, binding = 2 ) uniform sampler DefaultCubeSampler;
+layout( set = 0, binding = 3 ) uniform SceneGlobalsBuffer {
+	CameraGlobals     Camera;
+	PassGlobals       Pass;
+	SimulationGlobals Simulation;
+};
+layout( set = 0, binding = 4 ) readonly buffer MaterialTableBuffer {
+	MaterialParameters MaterialTable[];
+};
+// Index into `MaterialTable` of each mesh
+layout( set = 0, binding = 5 ) readonly buffer MeshMaterialIndicesBuffer {
+	uint32_t MeshMaterialIndices[];
+};
 
 // Set 1: Shader
 layout( set = 1, binding = 0 ) uniform texture2D BaseMapImage;
@@ -41,77 +51,4 @@ layout( set = 2, binding = 0 ) uniform texture2D LightmapImage;
 // Attachments
 layout( location = 0 ) out f32vec4 Attachment0;
 
-f32vec3 Glow(f32vec2 UV)
-{
-	const f32vec3 GlowSample = texture(sampler2D(GlowMapImage, Default2DSamplerFiltered), InUV).rgb;
-
-	f32vec3 GlowResult = f32vec3(0, 0, 0);
-
-	// Primary Animation Color
-	const f32vec3 PrimaryOnColor = f32vec3(1, 1, 1);
-	const f32vec3 PrimaryOffColor = f32vec3(1, 1, 1);
-	const float32_t PrimaryAnimationValue = 1.0;
-	GlowResult += GlowSample.r * mix(PrimaryOffColor, PrimaryOnColor, PrimaryAnimationValue);
-
-	// Secondary Animation Color
-	const f32vec3 SecondaryOnColor = f32vec3(1, 1, 1);
-	const f32vec3 SecondaryOffColor = f32vec3(1, 1, 1);
-	const float32_t SecondaryAnimationValue = 1.0;
-	GlowResult += GlowSample.g * mix(SecondaryOffColor, SecondaryOnColor, SecondaryAnimationValue);
-
-	// Plasma Animation Color
-	const f32vec3 PlasmaOnColor = f32vec3(1, 1, 1);
-	const f32vec3 PlasmaOffColor = f32vec3(1, 1, 1);
-	const float32_t PlasmaAnimationValue = 1.0;
-	GlowResult += GlowSample.b * mix(PlasmaOffColor, PlasmaOnColor, PlasmaAnimationValue);
-
-	return GlowResult;
-}
-
-f32vec3 Reflection(f32vec3 Normal)
-{
-	const f32vec3 CameraPos = (Camera.View * vec4(0.0, 0.0, 0.0, 1.0)).xyz;
-	const f32vec3 ReflectionDirection = reflect(normalize(CameraPos - InPosition), Normal);
-
-	const f32vec3 CubeSample = texture(
-		samplerCube(ReflectionCubeMapImage, DefaultCubeSampler),
-		ReflectionDirection).rgb;
-
-	// Todo, fresnel
-
-	return CubeSample;
-}
-
-f32vec3 BumpedNormal(out float32_t Alpha)
-{
-	const f32vec4 BumpSample = texture(sampler2D(BumpMapImage, Default2DSamplerFiltered), InUV);
-	Alpha = BumpSample.a;
-
-	const f32vec3 BumpVector = normalize(BumpSample.xyz * 2.0 - 1.0);
-	
-	const f32mat3 Basis = f32mat3(
-		// These vectors are linearly interpolated, re-normalize them
-		normalize(InTangent),
-		normalize(InBinormal),
-		normalize(InNormal)
-	);
-
-	return normalize(Basis * BumpVector);
-}
-
-void main()
-{
-	const f32vec4 DiffuseSample = texture(sampler2D(BaseMapImage, Default2DSamplerFiltered), InUV);
-	const f32vec4 LightmapSample = texture(sampler2D(LightmapImage, Default2DSamplerFiltered), InLightmapUV);
-	
-	float32_t Alpha = 1.0;
-	const f32vec3 Normal = BumpedNormal(Alpha);
-
-	Alpha = step(0.5, Alpha);
-
-	Attachment0 = f32vec4(
-		(DiffuseSample.rgb + Reflection(Normal) * DiffuseSample.a) * LightmapSample.rgb
-		+ Glow(InUV),
-		Alpha
-	);
-}	
\ No newline at end of file
+#include "ShaderEnvironment.glsl"
@@ -4,8 +4,11 @@
 
 #include "vkBlam.glsl"
 
-layout( push_constant ) uniform PushConstants {
-	CameraGlobals Camera;
+// Set 0: Scene Globals
+layout( set = 0, binding = 3 ) uniform SceneGlobalsBuffer {
+	CameraGlobals     Camera;
+	PassGlobals       Pass;
+	SimulationGlobals Simulation;
 };
 
 // Input vertex data: Standard vertex
@@ -29,6 +32,12 @@ layout( location = 4 ) out f32vec2 OutUV;
 layout( location = 5 ) out f32vec3 OutLightmapNormal;
 layout( location = 6 ) out f32vec2 OutLightmapUV;
 
+// Draws pass their material-index through `firstInstance`
+layout( location = 7 ) flat out uint32_t OutMaterialIndex;
+
+// Must match the depth of DepthPrepass.vert exactly
+invariant gl_Position;
+
 void main()
 {
 	OutPosition			= InPosition;
@@ -39,6 +48,8 @@ void main()
 
 	OutLightmapNormal 	= InLightmapNormal;
 	OutLightmapUV 		= InLightmapUV;
+
+	OutMaterialIndex	= gl_InstanceIndex;
 	
 	gl_Position			= Camera.ViewProjection * vec4( InPosition.xyz, 1.0 );
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+#version 460
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_GOOGLE_include_directive : require
+
+#include "vkBlam.glsl"
+
+// Input vertex data: Standard vertex
+layout( location = 0 ) in f32vec3 InPosition;
+layout( location = 1 ) in f32vec3 InNormal;
+layout( location = 2 ) in f32vec3 InBinormal;
+layout( location = 3 ) in f32vec3 InTangent;
+layout( location = 4 ) in f32vec2 InUV;
+
+// Input vertex data: Lightmap-vertex
+layout( location = 5 ) in f32vec3 InLightmapNormal;
+layout( location = 6 ) in f32vec2 InLightmapUV;
+
+layout( location = 7 ) flat in uint32_t InMaterialIndex;
+
+//// Descriptor sets
+
+// Set 0: Scene Globals
+layout( set = 0, binding = 0 ) uniform sampler Default2DSamplerFiltered;
+layout( set = 0, binding = 1 ) uniform sampler Default2DSamplerUnfiltered;
+layout( set = 0, binding = 2 ) uniform sampler DefaultCubeSampler;
+layout( set = 0, binding = 3 ) uniform SceneGlobalsBuffer {
+	CameraGlobals     Camera;
+	PassGlobals       Pass;
+	SimulationGlobals Simulation;
+};
+layout( set = 0, binding = 4 ) readonly buffer MaterialTableBuffer {
+	MaterialParameters MaterialTable[];
+};
+// Index into `MaterialTable` of each mesh
+layout( set = 0, binding = 5 ) readonly buffer MeshMaterialIndicesBuffer {
+	uint32_t MeshMaterialIndices[];
+};
+
+// Set 1: All bitmaps and the materials that index into them
+struct BindlessMaterial
+{
+	uint32_t BaseMap;
+	uint32_t PrimaryDetailMap;
+	uint32_t SecondaryDetailMap;
+	uint32_t MicroDetailMap;
+	uint32_t BumpMap;
+	uint32_t GlowMap;
+	uint32_t ReflectionCubeMap;
+	uint32_t LightmapMap;
+};
+
+layout( set = 1, binding = 0 ) uniform texture2D Textures2D[];
+layout( set = 1, binding = 1 ) uniform textureCube TexturesCube[];
+layout( set = 1, binding = 2 ) readonly buffer MaterialsBuffer {
+	BindlessMaterial Materials[];
+};
+
+// Draws of different materials may be within the same indirect draw
+#define BaseMapImage \
+	Textures2D[nonuniformEXT(Materials[InMaterialIndex].BaseMap)]
+#define PrimaryDetailMapImage \
+	Textures2D[nonuniformEXT(Materials[InMaterialIndex].PrimaryDetailMap)]
+#define SecondaryDetailMapImage \
+	Textures2D[nonuniformEXT(Materials[InMaterialIndex].SecondaryDetailMap)]
+#define MicroDetailMapImage \
+	Textures2D[nonuniformEXT(Materials[InMaterialIndex].MicroDetailMap)]
+#define BumpMapImage \
+	Textures2D[nonuniformEXT(Materials[InMaterialIndex].BumpMap)]
+#define GlowMapImage \
+	Textures2D[nonuniformEXT(Materials[InMaterialIndex].GlowMap)]
+#define ReflectionCubeMapImage \
+	TexturesCube[nonuniformEXT(Materials[InMaterialIndex].ReflectionCubeMap)]
+#define LightmapImage \
+	Textures2D[nonuniformEXT(Materials[InMaterialIndex].LightmapMap)]
+
+// Attachments
+layout( location = 0 ) out f32vec4 Attachment0;
+
+#include "ShaderEnvironment.glsl"
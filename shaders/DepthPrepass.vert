@@ -0,0 +1,26 @@
+#version 460
+
+#extension GL_GOOGLE_include_directive : require
+
+#include "vkBlam.glsl"
+
+// Writes only the depth of the BSP so that the main pass may shade each
+// sample once with an equal depth-test
+
+// Set 0: Scene Globals
+layout( set = 0, binding = 3 ) uniform SceneGlobalsBuffer {
+	CameraGlobals     Camera;
+	PassGlobals       Pass;
+	SimulationGlobals Simulation;
+};
+
+// Input vertex data: Position-only vertex
+layout( location = 0 ) in f32vec3 InPosition;
+
+// Must match the depth of Default.vert exactly
+invariant gl_Position;
+
+void main()
+{
+	gl_Position = Camera.ViewProjection * vec4( InPosition.xyz, 1.0 );
+}
\ No newline at end of file
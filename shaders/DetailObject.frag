@@ -0,0 +1,24 @@
+#version 460
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+#extension GL_GOOGLE_include_directive : require
+
+#include "vkBlam.glsl"
+
+// Detail-objects are drawn as round dots of their 5:6:5 tint, with their
+// edges blended through alpha-to-coverage
+
+layout( location = 0 ) in f32vec2       InUV;
+layout( location = 1 ) flat in uint32_t InColor;
+
+layout( location = 0 ) out f32vec4 Attachment0;
+
+void main()
+{
+	const f32vec3 Color = f32vec3(
+		(InColor >> 11) & 0x1F, (InColor >> 5) & 0x3F, InColor & 0x1F
+	) / f32vec3(31.0, 63.0, 31.0);
+
+	const float32_t Coverage = clamp(2.0 - 2.0 * length(InUV), 0.0, 1.0);
+
+	Attachment0 = f32vec4( Color, Coverage );
+}
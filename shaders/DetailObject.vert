@@ -0,0 +1,57 @@
+#version 460
+
+#extension GL_GOOGLE_include_directive : require
+
+#include "vkBlam.glsl"
+
+// Draws all visible detail-objects with a single indirect draw. Each instance
+// is expanded into a quad that faces the camera and stands on the position of
+// the detail-object
+
+// Set 0: Scene Globals
+layout( set = 0, binding = 3 ) uniform SceneGlobalsBuffer {
+	CameraGlobals     Camera;
+	PassGlobals       Pass;
+	SimulationGlobals Simulation;
+};
+
+// Set 1: Visible detail-objects, written by DetailObjects.comp
+layout( set = 1, binding = 0 ) readonly buffer VisibleDetailsBuffer {
+	VisibleDetail VisibleDetails[];
+};
+
+// Output vertex data
+layout( location = 0 ) out f32vec2       OutUV;
+layout( location = 1 ) flat out uint32_t OutColor;
+
+// The two triangles of each quad
+const f32vec2 QuadCorners[6] = f32vec2[](
+	f32vec2(-1.0, -1.0), f32vec2( 1.0, -1.0), f32vec2( 1.0,  1.0),
+	f32vec2(-1.0, -1.0), f32vec2( 1.0,  1.0), f32vec2(-1.0,  1.0)
+);
+
+// Must match the `DetailRadius` of DetailObjects.comp
+const float32_t DetailRadius = 0.0625;
+
+void main()
+{
+	const VisibleDetail Detail = VisibleDetails[gl_InstanceIndex];
+
+	// The rows of the view-matrix are the camera's axes in world-space
+	const f32vec3 Right = f32vec3(
+		Camera.View[0][0], Camera.View[1][0], Camera.View[2][0]
+	);
+	const f32vec3 Up = f32vec3(
+		Camera.View[0][1], Camera.View[1][1], Camera.View[2][1]
+	);
+
+	const f32vec2 Corner = QuadCorners[gl_VertexIndex % 6];
+
+	const f32vec3 Position = Detail.Position
+		+ (Right * Corner.x + Up * (Corner.y + 1.0)) * DetailRadius;
+
+	OutUV    = Corner;
+	OutColor = Detail.Color;
+
+	gl_Position	= Camera.ViewProjection * vec4( Position, 1.0 );
+}
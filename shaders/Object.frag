@@ -0,0 +1,19 @@
+#version 460
+#extension GL_EXT_shader_explicit_arithmetic_types : require
+
+// Objects are not textured yet, and are shaded from their normals alone
+
+layout( location = 0 ) in f32vec3 InNormal;
+layout( location = 1 ) in f32vec2 InUV;
+
+layout( location = 0 ) out f32vec4 Attachment0;
+
+void main()
+{
+	const f32vec3 LightDirection = normalize( f32vec3( 0.25, 0.5, 1.0 ) );
+
+	const float Diffuse
+		= 0.5 + 0.5 * dot( normalize( InNormal ), LightDirection );
+
+	Attachment0 = f32vec4( f32vec3( Diffuse ), 1.0 );
+}
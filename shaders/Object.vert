@@ -0,0 +1,46 @@
+#version 460
+
+#extension GL_GOOGLE_include_directive : require
+
+#include "vkBlam.glsl"
+
+// Draws all placements of an object's model with a single instanced draw,
+// transforming the model's vertices by the transform of each instance
+
+// Set 0: Scene Globals
+layout( set = 0, binding = 3 ) uniform SceneGlobalsBuffer {
+	CameraGlobals     Camera;
+	PassGlobals       Pass;
+	SimulationGlobals Simulation;
+};
+
+// Input vertex data: Model vertex
+layout( location = 0 ) in f32vec3 InPosition;
+layout( location = 1 ) in f32vec3 InNormal;
+layout( location = 2 ) in f32vec3 InBinormal;
+layout( location = 3 ) in f32vec3 InTangent;
+layout( location = 4 ) in f32vec2 InUV;
+
+// Input instance data: Rows of the instance's object-to-world transform
+layout( location = 5 ) in f32vec4 InTransform0;
+layout( location = 6 ) in f32vec4 InTransform1;
+layout( location = 7 ) in f32vec4 InTransform2;
+
+// Output vertex data
+layout( location = 0 ) out f32vec3 OutNormal;
+layout( location = 1 ) out f32vec2 OutUV;
+
+void main()
+{
+	const f32mat3x4 Transform = f32mat3x4(
+		InTransform0, InTransform1, InTransform2
+	);
+
+	// Row-vector multiplication with the rows of the transform
+	const f32vec3 Position = f32vec4( InPosition, 1.0 ) * Transform;
+
+	OutNormal	= normalize( f32vec4( InNormal, 0.0 ) * Transform );
+	OutUV		= InUV;
+
+	gl_Position	= Camera.ViewProjection * vec4( Position, 1.0 );
+}
@@ -0,0 +1,191 @@
+// Shading of the BSP's shader_environment materials.
+// Expects the vertex inputs, the `SceneGlobalsBuffer`, the material-table,
+// the scene samplers, `Attachment0`, and each of the material's images to be
+// declared before being included.
+
+const float32_t Pi = 3.14159265358979323846;
+
+// Must match `Blam::AnimationFunction`
+const uint32_t AnimationOne                        = 0;
+const uint32_t AnimationZero                       = 1;
+const uint32_t AnimationCosine                     = 2;
+const uint32_t AnimationCosineVariablePeriod       = 3;
+const uint32_t AnimationDiagonalWave               = 4;
+const uint32_t AnimationDiagonalWaveVariablePeriod = 5;
+const uint32_t AnimationSlide                      = 6;
+const uint32_t AnimationSlideVariablePeriod        = 7;
+const uint32_t AnimationNoise                      = 8;
+const uint32_t AnimationJitter                     = 9;
+const uint32_t AnimationWander                     = 10;
+const uint32_t AnimationSpark                      = 11;
+
+// Must match `Blam::Tag<ShaderEnvironment>::ShaderBitFlags`
+const uint32_t ShaderFlagAlphaTested = 1 << 0;
+
+// Must match `MaterialFeature` within Scene.cpp
+const uint32_t MaterialFeatureBumpMap     = 1 << 0;
+const uint32_t MaterialFeatureGlowMap     = 1 << 1;
+const uint32_t MaterialFeatureReflection  = 1 << 2;
+const uint32_t MaterialFeatureAlphaTested = 1 << 3;
+
+// The features that the pipeline is specialized for. The shading and texture
+// fetches of all other features are compiled out. Pipelines that draw many
+// kinds of materials keep the default of all features
+layout( constant_id = 0 ) const uint32_t MaterialFeatures = 0xFFFFFFFFu;
+
+const bool HasBumpMap    = (MaterialFeatures & MaterialFeatureBumpMap) != 0;
+const bool HasGlowMap    = (MaterialFeatures & MaterialFeatureGlowMap) != 0;
+const bool HasReflection = (MaterialFeatures & MaterialFeatureReflection) != 0;
+const bool HasAlphaTest  = (MaterialFeatures & MaterialFeatureAlphaTested) != 0;
+
+// A random value within [0, 1) for each whole step of `t`
+float32_t AnimationRandom(float32_t t)
+{
+	return fract(sin(floor(t) * 12.9898) * 43758.5453);
+}
+
+// Evaluates an animation-function into [0, 1] at the current simulation-time.
+// The variable-period functions are evaluated with their fixed period
+float32_t EvaluateAnimation(
+	uint32_t Function, float32_t Period, float32_t Phase
+)
+{
+	// A period of zero is one second
+	const float32_t t
+		= Simulation.Time / (Period > 0.0 ? Period : 1.0) + Phase;
+
+	switch( Function )
+	{
+	case AnimationOne:
+		return 1.0;
+	case AnimationZero:
+		return 0.0;
+	case AnimationCosine:
+	case AnimationCosineVariablePeriod:
+		return cos(t * 2.0 * Pi) * 0.5 + 0.5;
+	case AnimationDiagonalWave:
+	case AnimationDiagonalWaveVariablePeriod:
+		return 1.0 - abs(fract(t) * 2.0 - 1.0);
+	case AnimationSlide:
+	case AnimationSlideVariablePeriod:
+		return fract(t);
+	case AnimationNoise:
+		return AnimationRandom(t);
+	case AnimationJitter:
+		return AnimationRandom(t * 16.0);
+	case AnimationWander:
+		return mix(
+			AnimationRandom(t), AnimationRandom(t + 1.0),
+			smoothstep(0.0, 1.0, fract(t))
+		);
+	case AnimationSpark:
+		return clamp(fract(t) * t, 0.0, 1.0);
+	}
+	return 1.0;
+}
+
+f32vec3 EvaluateGlow(GlowAnimation Animation)
+{
+	return mix(
+		Animation.OffColor, Animation.OnColor,
+		EvaluateAnimation(
+			Animation.Function, Animation.Period, Animation.Phase
+		)
+	);
+}
+
+f32vec3 Glow(MaterialParameters Material, f32vec2 UV)
+{
+	const f32vec3 GlowSample = texture(
+		sampler2D(GlowMapImage, Default2DSamplerFiltered),
+		UV * Material.GlowMapScale
+	).rgb;
+
+	f32vec3 GlowResult = f32vec3(0, 0, 0);
+
+	GlowResult += GlowSample.r * EvaluateGlow(Material.PrimaryGlow);
+	GlowResult += GlowSample.g * EvaluateGlow(Material.SecondaryGlow);
+	GlowResult += GlowSample.b * EvaluateGlow(Material.PlasmaGlow);
+
+	return GlowResult;
+}
+
+f32vec3 Reflection(MaterialParameters Material, f32vec3 Normal)
+{
+	const f32vec3 CameraPos = (Camera.View * vec4(0.0, 0.0, 0.0, 1.0)).xyz;
+	const f32vec3 ViewDirection = normalize(CameraPos - InPosition);
+	const f32vec3 ReflectionDirection = reflect(ViewDirection, Normal);
+
+	const f32vec3 CubeSample = texture(
+		samplerCube(ReflectionCubeMapImage, DefaultCubeSampler),
+		ReflectionDirection).rgb;
+
+	// Blend from the perpendicular to the parallel tint at grazing angles
+	const float32_t Fresnel
+		= pow(1.0 - clamp(dot(ViewDirection, Normal), 0.0, 1.0), 5.0);
+	const f32vec3 Tint = mix(
+		Material.PerpendicularColor * Material.PerpendicularBrightness,
+		Material.ParallelColor * Material.ParallelBrightness,
+		Fresnel
+	);
+
+	return CubeSample * Tint;
+}
+
+f32vec3 BumpedNormal(MaterialParameters Material, out float32_t Alpha)
+{
+	const f32vec2 BumpUV = InUV * Material.BumpMapScale + f32vec2(
+		Material.UAnimationScale * EvaluateAnimation(
+			Material.UAnimationFunction, Material.UAnimationPeriod, 0.0
+		),
+		Material.VAnimationScale * EvaluateAnimation(
+			Material.VAnimationFunction, Material.VAnimationPeriod, 0.0
+		)
+	);
+	const f32vec4 BumpSample = texture(sampler2D(BumpMapImage, Default2DSamplerFiltered), BumpUV);
+	Alpha = BumpSample.a;
+
+	const f32vec3 BumpVector = normalize(BumpSample.xyz * 2.0 - 1.0);
+	
+	const f32mat3 Basis = f32mat3(
+		// These vectors are linearly interpolated, re-normalize them
+		normalize(InTangent),
+		normalize(InBinormal),
+		normalize(InNormal)
+	);
+
+	return normalize(Basis * BumpVector);
+}
+
+void main()
+{
+	const MaterialParameters Material
+		= MaterialTable[MeshMaterialIndices[InMaterialIndex]];
+
+	const f32vec4 DiffuseSample = texture(sampler2D(BaseMapImage, Default2DSamplerFiltered), InUV);
+	const f32vec4 LightmapSample = texture(sampler2D(LightmapImage, Default2DSamplerFiltered), InLightmapUV);
+	
+	float32_t Alpha  = 1.0;
+	f32vec3   Normal = normalize(InNormal);
+	if( HasBumpMap )
+	{
+		Normal = BumpedNormal(Material, Alpha);
+	}
+
+	const bool AlphaTested
+		= HasAlphaTest && (Material.ShaderFlags & ShaderFlagAlphaTested) != 0;
+	Alpha = AlphaTested ? step(0.5, Alpha) : 1.0;
+
+	f32vec3 Color = DiffuseSample.rgb;
+	if( HasReflection )
+	{
+		Color += Reflection(Material, Normal) * DiffuseSample.a;
+	}
+	Color *= LightmapSample.rgb;
+	if( HasGlowMap )
+	{
+		Color += Glow(Material, InUV);
+	}
+
+	Attachment0 = f32vec4(Color, Alpha);
+}	
\ No newline at end of file
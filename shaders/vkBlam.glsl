@@ -14,4 +14,62 @@ struct SimulationGlobals
 struct PassGlobals
 {
 	f32vec4 ScreenSize; // {width, height, 1/width, 1/height}
+};
+
+// Must match `GlowAnimation` within Scene.cpp
+struct GlowAnimation
+{
+	f32vec3   OnColor;
+	float32_t Period;
+	f32vec3   OffColor;
+	float32_t Phase;
+	// `Blam::AnimationFunction`
+	uint32_t  Function;
+};
+
+// Flattened parameters of a shader-environment tag within the scene's
+// material-table. Must match `MaterialParameters` within Scene.cpp
+struct MaterialParameters
+{
+	GlowAnimation PrimaryGlow;
+	GlowAnimation SecondaryGlow;
+	GlowAnimation PlasmaGlow;
+
+	// Scrolling of the bump-map's texture-coordinates
+	uint32_t  UAnimationFunction;
+	float32_t UAnimationPeriod;
+	float32_t UAnimationScale;
+	uint32_t  VAnimationFunction;
+	float32_t VAnimationPeriod;
+	float32_t VAnimationScale;
+
+	float32_t BumpMapScale;
+	float32_t GlowMapScale;
+
+	f32vec3   PerpendicularColor;
+	float32_t PerpendicularBrightness;
+	f32vec3   ParallelColor;
+	float32_t ParallelBrightness;
+
+	// `Blam::Tag<ShaderEnvironment>::ShaderBitFlags`
+	uint32_t ShaderFlags;
+};
+
+// Properties of each entry of the scenario's decal-palette. Must match
+// `DecalPaletteEntry` within Scene.cpp
+struct DecalPaletteEntry
+{
+	// rgb is the color, a is the intensity
+	f32vec4   Color;
+	float32_t Radius;
+	// Index into the 2D bitmaps of the bindless textures
+	uint32_t  TextureIndex;
+	uint32_t  _Padding[2];
+};
+
+// Written by DetailObjects.comp and read by DetailObject.vert
+struct VisibleDetail
+{
+	f32vec3  Position;
+	uint32_t Color;
 };
\ No newline at end of file
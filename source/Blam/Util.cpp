@@ -1,5 +1,17 @@
 #include <Blam/Util.hpp>
+
+// Intrinsic headers must be included before Common/Endian.hpp, which
+// includes them within its own namespace
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #include <Common/Endian.hpp>
+#include <algorithm>
+#include <bit>
+#include <limits>
 #include <memory>
 
 namespace Blam
@@ -52,6 +64,783 @@ void GenerateVisibleSurfaceIndices(
 	}
 }
 
+// Mask of the bits of occlusion-word `WordIndex` that are within
+// [SurfaceStart, SurfaceEnd)
+static std::uint32_t SurfaceRangeWordMask(
+	std::uint32_t WordIndex, std::uint32_t SurfaceStart,
+	std::uint32_t SurfaceEnd
+)
+{
+	const std::uint32_t WordBase = WordIndex * 32;
+	std::uint32_t       Mask     = ~0u;
+	if( WordBase < SurfaceStart )
+	{
+		Mask &= ~0u << (SurfaceStart - WordBase);
+	}
+	if( SurfaceEnd - WordBase < 32 )
+	{
+		Mask &= (1u << (SurfaceEnd - WordBase)) - 1u;
+	}
+	return Mask;
+}
+
+std::size_t CompactVisibleSurfaces(
+	std::span<const std::array<std::uint16_t, 3>> Surfaces,
+	SurfaceOcclusionBitArrayConst SurfaceOcclusionArray,
+	std::uint32_t SurfaceStart, std::uint32_t SurfaceCount,
+	std::span<std::array<std::uint16_t, 3>> Dest
+)
+{
+	const std::uint32_t SurfaceEnd = SurfaceStart + SurfaceCount;
+
+	std::size_t DestIndex = 0;
+	for( std::uint32_t WordIndex = SurfaceStart / 32;
+		 WordIndex * 32 < SurfaceEnd; ++WordIndex )
+	{
+		std::uint32_t VisibleBits
+			= SurfaceOcclusionArray[WordIndex]
+			& SurfaceRangeWordMask(WordIndex, SurfaceStart, SurfaceEnd);
+
+		// Rather than visiting each bit, copy each contiguous run of visible
+		// surfaces at once. Fully-visible words become a single 32-surface
+		// copy and empty words are skipped entirely.
+		while( VisibleBits )
+		{
+			const std::uint32_t RunStart = std::countr_zero(VisibleBits);
+			const std::uint32_t RunLength
+				= std::countr_one(VisibleBits >> RunStart);
+
+			const auto Run
+				= Surfaces.subspan(WordIndex * 32 + RunStart, RunLength);
+			std::copy(Run.begin(), Run.end(), Dest.begin() + DestIndex);
+			DestIndex += RunLength;
+
+			if( RunLength == 32 )
+			{
+				break;
+			}
+			VisibleBits &= ~(((1u << RunLength) - 1u) << RunStart);
+		}
+	}
+
+	return DestIndex;
+}
+
+bool SurfaceVisibilityChanged(
+	SurfaceOcclusionBitArrayConst A, SurfaceOcclusionBitArrayConst B,
+	std::uint32_t SurfaceStart, std::uint32_t SurfaceCount
+)
+{
+	const std::uint32_t SurfaceEnd = SurfaceStart + SurfaceCount;
+	for( std::uint32_t WordIndex = SurfaceStart / 32;
+		 WordIndex * 32 < SurfaceEnd; ++WordIndex )
+	{
+		if( (A[WordIndex] ^ B[WordIndex])
+			& SurfaceRangeWordMask(WordIndex, SurfaceStart, SurfaceEnd) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+BakedSubClusterBounds BakeSubClusterBounds(
+	const VirtualHeap& Heap, const Tag<TagClass::ScenarioStructureBsp>& BSP
+)
+{
+	BakedSubClusterBounds Baked;
+
+	const auto Clusters = Heap.GetBlock(BSP.Clusters);
+
+	Baked.ClusterSubClusterStart.reserve(Clusters.size() + 1);
+	for( const auto& CurCluster : Clusters )
+	{
+		Baked.ClusterSubClusterStart.push_back(
+			static_cast<std::uint32_t>(Baked.SurfaceIndices.size())
+		);
+		for( const auto& CurSubCluster : Heap.GetBlock(CurCluster.SubClusters) )
+		{
+			Baked.MinX.push_back(CurSubCluster.WorldBounds.BoundsX[0]);
+			Baked.MaxX.push_back(CurSubCluster.WorldBounds.BoundsX[1]);
+			Baked.MinY.push_back(CurSubCluster.WorldBounds.BoundsY[0]);
+			Baked.MaxY.push_back(CurSubCluster.WorldBounds.BoundsY[1]);
+			Baked.MinZ.push_back(CurSubCluster.WorldBounds.BoundsZ[0]);
+			Baked.MaxZ.push_back(CurSubCluster.WorldBounds.BoundsZ[1]);
+			Baked.SurfaceIndices.push_back(CurSubCluster.SurfaceIndices);
+		}
+	}
+	Baked.ClusterSubClusterStart.push_back(
+		static_cast<std::uint32_t>(Baked.SurfaceIndices.size())
+	);
+
+	// Pad with inverted(empty) bounds so that the kernel never has to handle
+	// a partial iteration
+	const std::size_t PaddedCount = (Baked.SurfaceIndices.size() + 7) & ~7ull;
+	constexpr float   Infinity    = std::numeric_limits<float>::infinity();
+	Baked.MinX.resize(PaddedCount, Infinity);
+	Baked.MaxX.resize(PaddedCount, -Infinity);
+	Baked.MinY.resize(PaddedCount, Infinity);
+	Baked.MaxY.resize(PaddedCount, -Infinity);
+	Baked.MinZ.resize(PaddedCount, Infinity);
+	Baked.MaxZ.resize(PaddedCount, -Infinity);
+
+	return Baked;
+}
+
+void IntersectSubClusterBounds(
+	const BakedSubClusterBounds& Bounds, const Bounds3D& OverlapTest,
+	std::span<std::uint8_t> HitMask
+)
+{
+	const std::size_t Count = Bounds.GetPaddedCount();
+
+	// Bounds intersect when `Min <= Test.Max && Max >= Test.Min` on all axes
+#if defined(__SSE2__) || defined(_M_X64)
+	const __m128 TestMinX = _mm_set1_ps(OverlapTest.BoundsX[0]);
+	const __m128 TestMaxX = _mm_set1_ps(OverlapTest.BoundsX[1]);
+	const __m128 TestMinY = _mm_set1_ps(OverlapTest.BoundsY[0]);
+	const __m128 TestMaxY = _mm_set1_ps(OverlapTest.BoundsY[1]);
+	const __m128 TestMinZ = _mm_set1_ps(OverlapTest.BoundsZ[0]);
+	const __m128 TestMaxZ = _mm_set1_ps(OverlapTest.BoundsZ[1]);
+
+	const auto Intersect4 = [&](std::size_t Index) -> std::uint8_t {
+		__m128 Hit = _mm_and_ps(
+			_mm_cmple_ps(_mm_loadu_ps(&Bounds.MinX[Index]), TestMaxX),
+			_mm_cmpge_ps(_mm_loadu_ps(&Bounds.MaxX[Index]), TestMinX)
+		);
+		Hit = _mm_and_ps(
+			Hit, _mm_cmple_ps(_mm_loadu_ps(&Bounds.MinY[Index]), TestMaxY)
+		);
+		Hit = _mm_and_ps(
+			Hit, _mm_cmpge_ps(_mm_loadu_ps(&Bounds.MaxY[Index]), TestMinY)
+		);
+		Hit = _mm_and_ps(
+			Hit, _mm_cmple_ps(_mm_loadu_ps(&Bounds.MinZ[Index]), TestMaxZ)
+		);
+		Hit = _mm_and_ps(
+			Hit, _mm_cmpge_ps(_mm_loadu_ps(&Bounds.MaxZ[Index]), TestMinZ)
+		);
+		return static_cast<std::uint8_t>(_mm_movemask_ps(Hit));
+	};
+
+	for( std::size_t i = 0; i < Count; i += 8 )
+	{
+		HitMask[i / 8] = Intersect4(i) | (Intersect4(i + 4) << 4);
+	}
+#elif defined(__aarch64__)
+	const float32x4_t TestMinX = vdupq_n_f32(OverlapTest.BoundsX[0]);
+	const float32x4_t TestMaxX = vdupq_n_f32(OverlapTest.BoundsX[1]);
+	const float32x4_t TestMinY = vdupq_n_f32(OverlapTest.BoundsY[0]);
+	const float32x4_t TestMaxY = vdupq_n_f32(OverlapTest.BoundsY[1]);
+	const float32x4_t TestMinZ = vdupq_n_f32(OverlapTest.BoundsZ[0]);
+	const float32x4_t TestMaxZ = vdupq_n_f32(OverlapTest.BoundsZ[1]);
+
+	static const std::uint32_t LaneBits[4] = {1, 2, 4, 8};
+	const uint32x4_t           LaneMask    = vld1q_u32(LaneBits);
+
+	const auto Intersect4 = [&](std::size_t Index) -> std::uint8_t {
+		uint32x4_t Hit = vandq_u32(
+			vcleq_f32(vld1q_f32(&Bounds.MinX[Index]), TestMaxX),
+			vcgeq_f32(vld1q_f32(&Bounds.MaxX[Index]), TestMinX)
+		);
+		Hit = vandq_u32(
+			Hit, vcleq_f32(vld1q_f32(&Bounds.MinY[Index]), TestMaxY)
+		);
+		Hit = vandq_u32(
+			Hit, vcgeq_f32(vld1q_f32(&Bounds.MaxY[Index]), TestMinY)
+		);
+		Hit = vandq_u32(
+			Hit, vcleq_f32(vld1q_f32(&Bounds.MinZ[Index]), TestMaxZ)
+		);
+		Hit = vandq_u32(
+			Hit, vcgeq_f32(vld1q_f32(&Bounds.MaxZ[Index]), TestMinZ)
+		);
+		return static_cast<std::uint8_t>(vaddvq_u32(vandq_u32(Hit, LaneMask)));
+	};
+
+	for( std::size_t i = 0; i < Count; i += 8 )
+	{
+		HitMask[i / 8] = Intersect4(i) | (Intersect4(i + 4) << 4);
+	}
+#else
+	for( std::size_t i = 0; i < Count; i += 8 )
+	{
+		std::uint8_t CurMask = 0;
+		for( std::size_t Lane = 0; Lane < 8; ++Lane )
+		{
+			const std::size_t Index = i + Lane;
+			const bool Hit = (Bounds.MinX[Index] <= OverlapTest.BoundsX[1])
+						  && (Bounds.MaxX[Index] >= OverlapTest.BoundsX[0])
+						  && (Bounds.MinY[Index] <= OverlapTest.BoundsY[1])
+						  && (Bounds.MaxY[Index] >= OverlapTest.BoundsY[0])
+						  && (Bounds.MinZ[Index] <= OverlapTest.BoundsZ[1])
+						  && (Bounds.MaxZ[Index] >= OverlapTest.BoundsZ[0]);
+			CurMask |= static_cast<std::uint8_t>(Hit) << Lane;
+		}
+		HitMask[i / 8] = CurMask;
+	}
+#endif
+}
+
+void GenerateVisibleSurfaceIndices(
+	const VirtualHeap& Heap, const BakedSubClusterBounds& Bounds,
+	const Bounds3D& OverlapTest, std::span<std::uint8_t> HitMask,
+	SurfaceOcclusionBitArray       SurfaceOcclusionArray,
+	std::span<const std::uint32_t> VisibleClusters
+)
+{
+	HitMask = HitMask.first(Bounds.GetPaddedCount() / 8);
+	IntersectSubClusterBounds(Bounds, OverlapTest, HitMask);
+
+	// Drop the hits of the sub-clusters of each cluster that is not visible
+	if( !VisibleClusters.empty() )
+	{
+		for( std::size_t ClusterIndex = 0;
+			 ClusterIndex + 1 < Bounds.ClusterSubClusterStart.size();
+			 ++ClusterIndex )
+		{
+			const std::size_t WordIndex = ClusterIndex / 32;
+			if( WordIndex < VisibleClusters.size()
+				&& (VisibleClusters[WordIndex] & (1u << (ClusterIndex % 32))) )
+			{
+				continue;
+			}
+
+			const std::uint32_t SubClusterStart
+				= Bounds.ClusterSubClusterStart[ClusterIndex];
+			const std::uint32_t SubClusterEnd
+				= Bounds.ClusterSubClusterStart[ClusterIndex + 1];
+			for( std::uint32_t SubClusterIndex = SubClusterStart;
+				 SubClusterIndex < SubClusterEnd; ++SubClusterIndex )
+			{
+				HitMask[SubClusterIndex / 8]
+					&= ~std::uint8_t(1u << (SubClusterIndex % 8));
+			}
+		}
+	}
+
+	for( std::size_t MaskIndex = 0; MaskIndex < HitMask.size(); ++MaskIndex )
+	{
+		// Only visit the sub-clusters that intersected
+		for( std::uint32_t CurMask = HitMask[MaskIndex]; CurMask;
+			 CurMask &= CurMask - 1 )
+		{
+			const std::size_t SubClusterIndex
+				= MaskIndex * 8 + std::countr_zero(CurMask);
+
+			for( const std::uint32_t& SurfaceIndex :
+				 Heap.GetBlock(Bounds.SurfaceIndices[SubClusterIndex]) )
+			{
+				const std::uint32_t OcclusionWordIndex = SurfaceIndex / 32;
+				const std::uint32_t OcclusionBitIndex  = SurfaceIndex % 32;
+
+				SurfaceOcclusionArray[OcclusionWordIndex]
+					|= (1u << OcclusionBitIndex);
+			}
+		}
+	}
+}
+
+std::span<const std::uint32_t> GetClusterPVS(
+	const VirtualHeap& Heap, const Tag<TagClass::ScenarioStructureBsp>& BSP,
+	std::uint16_t ClusterIndex
+)
+{
+	// The cluster-data is a square bit-matrix with a row for each cluster
+	const std::size_t ClusterCount = BSP.Clusters.Count;
+	const std::size_t RowWords     = (ClusterCount + 31) / 32;
+
+	if( ClusterIndex >= ClusterCount || BSP.ClusterData.VirtualOffset == 0
+		|| BSP.ClusterData.Size
+			   < ClusterCount * RowWords * sizeof(std::uint32_t) )
+	{
+		return {};
+	}
+
+	const std::uint32_t* PVS = &Heap.Read<std::uint32_t>(
+		static_cast<std::uint32_t>(BSP.ClusterData.VirtualOffset)
+	);
+
+	return {PVS + ClusterIndex * RowWords, RowWords};
+}
+
+// Collision-BSP child-references with the high-bit set are leaf-indices
+static constexpr std::uint32_t BSPLeafBit = 0x8000'0000u;
+
+// Indices within tag-data are not trusted, as malformed or modified maps may
+// refer outside of their blocks
+static bool IsValidIndex(std::int32_t Index, std::size_t Count)
+{
+	return Index >= 0 && static_cast<std::size_t>(Index) < Count;
+}
+
+std::int32_t FindCollisionLeaf(
+	const VirtualHeap&                                                    Heap,
+	const Tag<TagClass::ScenarioStructureBsp>::CollisionBSP& CollisionBSP,
+	const Vector3f&                                          Point
+)
+{
+	const auto Nodes  = Heap.GetBlock(CollisionBSP.BSP3DNodes);
+	const auto Planes = Heap.GetBlock(CollisionBSP.Planes);
+	const auto Leaves = Heap.GetBlock(CollisionBSP.Leaves);
+
+	if( Nodes.empty() )
+	{
+		return -1;
+	}
+
+	std::int32_t NodeIndex = 0;
+	// Bounded by the node count so that malformed data can't loop forever
+	for( std::size_t Depth = 0; Depth < Nodes.size(); ++Depth )
+	{
+		const auto& Node = Nodes[NodeIndex];
+		if( !IsValidIndex(Node.Plane, Planes.size()) )
+		{
+			return -1;
+		}
+		const auto& Plane = Planes[Node.Plane];
+
+		const float Distance = Plane.Normal[0] * Point[0]
+							 + Plane.Normal[1] * Point[1]
+							 + Plane.Normal[2] * Point[2] - Plane.Distance;
+
+		const std::int32_t Child
+			= (Distance >= 0.0f) ? Node.FrontChild : Node.BackChild;
+
+		if( Child == -1 )
+		{
+			return -1;
+		}
+
+		if( static_cast<std::uint32_t>(Child) & BSPLeafBit )
+		{
+			const std::int32_t LeafIndex = static_cast<std::int32_t>(
+				static_cast<std::uint32_t>(Child) & ~BSPLeafBit
+			);
+			return IsValidIndex(LeafIndex, Leaves.size()) ? LeafIndex : -1;
+		}
+
+		if( !IsValidIndex(Child, Nodes.size()) )
+		{
+			return -1;
+		}
+
+		NodeIndex = Child;
+	}
+
+	return -1;
+}
+
+static std::int16_t LeafToCluster(
+	std::span<const Tag<TagClass::ScenarioStructureBsp>::Leaf> Leaves,
+	std::int32_t                                                LeafIndex
+)
+{
+	if( LeafIndex < 0 || static_cast<std::size_t>(LeafIndex) >= Leaves.size() )
+	{
+		return -1;
+	}
+	return Leaves[LeafIndex].Cluster;
+}
+
+std::int16_t FindCluster(
+	const VirtualHeap& Heap, const Tag<TagClass::ScenarioStructureBsp>& BSP,
+	const Vector3f& Point
+)
+{
+	const auto CollisionBSPs = Heap.GetBlock(BSP.CollisionBSPs);
+	if( CollisionBSPs.empty() )
+	{
+		return -1;
+	}
+
+	return LeafToCluster(
+		Heap.GetBlock(BSP.Leaves),
+		FindCollisionLeaf(Heap, CollisionBSPs[0], Point)
+	);
+}
+
+void FindClusters(
+	const VirtualHeap& Heap, const Tag<TagClass::ScenarioStructureBsp>& BSP,
+	std::span<const Vector3f> Points, std::span<std::int16_t> Clusters
+)
+{
+	const std::size_t PointCount = std::min(Points.size(), Clusters.size());
+
+	const auto CollisionBSPs = Heap.GetBlock(BSP.CollisionBSPs);
+	if( CollisionBSPs.empty() || CollisionBSPs[0].BSP3DNodes.Count == 0 )
+	{
+		std::fill_n(Clusters.begin(), PointCount, std::int16_t(-1));
+		return;
+	}
+
+	const auto Nodes           = Heap.GetBlock(CollisionBSPs[0].BSP3DNodes);
+	const auto Planes          = Heap.GetBlock(CollisionBSPs[0].Planes);
+	const auto CollisionLeaves = Heap.GetBlock(CollisionBSPs[0].Leaves);
+	const auto Leaves          = Heap.GetBlock(BSP.Leaves);
+
+	// Resolves a terminal child-reference into a cluster-index
+	const auto ResolveChild = [&](std::int32_t Child) -> std::int16_t {
+		if( Child == -1 )
+		{
+			return -1;
+		}
+		const std::int32_t LeafIndex = static_cast<std::int32_t>(
+			static_cast<std::uint32_t>(Child) & ~BSPLeafBit
+		);
+		if( !IsValidIndex(LeafIndex, CollisionLeaves.size()) )
+		{
+			return -1;
+		}
+		return LeafToCluster(Leaves, LeafIndex);
+	};
+
+	std::size_t PointIndex = 0;
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(__aarch64__)
+	// Four points are walked down the tree at once. Each lane holds the
+	// current node of its point, or a negative value once it has reached a
+	// leaf or solid space. Plane-fetches are gathered per-lane and the
+	// plane-tests are done in a single vector operation.
+	for( ; PointIndex + 4 <= PointCount; PointIndex += 4 )
+	{
+		alignas(16) float PointX[4], PointY[4], PointZ[4];
+		for( std::size_t Lane = 0; Lane < 4; ++Lane )
+		{
+			PointX[Lane] = Points[PointIndex + Lane][0];
+			PointY[Lane] = Points[PointIndex + Lane][1];
+			PointZ[Lane] = Points[PointIndex + Lane][2];
+		}
+
+		std::int32_t NodeIndex[4] = {0, 0, 0, 0};
+
+		for( std::size_t Depth = 0; Depth < Nodes.size(); ++Depth )
+		{
+			alignas(16) float NormalX[4], NormalY[4], NormalZ[4], PlaneD[4];
+			std::uint32_t     ActiveMask = 0;
+			for( std::size_t Lane = 0; Lane < 4; ++Lane )
+			{
+				if( NodeIndex[Lane] < 0 )
+				{
+					NormalX[Lane] = NormalY[Lane] = NormalZ[Lane] = 0.0f;
+					PlaneD[Lane]                                  = 0.0f;
+					continue;
+				}
+				if( !IsValidIndex(
+						Nodes[NodeIndex[Lane]].Plane, Planes.size()
+					) )
+				{
+					Clusters[PointIndex + Lane] = -1;
+					NodeIndex[Lane]             = -1;
+					NormalX[Lane] = NormalY[Lane] = NormalZ[Lane] = 0.0f;
+					PlaneD[Lane]                                  = 0.0f;
+					continue;
+				}
+				ActiveMask |= 1u << Lane;
+				const auto& Plane = Planes[Nodes[NodeIndex[Lane]].Plane];
+				NormalX[Lane]     = Plane.Normal[0];
+				NormalY[Lane]     = Plane.Normal[1];
+				NormalZ[Lane]     = Plane.Normal[2];
+				PlaneD[Lane]      = Plane.Distance;
+			}
+
+			if( ActiveMask == 0 )
+			{
+				break;
+			}
+
+#if defined(__SSE2__) || defined(_M_X64)
+			const __m128 Distance = _mm_sub_ps(
+				_mm_add_ps(
+					_mm_add_ps(
+						_mm_mul_ps(_mm_load_ps(NormalX), _mm_load_ps(PointX)),
+						_mm_mul_ps(_mm_load_ps(NormalY), _mm_load_ps(PointY))
+					),
+					_mm_mul_ps(_mm_load_ps(NormalZ), _mm_load_ps(PointZ))
+				),
+				_mm_load_ps(PlaneD)
+			);
+			const std::uint32_t FrontMask = static_cast<std::uint32_t>(
+				_mm_movemask_ps(_mm_cmpge_ps(Distance, _mm_setzero_ps()))
+			);
+#elif defined(__aarch64__)
+			const float32x4_t Distance = vsubq_f32(
+				vmlaq_f32(
+					vmlaq_f32(
+						vmulq_f32(vld1q_f32(NormalX), vld1q_f32(PointX)),
+						vld1q_f32(NormalY), vld1q_f32(PointY)
+					),
+					vld1q_f32(NormalZ), vld1q_f32(PointZ)
+				),
+				vld1q_f32(PlaneD)
+			);
+			static const std::uint32_t LaneBits[4] = {1, 2, 4, 8};
+			const std::uint32_t        FrontMask   = vaddvq_u32(vandq_u32(
+				vcgeq_f32(Distance, vdupq_n_f32(0.0f)), vld1q_u32(LaneBits)
+			));
+#endif
+
+			for( std::size_t Lane = 0; Lane < 4; ++Lane )
+			{
+				if( !(ActiveMask & (1u << Lane)) )
+				{
+					continue;
+				}
+				const auto& Node = Nodes[NodeIndex[Lane]];
+				const std::int32_t Child = (FrontMask & (1u << Lane))
+											 ? Node.FrontChild
+											 : Node.BackChild;
+				if( static_cast<std::uint32_t>(Child) & BSPLeafBit )
+				{
+					Clusters[PointIndex + Lane] = ResolveChild(Child);
+					NodeIndex[Lane]             = -1;
+				}
+				else if( !IsValidIndex(Child, Nodes.size()) )
+				{
+					Clusters[PointIndex + Lane] = -1;
+					NodeIndex[Lane]             = -1;
+				}
+				else
+				{
+					NodeIndex[Lane] = Child;
+				}
+			}
+		}
+
+		// Lanes that never terminated are within malformed data
+		for( std::size_t Lane = 0; Lane < 4; ++Lane )
+		{
+			if( NodeIndex[Lane] >= 0 )
+			{
+				Clusters[PointIndex + Lane] = -1;
+			}
+		}
+	}
+#endif
+
+	for( ; PointIndex < PointCount; ++PointIndex )
+	{
+		Clusters[PointIndex] = LeafToCluster(
+			Leaves,
+			FindCollisionLeaf(Heap, CollisionBSPs[0], Points[PointIndex])
+		);
+	}
+}
+
+// Signed-normalized scales of each component of an 11.11.10-bit vector
+static constexpr float Vector11Scale = 1.0f / 1023.0f;
+static constexpr float Vector10Scale = 1.0f / 511.0f;
+static constexpr float Int16Scale    = 1.0f / 32767.0f;
+
+// Unpacks the signed 11-bit x, 11-bit y, and 10-bit z of a packed vector
+static Vector3f UnpackVector11_11_10(std::uint32_t Packed)
+{
+	const std::int32_t X = static_cast<std::int32_t>(Packed << 21) >> 21;
+	const std::int32_t Y = static_cast<std::int32_t>(Packed << 10) >> 21;
+	const std::int32_t Z = static_cast<std::int32_t>(Packed) >> 22;
+	return {
+		float(X) * Vector11Scale, float(Y) * Vector11Scale,
+		float(Z) * Vector10Scale};
+}
+
+// Node-indices are stored pre-multiplied by 3, and the second node's weight
+// is implied by the first
+static void DecodeCompressedNodes(
+	const CompressedModelVertex& Vertex, ModelVertex& Dest
+)
+{
+	Dest.Node0Index = Vertex.Node0Index < 0
+						? std::uint16_t(0xFFFF)
+						: std::uint16_t(Vertex.Node0Index / 3);
+	Dest.Node1Index = Vertex.Node1Index < 0
+						? std::uint16_t(0xFFFF)
+						: std::uint16_t(Vertex.Node1Index / 3);
+	Dest.Node0Weight = float(Vertex.Node0Weight) * Int16Scale;
+	Dest.Node1Weight = 1.0f - Dest.Node0Weight;
+}
+
+ModelVertex DecodeCompressedVertex(
+	const CompressedModelVertex& Vertex, float UScale, float VScale
+)
+{
+	// Must match the scales of `DecodeCompressedVertices` exactly
+	const float UFactor = UScale * Int16Scale;
+	const float VFactor = VScale * Int16Scale;
+
+	ModelVertex Result;
+	Result.Position      = Vertex.Position;
+	Result.Normal        = UnpackVector11_11_10(Vertex.Normal);
+	Result.Binormal      = UnpackVector11_11_10(Vertex.Binormal);
+	Result.Tangent       = UnpackVector11_11_10(Vertex.Tangent);
+	Result.TextureCoords = {
+		float(Vertex.TextureCoordinateU) * UFactor,
+		float(Vertex.TextureCoordinateV) * VFactor};
+	DecodeCompressedNodes(Vertex, Result);
+	return Result;
+}
+
+// Each lane of `Words` holds the packed normal, binormal, tangent, and
+// texture-coordinates of a vertex. Each lane of `Lanes` receives the xyz of
+// the normal, binormal, and tangent, followed by the u and v
+static void DecodeCompressedLanes(
+	const std::int32_t (&Words)[4][8], float UFactor, float VFactor,
+	float (&Lanes)[11][8]
+)
+{
+#if defined(__SSE2__) || defined(_M_X64)
+	const __m128 Scale11 = _mm_set1_ps(Vector11Scale);
+	const __m128 Scale10 = _mm_set1_ps(Vector10Scale);
+
+	for( std::size_t Half = 0; Half < 8; Half += 4 )
+	{
+		for( std::size_t Vector = 0; Vector < 3; ++Vector )
+		{
+			const __m128i Packed = _mm_load_si128(
+				reinterpret_cast<const __m128i*>(&Words[Vector][Half])
+			);
+			const __m128i X = _mm_srai_epi32(_mm_slli_epi32(Packed, 21), 21);
+			const __m128i Y = _mm_srai_epi32(_mm_slli_epi32(Packed, 10), 21);
+			const __m128i Z = _mm_srai_epi32(Packed, 22);
+
+			_mm_store_ps(
+				&Lanes[Vector * 3 + 0][Half],
+				_mm_mul_ps(_mm_cvtepi32_ps(X), Scale11)
+			);
+			_mm_store_ps(
+				&Lanes[Vector * 3 + 1][Half],
+				_mm_mul_ps(_mm_cvtepi32_ps(Y), Scale11)
+			);
+			_mm_store_ps(
+				&Lanes[Vector * 3 + 2][Half],
+				_mm_mul_ps(_mm_cvtepi32_ps(Z), Scale10)
+			);
+		}
+
+		const __m128i PackedUV
+			= _mm_load_si128(reinterpret_cast<const __m128i*>(&Words[3][Half]));
+		const __m128i U = _mm_srai_epi32(_mm_slli_epi32(PackedUV, 16), 16);
+		const __m128i V = _mm_srai_epi32(PackedUV, 16);
+
+		_mm_store_ps(
+			&Lanes[9][Half],
+			_mm_mul_ps(_mm_cvtepi32_ps(U), _mm_set1_ps(UFactor))
+		);
+		_mm_store_ps(
+			&Lanes[10][Half],
+			_mm_mul_ps(_mm_cvtepi32_ps(V), _mm_set1_ps(VFactor))
+		);
+	}
+#elif defined(__aarch64__)
+	const float32x4_t Scale11 = vdupq_n_f32(Vector11Scale);
+	const float32x4_t Scale10 = vdupq_n_f32(Vector10Scale);
+
+	for( std::size_t Half = 0; Half < 8; Half += 4 )
+	{
+		for( std::size_t Vector = 0; Vector < 3; ++Vector )
+		{
+			const int32x4_t Packed = vld1q_s32(&Words[Vector][Half]);
+			const int32x4_t X      = vshrq_n_s32(vshlq_n_s32(Packed, 21), 21);
+			const int32x4_t Y      = vshrq_n_s32(vshlq_n_s32(Packed, 10), 21);
+			const int32x4_t Z      = vshrq_n_s32(Packed, 22);
+
+			vst1q_f32(
+				&Lanes[Vector * 3 + 0][Half],
+				vmulq_f32(vcvtq_f32_s32(X), Scale11)
+			);
+			vst1q_f32(
+				&Lanes[Vector * 3 + 1][Half],
+				vmulq_f32(vcvtq_f32_s32(Y), Scale11)
+			);
+			vst1q_f32(
+				&Lanes[Vector * 3 + 2][Half],
+				vmulq_f32(vcvtq_f32_s32(Z), Scale10)
+			);
+		}
+
+		const int32x4_t PackedUV = vld1q_s32(&Words[3][Half]);
+		const int32x4_t U = vshrq_n_s32(vshlq_n_s32(PackedUV, 16), 16);
+		const int32x4_t V = vshrq_n_s32(PackedUV, 16);
+
+		vst1q_f32(
+			&Lanes[9][Half], vmulq_f32(vcvtq_f32_s32(U), vdupq_n_f32(UFactor))
+		);
+		vst1q_f32(
+			&Lanes[10][Half], vmulq_f32(vcvtq_f32_s32(V), vdupq_n_f32(VFactor))
+		);
+	}
+#else
+	for( std::size_t Lane = 0; Lane < 8; ++Lane )
+	{
+		for( std::size_t Vector = 0; Vector < 3; ++Vector )
+		{
+			const Vector3f Unpacked = UnpackVector11_11_10(
+				static_cast<std::uint32_t>(Words[Vector][Lane])
+			);
+			Lanes[Vector * 3 + 0][Lane] = Unpacked[0];
+			Lanes[Vector * 3 + 1][Lane] = Unpacked[1];
+			Lanes[Vector * 3 + 2][Lane] = Unpacked[2];
+		}
+
+		const std::uint32_t PackedUV
+			= static_cast<std::uint32_t>(Words[3][Lane]);
+		Lanes[9][Lane]  = float(std::int16_t(PackedUV & 0xFFFF)) * UFactor;
+		Lanes[10][Lane] = float(std::int16_t(PackedUV >> 16)) * VFactor;
+	}
+#endif
+}
+
+void DecodeCompressedVertices(
+	std::span<const CompressedModelVertex> Source, float UScale, float VScale,
+	std::span<ModelVertex> Dest
+)
+{
+	const float UFactor = UScale * Int16Scale;
+	const float VFactor = VScale * Int16Scale;
+
+	const std::size_t Count = std::min(Source.size(), Dest.size());
+
+	std::size_t Base = 0;
+	for( ; Base + 8 <= Count; Base += 8 )
+	{
+		// Transpose the packed fields of each vertex into lanes
+		alignas(16) std::int32_t Words[4][8];
+		for( std::size_t Lane = 0; Lane < 8; ++Lane )
+		{
+			const CompressedModelVertex& CurVertex = Source[Base + Lane];
+
+			Words[0][Lane] = static_cast<std::int32_t>(CurVertex.Normal);
+			Words[1][Lane] = static_cast<std::int32_t>(CurVertex.Binormal);
+			Words[2][Lane] = static_cast<std::int32_t>(CurVertex.Tangent);
+			Words[3][Lane] = static_cast<std::int32_t>(
+				std::uint32_t(std::uint16_t(CurVertex.TextureCoordinateU))
+				| (std::uint32_t(std::uint16_t(CurVertex.TextureCoordinateV))
+				   << 16)
+			);
+		}
+
+		alignas(16) float Lanes[11][8];
+		DecodeCompressedLanes(Words, UFactor, VFactor, Lanes);
+
+		for( std::size_t Lane = 0; Lane < 8; ++Lane )
+		{
+			const CompressedModelVertex& CurVertex = Source[Base + Lane];
+			ModelVertex&                 CurDest   = Dest[Base + Lane];
+
+			CurDest.Position = CurVertex.Position;
+			CurDest.Normal   = {Lanes[0][Lane], Lanes[1][Lane], Lanes[2][Lane]};
+			CurDest.Binormal = {Lanes[3][Lane], Lanes[4][Lane], Lanes[5][Lane]};
+			CurDest.Tangent  = {Lanes[6][Lane], Lanes[7][Lane], Lanes[8][Lane]};
+			CurDest.TextureCoords = {Lanes[9][Lane], Lanes[10][Lane]};
+			DecodeCompressedNodes(CurVertex, CurDest);
+		}
+	}
+
+	for( ; Base < Count; ++Base )
+	{
+		Dest[Base] = DecodeCompressedVertex(Source[Base], UScale, VScale);
+	}
+}
+
 template<typename... ArgsT>
 std::string FormatString(const std::string& Format, ArgsT... Args)
 {
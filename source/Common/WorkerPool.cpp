@@ -0,0 +1,111 @@
+#include <Common/WorkerPool.hpp>
+
+namespace Common
+{
+
+WorkerPool::WorkerPool(std::uint32_t WorkerCount)
+{
+	Workers.reserve(WorkerCount);
+	for( std::uint32_t i = 0; i < WorkerCount; ++i )
+	{
+		Workers.emplace_back(&WorkerPool::WorkerProc, this);
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::scoped_lock Lock(Mutex);
+		Stopping = true;
+	}
+	JobCondition.notify_all();
+
+	for( std::thread& CurWorker : Workers )
+	{
+		CurWorker.join();
+	}
+}
+
+void WorkerPool::WorkerProc()
+{
+	std::uint64_t LastGeneration = 0;
+	while( true )
+	{
+		const std::function<void(std::size_t)>* CurProc  = nullptr;
+		std::size_t                             CurCount = 0;
+		{
+			std::unique_lock Lock(Mutex);
+			JobCondition.wait(Lock, [&]() -> bool {
+				return Stopping || JobGeneration != LastGeneration;
+			});
+			if( Stopping )
+			{
+				return;
+			}
+			LastGeneration = JobGeneration;
+			CurProc        = JobProc;
+			CurCount       = JobCount;
+		}
+
+		DrainJob(*CurProc, CurCount);
+
+		{
+			std::scoped_lock Lock(Mutex);
+			if( --BusyWorkers == 0 )
+			{
+				DoneCondition.notify_all();
+			}
+		}
+	}
+}
+
+void WorkerPool::DrainJob(
+	const std::function<void(std::size_t)>& Proc, std::size_t Count
+)
+{
+	while( true )
+	{
+		const std::size_t Index = NextIndex++;
+		if( Index >= Count )
+		{
+			break;
+		}
+		Proc(Index);
+	}
+}
+
+void WorkerPool::ParallelFor(
+	std::size_t Count, const std::function<void(std::size_t)>& Proc
+)
+{
+	// Not worth waking any of the workers
+	if( Workers.empty() || Count <= 1 )
+	{
+		for( std::size_t Index = 0; Index < Count; ++Index )
+		{
+			Proc(Index);
+		}
+		return;
+	}
+
+	std::scoped_lock JobLock(JobMutex);
+
+	{
+		std::scoped_lock Lock(Mutex);
+		JobProc     = &Proc;
+		JobCount    = Count;
+		NextIndex   = 0;
+		BusyWorkers = Workers.size();
+		++JobGeneration;
+	}
+	JobCondition.notify_all();
+
+	DrainJob(Proc, Count);
+
+	// `Proc` must outlive all of the workers that may still be calling it
+	std::unique_lock Lock(Mutex);
+	DoneCondition.wait(Lock, [&]() -> bool { return BusyWorkers == 0; });
+	JobProc = nullptr;
+}
+
+} // namespace Common
\ No newline at end of file
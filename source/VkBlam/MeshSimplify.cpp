@@ -0,0 +1,327 @@
+#include <VkBlam/MeshSimplify.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace
+{
+// Symmetric 4x4 matrix of the sum of squared distances to a set of planes
+struct Quadric
+{
+	double A2 = 0.0, AB = 0.0, AC = 0.0, AD = 0.0;
+	double B2 = 0.0, BC = 0.0, BD = 0.0;
+	double C2 = 0.0, CD = 0.0;
+	double D2 = 0.0;
+
+	void AddPlane(const glm::f64vec3& Normal, double Distance)
+	{
+		A2 += Normal.x * Normal.x;
+		AB += Normal.x * Normal.y;
+		AC += Normal.x * Normal.z;
+		AD += Normal.x * Distance;
+		B2 += Normal.y * Normal.y;
+		BC += Normal.y * Normal.z;
+		BD += Normal.y * Distance;
+		C2 += Normal.z * Normal.z;
+		CD += Normal.z * Distance;
+		D2 += Distance * Distance;
+	}
+
+	Quadric& operator+=(const Quadric& Other)
+	{
+		A2 += Other.A2;
+		AB += Other.AB;
+		AC += Other.AC;
+		AD += Other.AD;
+		B2 += Other.B2;
+		BC += Other.BC;
+		BD += Other.BD;
+		C2 += Other.C2;
+		CD += Other.CD;
+		D2 += Other.D2;
+		return *this;
+	}
+
+	double Evaluate(const glm::f64vec3& P) const
+	{
+		return P.x * (A2 * P.x + 2.0 * (AB * P.y + AC * P.z + AD))
+			 + P.y * (B2 * P.y + 2.0 * (BC * P.z + BD))
+			 + P.z * (C2 * P.z + 2.0 * CD) + D2;
+	}
+};
+
+struct Collapse
+{
+	double        Error;
+	std::uint32_t Source;
+	std::uint32_t Target;
+};
+
+std::uint64_t EdgeKey(std::uint32_t A, std::uint32_t B)
+{
+	return (std::uint64_t(std::min(A, B)) << 32) | std::max(A, B);
+}
+} // namespace
+
+namespace VkBlam
+{
+std::vector<std::uint32_t> SimplifyMesh(
+	std::span<const std::uint32_t> Indices,
+	std::span<const glm::f32vec3> Positions, std::size_t TargetIndexCount,
+	float TargetError
+)
+{
+	std::vector<std::uint32_t> CurIndices(Indices.begin(), Indices.end());
+	if( CurIndices.size() <= TargetIndexCount )
+	{
+		return CurIndices;
+	}
+
+	const std::size_t VertexCount = Positions.size();
+
+	// The error-limit is relative to the extent of the mesh
+	glm::f32vec3 BoundsMin(std::numeric_limits<float>::max());
+	glm::f32vec3 BoundsMax(std::numeric_limits<float>::lowest());
+	for( const std::uint32_t& CurIndex : CurIndices )
+	{
+		BoundsMin = glm::min(BoundsMin, Positions[CurIndex]);
+		BoundsMax = glm::max(BoundsMax, Positions[CurIndex]);
+	}
+	const double ErrorLimit
+		= double(TargetError) * glm::compMax(BoundsMax - BoundsMin);
+	const double ErrorLimitSquared = ErrorLimit * ErrorLimit;
+
+	// Quadrics are accumulated from the original surface and summed with
+	// each collapse so that the error never forgets the original shape
+	std::vector<Quadric> Quadrics(VertexCount);
+	for( std::size_t i = 0; i < CurIndices.size(); i += 3 )
+	{
+		const glm::f64vec3 P0 = Positions[CurIndices[i + 0]];
+		const glm::f64vec3 P1 = Positions[CurIndices[i + 1]];
+		const glm::f64vec3 P2 = Positions[CurIndices[i + 2]];
+
+		const glm::f64vec3 Normal = glm::cross(P1 - P0, P2 - P0);
+		const double       Length = glm::length(Normal);
+		if( Length == 0.0 )
+		{
+			continue;
+		}
+
+		Quadric Plane;
+		Plane.AddPlane(Normal / Length, -glm::dot(Normal / Length, P0));
+		for( std::size_t j = 0; j < 3; ++j )
+		{
+			Quadrics[CurIndices[i + j]] += Plane;
+		}
+	}
+
+	// Vertices of open or non-manifold edges are locked in place
+	std::vector<bool> Locked(VertexCount, false);
+	{
+		std::unordered_map<std::uint64_t, std::uint32_t> EdgeCounts;
+		EdgeCounts.reserve(CurIndices.size());
+		for( std::size_t i = 0; i < CurIndices.size(); i += 3 )
+		{
+			for( std::size_t j = 0; j < 3; ++j )
+			{
+				++EdgeCounts[EdgeKey(
+					CurIndices[i + j], CurIndices[i + (j + 1) % 3]
+				)];
+			}
+		}
+		for( const auto& [Key, Count] : EdgeCounts )
+		{
+			if( Count != 2 )
+			{
+				Locked[Key >> 32]        = true;
+				Locked[Key & 0xFFFFFFFF] = true;
+			}
+		}
+	}
+
+	std::vector<std::uint32_t> TriangleOffsets(VertexCount + 1);
+	std::vector<std::uint32_t> VertexTriangles;
+	std::vector<Collapse>      Collapses;
+	std::vector<bool>          Touched(VertexCount);
+	std::vector<std::uint32_t> Remap(VertexCount);
+
+	// Each pass collapses the cheapest edges that do not share any
+	// triangles, so that the error of each collapse stays accurate
+	while( CurIndices.size() > TargetIndexCount )
+	{
+		// Triangles around each vertex
+		std::fill(TriangleOffsets.begin(), TriangleOffsets.end(), 0);
+		for( const std::uint32_t& CurIndex : CurIndices )
+		{
+			++TriangleOffsets[CurIndex + 1];
+		}
+		std::partial_sum(
+			TriangleOffsets.begin(), TriangleOffsets.end(),
+			TriangleOffsets.begin()
+		);
+		VertexTriangles.resize(CurIndices.size());
+		{
+			std::vector<std::uint32_t> WriteOffsets(
+				TriangleOffsets.begin(), TriangleOffsets.end() - 1
+			);
+			for( std::size_t i = 0; i < CurIndices.size(); ++i )
+			{
+				VertexTriangles[WriteOffsets[CurIndices[i]]++] = i / 3;
+			}
+		}
+
+		// Cheapest collapse of each vertex
+		Collapses.clear();
+		for( std::uint32_t Source = 0; Source < VertexCount; ++Source )
+		{
+			if( Locked[Source] )
+			{
+				continue;
+			}
+
+			Collapse Best = {std::numeric_limits<double>::max(), Source, 0};
+			for( std::uint32_t i = TriangleOffsets[Source];
+				 i < TriangleOffsets[Source + 1]; ++i )
+			{
+				const std::uint32_t Triangle = VertexTriangles[i];
+				for( std::size_t j = 0; j < 3; ++j )
+				{
+					const std::uint32_t Target = CurIndices[Triangle * 3 + j];
+					if( Target == Source )
+					{
+						continue;
+					}
+
+					Quadric Sum = Quadrics[Source];
+					Sum += Quadrics[Target];
+					const double Error = Sum.Evaluate(Positions[Target]);
+					if( Error < Best.Error )
+					{
+						Best.Error  = Error;
+						Best.Target = Target;
+					}
+				}
+			}
+
+			if( Best.Error <= ErrorLimitSquared )
+			{
+				Collapses.push_back(Best);
+			}
+		}
+
+		if( Collapses.empty() )
+		{
+			break;
+		}
+
+		std::sort(
+			Collapses.begin(), Collapses.end(),
+			[](const Collapse& A, const Collapse& B) -> bool {
+				return A.Error < B.Error;
+			}
+		);
+
+		std::fill(Touched.begin(), Touched.end(), false);
+		std::iota(Remap.begin(), Remap.end(), 0);
+
+		// Each collapse removes about two triangles
+		const std::size_t TrianglesToRemove
+			= (CurIndices.size() - TargetIndexCount) / 3;
+		std::size_t TrianglesRemoved = 0;
+		for( const Collapse& CurCollapse : Collapses )
+		{
+			if( TrianglesRemoved >= TrianglesToRemove )
+			{
+				break;
+			}
+
+			const std::uint32_t Source = CurCollapse.Source;
+			const std::uint32_t Target = CurCollapse.Target;
+
+			// None of the triangles around the source may have changed
+			// within this pass, and none may flip over
+			bool        Valid        = true;
+			std::size_t RemovedCount = 0;
+			for( std::uint32_t i = TriangleOffsets[Source];
+				 Valid && i < TriangleOffsets[Source + 1]; ++i )
+			{
+				const std::uint32_t* Triangle
+					= &CurIndices[VertexTriangles[i] * 3];
+
+				std::uint32_t Corner = 0;
+				for( std::uint32_t j = 0; j < 3; ++j )
+				{
+					Valid = Valid && !Touched[Triangle[j]];
+					if( Triangle[j] == Source )
+					{
+						Corner = j;
+					}
+				}
+
+				const std::uint32_t Next = Triangle[(Corner + 1) % 3];
+				const std::uint32_t Prev = Triangle[(Corner + 2) % 3];
+				if( Next == Target || Prev == Target )
+				{
+					++RemovedCount;
+					continue;
+				}
+
+				const glm::f32vec3 OldNormal = glm::cross(
+					Positions[Next] - Positions[Source],
+					Positions[Prev] - Positions[Source]
+				);
+				const glm::f32vec3 NewNormal = glm::cross(
+					Positions[Next] - Positions[Target],
+					Positions[Prev] - Positions[Target]
+				);
+				Valid = Valid && glm::dot(OldNormal, NewNormal) > 0.0f;
+			}
+
+			if( !Valid )
+			{
+				continue;
+			}
+
+			for( std::uint32_t i = TriangleOffsets[Source];
+				 i < TriangleOffsets[Source + 1]; ++i )
+			{
+				for( std::uint32_t j = 0; j < 3; ++j )
+				{
+					Touched[CurIndices[VertexTriangles[i] * 3 + j]] = true;
+				}
+			}
+			Touched[Target] = true;
+
+			Remap[Source] = Target;
+			Quadrics[Target] += Quadrics[Source];
+			TrianglesRemoved += RemovedCount;
+		}
+
+		if( TrianglesRemoved == 0 )
+		{
+			break;
+		}
+
+		// Apply the collapses and drop the triangles that have collapsed
+		std::size_t WriteIndex = 0;
+		for( std::size_t i = 0; i < CurIndices.size(); i += 3 )
+		{
+			const std::uint32_t A = Remap[CurIndices[i + 0]];
+			const std::uint32_t B = Remap[CurIndices[i + 1]];
+			const std::uint32_t C = Remap[CurIndices[i + 2]];
+			if( A == B || B == C || C == A )
+			{
+				continue;
+			}
+			CurIndices[WriteIndex++] = A;
+			CurIndices[WriteIndex++] = B;
+			CurIndices[WriteIndex++] = C;
+		}
+		CurIndices.resize(WriteIndex);
+	}
+
+	return CurIndices;
+}
+} // namespace VkBlam
\ No newline at end of file
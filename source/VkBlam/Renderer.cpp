@@ -1,14 +1,22 @@
 #include "Vulkan/DescriptorUpdateBatch.hpp"
 #include "Vulkan/StreamBuffer.hpp"
 #include <VkBlam/Renderer.hpp>
+#include <algorithm>
 #include <memory>
 #include <optional>
 
-vk::UniqueRenderPass
-	CreateMainRenderPass(vk::Device Device, vk::SampleCountFlagBits SampleCount)
+// `LoadOp` and `StoreOp` apply to the multi-sampled color and depth
+// attachments, so that a frame may be split across several render passes
+vk::UniqueRenderPass CreateMainRenderPass(
+	vk::Device Device, vk::SampleCountFlagBits SampleCount,
+	vk::AttachmentLoadOp LoadOp, vk::AttachmentStoreOp StoreOp
+)
 {
 	vk::RenderPassCreateInfo RenderPassInfo = {};
 
+	// Loaded attachments are still in the layout of the previous render pass
+	const bool Load = LoadOp == vk::AttachmentLoadOp::eLoad;
+
 	const vk::AttachmentDescription Attachments[] = {
 		// Color Attachment
 		// We just care about it storing its color data
@@ -20,21 +28,21 @@ vk::UniqueRenderPass
 			vk::ImageLayout::eTransferSrcOptimal
 		),
 		// Depth Attachment
-		// Dont care about reading or storing it
 		vk::AttachmentDescription(
 			vk::AttachmentDescriptionFlags(), vk::Format::eD32Sfloat,
-			SampleCount, vk::AttachmentLoadOp::eClear,
-			vk::AttachmentStoreOp::eDontCare, vk::AttachmentLoadOp::eClear,
-			vk::AttachmentStoreOp::eDontCare, vk::ImageLayout::eUndefined,
+			SampleCount, LoadOp, StoreOp, vk::AttachmentLoadOp::eClear,
+			vk::AttachmentStoreOp::eDontCare,
+			Load ? vk::ImageLayout::eDepthStencilAttachmentOptimal
+				 : vk::ImageLayout::eUndefined,
 			vk::ImageLayout::eDepthStencilAttachmentOptimal
 		),
 		// Color Attachment(MSAA)
-		// We just care about it storing its color data
 		vk::AttachmentDescription(
 			vk::AttachmentDescriptionFlags(), vk::Format::eR8G8B8A8Srgb,
-			SampleCount, vk::AttachmentLoadOp::eClear,
-			vk::AttachmentStoreOp::eDontCare, vk::AttachmentLoadOp::eDontCare,
-			vk::AttachmentStoreOp::eDontCare, vk::ImageLayout::eUndefined,
+			SampleCount, LoadOp, StoreOp, vk::AttachmentLoadOp::eDontCare,
+			vk::AttachmentStoreOp::eDontCare,
+			Load ? vk::ImageLayout::eColorAttachmentOptimal
+				 : vk::ImageLayout::eUndefined,
 			vk::ImageLayout::eColorAttachmentOptimal
 		)};
 
@@ -60,13 +68,32 @@ vk::UniqueRenderPass
 	RenderPassInfo.subpassCount = std::size(Subpasses);
 	RenderPassInfo.pSubpasses   = Subpasses;
 
-	const vk::SubpassDependency SubpassDependencies[] = {vk::SubpassDependency(
-		VK_SUBPASS_EXTERNAL, 0, vk::PipelineStageFlagBits::eTransfer,
-		vk::PipelineStageFlagBits::eVertexInput,
-		vk::AccessFlagBits::eTransferWrite,
-		vk::AccessFlagBits::eVertexAttributeRead,
-		vk::DependencyFlagBits::eByRegion
-	)};
+	const vk::SubpassDependency SubpassDependencies[] = {
+		vk::SubpassDependency(
+			VK_SUBPASS_EXTERNAL, 0, vk::PipelineStageFlagBits::eTransfer,
+			vk::PipelineStageFlagBits::eVertexInput,
+			vk::AccessFlagBits::eTransferWrite,
+			vk::AccessFlagBits::eVertexAttributeRead,
+			vk::DependencyFlagBits::eByRegion
+		),
+		// Attachments of a previous render pass must be written before they
+		// are loaded or cleared. Always present so that all variants of the
+		// render pass stay compatible
+		vk::SubpassDependency(
+			VK_SUBPASS_EXTERNAL, 0,
+			vk::PipelineStageFlagBits::eColorAttachmentOutput
+				| vk::PipelineStageFlagBits::eLateFragmentTests,
+			vk::PipelineStageFlagBits::eColorAttachmentOutput
+				| vk::PipelineStageFlagBits::eEarlyFragmentTests,
+			vk::AccessFlagBits::eColorAttachmentWrite
+				| vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+			vk::AccessFlagBits::eColorAttachmentRead
+				| vk::AccessFlagBits::eColorAttachmentWrite
+				| vk::AccessFlagBits::eDepthStencilAttachmentRead
+				| vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+			vk::DependencyFlagBits::eByRegion
+		),
+	};
 
 	RenderPassInfo.dependencyCount = std::size(SubpassDependencies);
 	RenderPassInfo.pDependencies   = SubpassDependencies;
@@ -95,6 +122,15 @@ Renderer::Renderer(const Vulkan::Context& VulkanContext)
 
 Renderer::~Renderer()
 {
+	// Background compiles write into the pipeline-cache, so they must be
+	// done before it is saved
+	PipelineRegistry.reset();
+
+	// Moved-from renderers no longer own a cache
+	if( PipelineCache )
+	{
+		PipelineCache->Save();
+	}
 }
 
 const vk::RenderPass&
@@ -105,8 +141,10 @@ const vk::RenderPass&
 		return DefaultRenderPasses.at(SampleCount).get();
 	}
 
-	DefaultRenderPasses[SampleCount]
-		= CreateMainRenderPass(VulkanContext.LogicalDevice, SampleCount);
+	DefaultRenderPasses[SampleCount] = CreateMainRenderPass(
+		VulkanContext.LogicalDevice, SampleCount, vk::AttachmentLoadOp::eClear,
+		vk::AttachmentStoreOp::eDontCare
+	);
 
 	return DefaultRenderPasses[SampleCount].get();
 }
@@ -121,6 +159,10 @@ std::optional<Renderer> Renderer::Create(
 		VulkanContext, Config.StreamBufferSize
 	);
 
+	NewRenderer.UniformRingBuffer = std::make_unique<Vulkan::UniformRingBuffer>(
+		VulkanContext, Config.UniformBufferSize
+	);
+
 	NewRenderer.SamplerCache = std::make_unique<Vulkan::SamplerCache>(
 		Vulkan::SamplerCache::Create(VulkanContext).value()
 	);
@@ -129,6 +171,30 @@ std::optional<Renderer> Renderer::Create(
 		Vulkan::ShaderModuleCache::Create(VulkanContext).value()
 	);
 
+	if( auto NewPipelineCache = Vulkan::PipelineCache::Create(
+			VulkanContext, Config.PipelineCachePath
+		);
+		NewPipelineCache.has_value() )
+	{
+		NewRenderer.PipelineCache = std::make_unique<Vulkan::PipelineCache>(
+			std::move(NewPipelineCache.value())
+		);
+	}
+	else
+	{
+		return std::nullopt;
+	}
+
+	NewRenderer.PipelineRegistry = std::make_unique<Vulkan::PipelineRegistry>(
+		VulkanContext, NewRenderer.PipelineCache->GetPipelineCache(),
+		Config.PipelineCompileThreads
+	);
+
+	// The loading thread works alongside the workers
+	NewRenderer.LoadWorkers = std::make_unique<Common::WorkerPool>(
+		std::max(Config.LoadThreads, 1u) - 1
+	);
+
 	NewRenderer.DescriptorUpdateBatch
 		= std::make_unique<Vulkan::DescriptorUpdateBatch>(
 			Vulkan::DescriptorUpdateBatch::Create(
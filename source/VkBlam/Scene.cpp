@@ -1,15 +1,36 @@
 #include <VkBlam/Format.hpp>
+#include <VkBlam/MeshSimplify.hpp>
 #include <VkBlam/Scene.hpp>
 
 #include <Blam/TagVisitor.hpp>
 
 #include <Vulkan/Memory.hpp>
 #include <Vulkan/Pipeline.hpp>
+#include <Vulkan/PipelineRegistry.hpp>
 
+#include <Common/Alignment.hpp>
 #include <Common/Format.hpp>
+#include <Common/Hash.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numbers>
+#include <numeric>
 
 std::tuple<vk::UniquePipeline, vk::UniquePipelineLayout> CreateGraphicsPipeline(
-	vk::Device Device, std::span<const vk::PushConstantRange> PushConstants,
+	vk::Device Device, vk::PipelineCache PipelineCache,
+	std::span<const vk::PushConstantRange>   PushConstants,
 	std::span<const vk::DescriptorSetLayout> SetLayouts,
 	vk::ShaderModule VertModule, vk::ShaderModule FragModule,
 	std::span<const vk::VertexInputBindingDescription>
@@ -17,7 +38,11 @@ std::tuple<vk::UniquePipeline, vk::UniquePipelineLayout> CreateGraphicsPipeline(
 	std::span<const vk::VertexInputAttributeDescription>
 				   VertexAttributeDescriptions,
 	vk::RenderPass RenderPass, vk::SampleCountFlagBits RenderSamples,
-	vk::PolygonMode PolygonMode
+	vk::PolygonMode PolygonMode,
+	vk::CompareOp   DepthCompareOp   = vk::CompareOp::eLessOrEqual,
+	bool            DepthWriteEnable = true,
+	// Specializes the constants of the fragment shader, if not null
+	const vk::SpecializationInfo* FragSpecialization = nullptr
 )
 {
 	// Create Pipeline Layout
@@ -44,137 +69,678 @@ std::tuple<vk::UniquePipeline, vk::UniquePipelineLayout> CreateGraphicsPipeline(
 		return {};
 	}
 
-	// Describe the stage and entry point of each shader
-	const vk::PipelineShaderStageCreateInfo ShaderStagesInfo[2] = {
-		vk::PipelineShaderStageCreateInfo(
-			{},                               // Flags
-			vk::ShaderStageFlagBits::eVertex, // Shader Stage
-			VertModule,                       // Shader Module
-			"main", // Shader entry point function name
-			{}      // Shader specialization info
-		),
-		vk::PipelineShaderStageCreateInfo(
-			{},                                 // Flags
-			vk::ShaderStageFlagBits::eFragment, // Shader Stage
-			FragModule,                         // Shader Module
-			"main", // Shader entry point function name
-			{}      // Shader specialization info
-		),
-	};
+	Vulkan::GraphicsPipelineState State = {};
+
+	State.Layout           = GraphicsPipelineLayout.get();
+	State.VertModule       = VertModule;
+	State.FragModule       = FragModule;
+	State.RenderPass       = RenderPass;
+	State.RenderSamples    = RenderSamples;
+	State.PolygonMode      = PolygonMode;
+	State.DepthCompareOp   = DepthCompareOp;
+	State.DepthWriteEnable = DepthWriteEnable;
+
+	State.VertexBindings.assign(
+		VertexBindingDescriptions.begin(), VertexBindingDescriptions.end()
+	);
+	State.VertexAttributes.assign(
+		VertexAttributeDescriptions.begin(), VertexAttributeDescriptions.end()
+	);
+
+	if( FragSpecialization )
+	{
+		State.FragSpecializationEntries.assign(
+			FragSpecialization->pMapEntries,
+			FragSpecialization->pMapEntries + FragSpecialization->mapEntryCount
+		);
 
-	vk::PipelineVertexInputStateCreateInfo VertexInputState = {};
-
-	VertexInputState.vertexBindingDescriptionCount
-		= VertexBindingDescriptions.size();
-	VertexInputState.pVertexBindingDescriptions
-		= VertexBindingDescriptions.data();
-
-	VertexInputState.vertexAttributeDescriptionCount
-		= VertexAttributeDescriptions.size();
-	VertexInputState.pVertexAttributeDescriptions
-		= VertexAttributeDescriptions.data();
-
-	vk::PipelineInputAssemblyStateCreateInfo InputAssemblyState = {};
-	InputAssemblyState.topology = vk::PrimitiveTopology::eTriangleList;
-	InputAssemblyState.primitiveRestartEnable = false;
-
-	vk::PipelineViewportStateCreateInfo ViewportState = {};
-
-	static const vk::Viewport DefaultViewport = {0, 0, 16, 16, 0.0f, 1.0f};
-	static const vk::Rect2D   DefaultScissor  = {{0, 0}, {16, 16}};
-	ViewportState.viewportCount               = 1;
-	ViewportState.pViewports                  = &DefaultViewport;
-	ViewportState.scissorCount                = 1;
-	ViewportState.pScissors                   = &DefaultScissor;
-
-	vk::PipelineRasterizationStateCreateInfo RasterizationState = {};
-
-	RasterizationState.depthClampEnable        = false;
-	RasterizationState.rasterizerDiscardEnable = false;
-	RasterizationState.polygonMode             = PolygonMode;
-	RasterizationState.cullMode                = vk::CullModeFlagBits::eBack;
-	RasterizationState.frontFace               = vk::FrontFace::eClockwise;
-	RasterizationState.depthBiasEnable         = false;
-	RasterizationState.depthBiasConstantFactor = 0.0f;
-	RasterizationState.depthBiasClamp          = 0.0f;
-	RasterizationState.depthBiasSlopeFactor    = 0.0;
-	RasterizationState.lineWidth               = 1.0f;
-
-	vk::PipelineMultisampleStateCreateInfo MultisampleState = {};
-
-	MultisampleState.rasterizationSamples  = RenderSamples;
-	MultisampleState.sampleShadingEnable   = true;
-	MultisampleState.minSampleShading      = 1.0f;
-	MultisampleState.pSampleMask           = nullptr;
-	MultisampleState.alphaToCoverageEnable = true;
-	MultisampleState.alphaToOneEnable      = false;
-
-	vk::PipelineDepthStencilStateCreateInfo DepthStencilState = {};
-
-	DepthStencilState.depthTestEnable       = true;
-	DepthStencilState.depthWriteEnable      = true;
-	DepthStencilState.depthCompareOp        = vk::CompareOp::eLessOrEqual;
-	DepthStencilState.depthBoundsTestEnable = false;
-	DepthStencilState.stencilTestEnable     = false;
-	DepthStencilState.front                 = vk::StencilOp::eKeep;
-	DepthStencilState.back                  = vk::StencilOp::eKeep;
-	DepthStencilState.minDepthBounds        = 0.0f;
-	DepthStencilState.maxDepthBounds        = 1.0f;
-
-	vk::PipelineColorBlendStateCreateInfo ColorBlendState = {};
-
-	ColorBlendState.logicOpEnable   = false;
-	ColorBlendState.logicOp         = vk::LogicOp::eClear;
-	ColorBlendState.attachmentCount = 1;
-
-	vk::PipelineColorBlendAttachmentState BlendAttachmentState = {};
-
-	BlendAttachmentState.blendEnable         = false;
-	BlendAttachmentState.srcColorBlendFactor = vk::BlendFactor::eZero;
-	BlendAttachmentState.dstColorBlendFactor = vk::BlendFactor::eZero;
-	BlendAttachmentState.colorBlendOp        = vk::BlendOp::eAdd;
-	BlendAttachmentState.srcAlphaBlendFactor = vk::BlendFactor::eZero;
-	BlendAttachmentState.dstAlphaBlendFactor = vk::BlendFactor::eZero;
-	BlendAttachmentState.alphaBlendOp        = vk::BlendOp::eAdd;
-	BlendAttachmentState.colorWriteMask
-		= vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG
-		| vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA;
-
-	ColorBlendState.pAttachments = &BlendAttachmentState;
-
-	vk::PipelineDynamicStateCreateInfo DynamicState = {};
-	vk::DynamicState                   DynamicStates[]
-		= {// The viewport and scissor of the framebuffer will be dynamic at
-		   // run-time
-		   // so we definately add these
-		   vk::DynamicState::eViewport, vk::DynamicState::eScissor};
-	DynamicState.dynamicStateCount = std::size(DynamicStates);
-	DynamicState.pDynamicStates    = DynamicStates;
-
-	vk::GraphicsPipelineCreateInfo RenderPipelineInfo = {};
-
-	RenderPipelineInfo.stageCount          = 2; // Vert + Frag stages
-	RenderPipelineInfo.pStages             = ShaderStagesInfo;
-	RenderPipelineInfo.pVertexInputState   = &VertexInputState;
-	RenderPipelineInfo.pInputAssemblyState = &InputAssemblyState;
-	RenderPipelineInfo.pViewportState      = &ViewportState;
-	RenderPipelineInfo.pRasterizationState = &RasterizationState;
-	RenderPipelineInfo.pMultisampleState   = &MultisampleState;
-	RenderPipelineInfo.pDepthStencilState  = &DepthStencilState;
-	RenderPipelineInfo.pColorBlendState    = &ColorBlendState;
-	RenderPipelineInfo.pDynamicState       = &DynamicState;
-	RenderPipelineInfo.subpass             = 0;
-	RenderPipelineInfo.renderPass          = RenderPass;
-	RenderPipelineInfo.layout              = GraphicsPipelineLayout.get();
+		const std::byte* SpecializationData
+			= static_cast<const std::byte*>(FragSpecialization->pData);
+		State.FragSpecializationData.assign(
+			SpecializationData,
+			SpecializationData + FragSpecialization->dataSize
+		);
+	}
 
 	// Create Pipeline
 	vk::UniquePipeline Pipeline
-		= Device.createGraphicsPipelineUnique({}, RenderPipelineInfo).value;
+		= Vulkan::CreateGraphicsPipeline(Device, PipelineCache, State);
 	return std::make_tuple(
 		std::move(Pipeline), std::move(GraphicsPipelineLayout)
 	);
 }
 
+static std::tuple<vk::UniquePipeline, vk::UniquePipelineLayout>
+	CreateComputePipeline(
+		vk::Device Device, vk::PipelineCache PipelineCache,
+		std::span<const vk::PushConstantRange>   PushConstants,
+		std::span<const vk::DescriptorSetLayout> SetLayouts,
+		vk::ShaderModule                         CompModule
+	)
+{
+	// Create Pipeline Layout
+	vk::PipelineLayoutCreateInfo ComputePipelineLayoutInfo = {};
+
+	ComputePipelineLayoutInfo.pSetLayouts            = SetLayouts.data();
+	ComputePipelineLayoutInfo.setLayoutCount         = SetLayouts.size();
+	ComputePipelineLayoutInfo.pPushConstantRanges    = PushConstants.data();
+	ComputePipelineLayoutInfo.pushConstantRangeCount = PushConstants.size();
+
+	vk::UniquePipelineLayout ComputePipelineLayout = {};
+	if( auto CreateResult
+		= Device.createPipelineLayoutUnique(ComputePipelineLayoutInfo);
+		CreateResult.result == vk::Result::eSuccess )
+	{
+		ComputePipelineLayout = std::move(CreateResult.value);
+	}
+	else
+	{
+		std::fprintf(
+			stderr, "Error creating pipeline layout: %s\n",
+			vk::to_string(CreateResult.result).c_str()
+		);
+		return {};
+	}
+
+	vk::ComputePipelineCreateInfo ComputePipelineInfo = {};
+
+	ComputePipelineInfo.stage = vk::PipelineShaderStageCreateInfo(
+		{},                                // Flags
+		vk::ShaderStageFlagBits::eCompute, // Shader Stage
+		CompModule,                        // Shader Module
+		"main", // Shader entry point function name
+		{}      // Shader specialization info
+	);
+	ComputePipelineInfo.layout = ComputePipelineLayout.get();
+
+	// Create Pipeline
+	if( auto CreateResult = Device.createComputePipelineUnique(
+			PipelineCache, ComputePipelineInfo
+		);
+		CreateResult.result == vk::Result::eSuccess )
+	{
+		return std::make_tuple(
+			std::move(CreateResult.value), std::move(ComputePipelineLayout)
+		);
+	}
+	else
+	{
+		std::fprintf(
+			stderr, "Error creating compute pipeline: %s\n",
+			vk::to_string(CreateResult.result).c_str()
+		);
+		return {};
+	}
+}
+
+// Creates a buffer that is named for debugging and may be streamed into
+static vk::UniqueBuffer CreateSceneBuffer(
+	vk::Device Device, vk::DeviceSize Size, vk::BufferUsageFlags Usage,
+	const char* Name
+)
+{
+	vk::BufferCreateInfo BufferInfo = {};
+	BufferInfo.size                 = Size;
+	BufferInfo.usage = Usage | vk::BufferUsageFlagBits::eTransferDst;
+
+	if( auto CreateResult = Device.createBufferUnique(BufferInfo);
+		CreateResult.result == vk::Result::eSuccess )
+	{
+		Vulkan::SetObjectName(
+			Device, CreateResult.value.get(), "VkBlam::Scene: %s( %s )", Name,
+			Common::FormatByteCount(BufferInfo.size).c_str()
+		);
+		return std::move(CreateResult.value);
+	}
+	else
+	{
+		std::fprintf(
+			stderr, "Error creating %s: %s\n", Name,
+			vk::to_string(CreateResult.result).c_str()
+		);
+		return {};
+	}
+}
+
+// Extracts the inward-facing, normalized, frustum-planes of a
+// view-projection matrix
+static std::array<glm::f32vec4, 6>
+	GetFrustumPlanes(const glm::f32mat4& ViewProjection)
+{
+	const glm::f32mat4 Rows = glm::transpose(ViewProjection);
+
+	std::array<glm::f32vec4, 6> Planes = {
+		Rows[3] + Rows[0], Rows[3] - Rows[0], Rows[3] + Rows[1],
+		Rows[3] - Rows[1], Rows[3] + Rows[2], Rows[3] - Rows[2],
+	};
+
+	for( glm::f32vec4& CurPlane : Planes )
+	{
+		CurPlane /= glm::length(glm::f32vec3(CurPlane));
+	}
+	return Planes;
+}
+
+// Must match CullDraws.comp. Padded to the 16-byte alignment that the
+// std430 layout gives the struct
+struct alignas(16) CullItem
+{
+	glm::f32vec3  Min;
+	std::uint32_t IndexCount;
+	glm::f32vec3  Max;
+	std::uint32_t FirstIndex;
+	std::int32_t  VertexOffset;
+	std::uint32_t GroupIndex;
+	std::uint32_t CommandStart;
+	std::uint32_t MeshIndex;
+	std::uint32_t LOD;
+};
+static_assert(sizeof(CullItem) == 64);
+
+// Must match DefaultBindless.frag. Indices into the arrays of the bindless
+// descriptor-set
+struct BindlessMaterial
+{
+	std::uint32_t BaseMap;
+	std::uint32_t PrimaryDetailMap;
+	std::uint32_t SecondaryDetailMap;
+	std::uint32_t MicroDetailMap;
+	std::uint32_t BumpMap;
+	std::uint32_t GlowMap;
+	std::uint32_t ReflectionCubeMap;
+	std::uint32_t LightmapMap;
+};
+
+// Must match vkBlam.glsl, with std430 layout
+struct DecalPaletteEntry
+{
+	// rgb is the color, a is the intensity
+	glm::f32vec4  Color;
+	float         Radius;
+	// Index into the 2D bitmaps of the bindless textures
+	std::uint32_t TextureIndex;
+	std::uint32_t _Padding18[2];
+};
+static_assert(sizeof(DecalPaletteEntry) == 32);
+
+// Must match vkBlam.glsl, with std430 layout
+struct GlowAnimation
+{
+	glm::f32vec3  OnColor;
+	float         Period;
+	glm::f32vec3  OffColor;
+	float         Phase;
+	std::uint32_t Function;
+	std::uint32_t _Padding24[3];
+};
+static_assert(sizeof(GlowAnimation) == 48);
+
+// Must match vkBlam.glsl, with std430 layout. One for each
+// shader-environment tag within the scene's material-table
+struct MaterialParameters
+{
+	GlowAnimation PrimaryGlow;
+	GlowAnimation SecondaryGlow;
+	GlowAnimation PlasmaGlow;
+
+	std::uint32_t UAnimationFunction;
+	float         UAnimationPeriod;
+	float         UAnimationScale;
+	std::uint32_t VAnimationFunction;
+	float         VAnimationPeriod;
+	float         VAnimationScale;
+
+	float BumpMapScale;
+	float GlowMapScale;
+
+	glm::f32vec3 PerpendicularColor;
+	float        PerpendicularBrightness;
+	glm::f32vec3 ParallelColor;
+	float        ParallelBrightness;
+
+	std::uint32_t ShaderFlags;
+	std::uint32_t _PaddingD4[3];
+};
+static_assert(sizeof(MaterialParameters) == 0xE0);
+
+// Used by meshes without a shader-environment, and matches the shading from
+// before shader-environment parameters were read
+static MaterialParameters DefaultMaterialParameters()
+{
+	GlowAnimation DefaultGlow = {};
+	DefaultGlow.OnColor       = glm::f32vec3(1.0f);
+	DefaultGlow.OffColor      = glm::f32vec3(1.0f);
+	DefaultGlow.Function      = std::uint32_t(Blam::AnimationFunction::One);
+
+	MaterialParameters Parameters = {};
+	Parameters.PrimaryGlow        = DefaultGlow;
+	Parameters.SecondaryGlow      = DefaultGlow;
+	Parameters.PlasmaGlow         = DefaultGlow;
+
+	Parameters.BumpMapScale = 1.0f;
+	Parameters.GlowMapScale = 1.0f;
+
+	Parameters.PerpendicularColor      = glm::f32vec3(1.0f);
+	Parameters.PerpendicularBrightness = 1.0f;
+	Parameters.ParallelColor           = glm::f32vec3(1.0f);
+	Parameters.ParallelBrightness      = 1.0f;
+
+	Parameters.ShaderFlags = std::uint32_t(
+		Blam::Tag<Blam::TagClass::ShaderEnvironment>::ShaderBitFlags::
+			AlphaTested
+	);
+	return Parameters;
+}
+
+static MaterialParameters FlattenShaderEnvironment(
+	const Blam::Tag<Blam::TagClass::ShaderEnvironment>& Shader
+)
+{
+	const auto ToVec3 = [](const Blam::Vector3f& Vector) -> glm::f32vec3 {
+		return glm::f32vec3(Vector[0], Vector[1], Vector[2]);
+	};
+
+	const auto ToGlow
+		= [&](const Blam::Vector3f& OnColor, const Blam::Vector3f& OffColor,
+			  Blam::AnimationFunction Function, float Period,
+			  float Phase) -> GlowAnimation {
+		GlowAnimation Glow = {};
+		Glow.OnColor       = ToVec3(OnColor);
+		Glow.OffColor      = ToVec3(OffColor);
+		Glow.Period        = Period;
+		Glow.Phase         = Phase;
+		Glow.Function      = std::uint32_t(Function);
+		return Glow;
+	};
+
+	// A map-scale of zero leaves the texture-coordinates unscaled
+	const auto ToScale = [](float Scale) -> float {
+		return Scale != 0.0f ? Scale : 1.0f;
+	};
+
+	MaterialParameters Parameters = {};
+
+	Parameters.PrimaryGlow = ToGlow(
+		Shader.PrimaryOnColor, Shader.PrimaryOffColor,
+		Shader.PrimaryAnimationFunction, Shader.PrimaryAnimationPeriod,
+		Shader.PrimaryAnimationPhase
+	);
+	Parameters.SecondaryGlow = ToGlow(
+		Shader.SecondaryOnColor, Shader.SecondaryOffColor,
+		Shader.SecondaryAnimationFunction, Shader.SecondaryAnimationPeriod,
+		Shader.SecondaryAnimationPhase
+	);
+	Parameters.PlasmaGlow = ToGlow(
+		Shader.GlowOnColor, Shader.GlowOffColor, Shader.GlowAnimationFunction,
+		Shader.GlowAnimationPeriod, Shader.GlowAnimationPhase
+	);
+
+	Parameters.UAnimationFunction = std::uint32_t(Shader.UAnimationFunction);
+	Parameters.UAnimationPeriod   = Shader.UAnimationPeriod;
+	Parameters.UAnimationScale    = Shader.UAnimationScale;
+	Parameters.VAnimationFunction = std::uint32_t(Shader.VAnimationFunction);
+	Parameters.VAnimationPeriod   = Shader.VAnimationPeriod;
+	Parameters.VAnimationScale    = Shader.VAnimationScale;
+
+	Parameters.BumpMapScale = ToScale(Shader.BumpMapScale);
+	Parameters.GlowMapScale = ToScale(Shader.GlowMapScale);
+
+	Parameters.PerpendicularColor      = ToVec3(Shader.PerpendicularColor);
+	Parameters.PerpendicularBrightness = Shader.PerpendicularBrightness;
+	Parameters.ParallelColor           = ToVec3(Shader.ParallelColor);
+	Parameters.ParallelBrightness      = Shader.ParallelBrightness;
+
+	Parameters.ShaderFlags = std::uint32_t(Shader.ShaderFlags);
+	return Parameters;
+}
+
+// Must match the `MaterialFeature` constants of ShaderEnvironment.glsl
+enum class MaterialFeature : std::uint32_t
+{
+	BumpMap     = 1 << 0,
+	GlowMap     = 1 << 1,
+	Reflection  = 1 << 2,
+	AlphaTested = 1 << 3,
+};
+
+// The mask of `MaterialFeature`s that a shader-environment makes use of.
+// Missing maps are bound to default textures that do not contribute anything
+// to the shading
+static std::uint32_t GetMaterialFeatures(
+	const Blam::Tag<Blam::TagClass::ShaderEnvironment>& Shader
+)
+{
+	std::uint32_t Features = 0;
+	if( Shader.BumpMap.Valid() )
+	{
+		Features |= std::uint32_t(MaterialFeature::BumpMap);
+	}
+	if( Shader.GlowMap.Valid() )
+	{
+		Features |= std::uint32_t(MaterialFeature::GlowMap);
+	}
+	if( Shader.ReflectionCubeMap.Valid()
+		&& (Shader.PerpendicularBrightness > 0.0f
+			|| Shader.ParallelBrightness > 0.0f) )
+	{
+		Features |= std::uint32_t(MaterialFeature::Reflection);
+	}
+	if( std::uint32_t(Shader.ShaderFlags)
+		& std::uint32_t(Blam::Tag<Blam::TagClass::ShaderEnvironment>::
+							ShaderBitFlags::AlphaTested) )
+	{
+		Features |= std::uint32_t(MaterialFeature::AlphaTested);
+	}
+	return Features;
+}
+
+// Must match the `CullGlobalsBuffer` of CullDraws.comp
+struct CullGlobals
+{
+	std::array<glm::f32vec4, 6> FrustumPlanes;
+	glm::f32mat4                ViewProjection;
+	std::uint32_t               ItemCount;
+	std::uint32_t               GroupCount;
+	std::uint32_t               Phase;
+};
+
+static vk::DescriptorSetLayoutBinding CullBindings[] = {
+	{// CullItems
+	 0, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// DrawCommands
+	 1, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// DrawCounts
+	 2, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// CullGlobalsBuffer
+	 3, vk::DescriptorType::eUniformBufferDynamic, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// ItemVisibility
+	 4, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// DepthPyramid
+	 5, vk::DescriptorType::eCombinedImageSampler, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// MeshLODs
+	 6, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+};
+
+// Must match the `CellSize` of DetailObjects.comp. Instances are placed
+// within their cell in 1/256ths of the cell
+static constexpr float DetailObjectCellSize = 8.0f;
+
+// Must match DetailObjects.comp, with std430 layout
+struct alignas(16) DetailCell
+{
+	glm::f32vec3  Origin;
+	std::uint32_t _Padding0C;
+};
+static_assert(sizeof(DetailCell) == 16);
+
+struct DetailInstance
+{
+	// x, y, z, and type, in that order from the lowest byte
+	std::uint32_t PositionData;
+	std::uint32_t Color;
+	std::uint32_t CellIndex;
+};
+static_assert(sizeof(DetailInstance) == 12);
+
+// Must match `VisibleDetail` within vkBlam.glsl
+struct VisibleDetail
+{
+	glm::f32vec3  Position;
+	std::uint32_t Color;
+};
+static_assert(sizeof(VisibleDetail) == 16);
+
+// Must match the `DetailGlobalsBuffer` of DetailObjects.comp
+struct DetailGlobals
+{
+	std::array<glm::f32vec4, 6> FrustumPlanes;
+	glm::f32vec3                ViewPosition;
+	float                       MaxDistance;
+	std::uint32_t               InstanceCount;
+};
+
+static vk::DescriptorSetLayoutBinding DetailCullBindings[] = {
+	{// DetailCells
+	 0, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// DetailInstances
+	 1, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// VisibleDetails
+	 2, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// DrawCommand
+	 3, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// DetailGlobalsBuffer
+	 4, vk::DescriptorType::eUniformBufferDynamic, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+};
+
+// Shared by DepthPyramidBase.comp and DepthPyramidReduce.comp
+static vk::DescriptorSetLayoutBinding DepthPyramidBindings[] = {
+	{// DepthSource
+	 0, vk::DescriptorType::eCombinedImageSampler, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// SourceLevel
+	 1, vk::DescriptorType::eStorageImage, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// DestLevel
+	 2, vk::DescriptorType::eStorageImage, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+};
+
+// Only ever used with `texelFetch`
+static vk::SamplerCreateInfo DepthPyramidSampler()
+{
+	vk::SamplerCreateInfo SamplerInfo = {};
+	SamplerInfo.magFilter             = vk::Filter::eNearest;
+	SamplerInfo.minFilter             = vk::Filter::eNearest;
+	SamplerInfo.mipmapMode            = vk::SamplerMipmapMode::eNearest;
+	SamplerInfo.addressModeU          = vk::SamplerAddressMode::eClampToEdge;
+	SamplerInfo.addressModeV          = vk::SamplerAddressMode::eClampToEdge;
+	SamplerInfo.addressModeW          = vk::SamplerAddressMode::eClampToEdge;
+	SamplerInfo.maxLod                = VK_LOD_CLAMP_NONE;
+	return SamplerInfo;
+}
+
+// The simplified indices of each level-of-detail of each mesh are cached
+// within a single file, keyed by a hash of all of the source geometry
+static constexpr std::uint32_t LODCacheMagic   = 0x444F4C42; // "BLOD"
+static constexpr std::uint32_t LODCacheVersion = 1;
+
+struct LODCacheHeader
+{
+	std::uint32_t Magic;
+	std::uint32_t Version;
+	// Amount of index-lists that follow, each prefixed by its index-count
+	std::uint32_t ListCount;
+	std::uint32_t Reserved;
+};
+
+// Each index of `IndexLists[i]` must be less than `VertexCounts[i]`
+static bool ReadLODCache(
+	const std::filesystem::path&          CachePath,
+	std::span<std::vector<std::uint32_t>> IndexLists,
+	std::span<const std::uint32_t>        VertexCounts
+)
+{
+	std::ifstream CacheFile(CachePath, std::ios::binary);
+	if( !CacheFile )
+	{
+		return false;
+	}
+
+	// Guards against allocating the index-counts of a truncated or corrupt
+	// file
+	std::error_code ErrorCode;
+	const std::uintmax_t FileSize
+		= std::filesystem::file_size(CachePath, ErrorCode);
+	if( ErrorCode || FileSize < sizeof(LODCacheHeader) )
+	{
+		return false;
+	}
+	std::uintmax_t RemainingSize = FileSize - sizeof(LODCacheHeader);
+
+	LODCacheHeader Header = {};
+	CacheFile.read(reinterpret_cast<char*>(&Header), sizeof(Header));
+	if( !CacheFile || Header.Magic != LODCacheMagic
+		|| Header.Version != LODCacheVersion
+		|| Header.ListCount != IndexLists.size() )
+	{
+		return false;
+	}
+
+	// Only written to `IndexLists` once the whole file has been read
+	std::vector<std::vector<std::uint32_t>> CachedIndexLists(
+		IndexLists.size()
+	);
+	for( std::size_t ListIndex = 0; ListIndex < CachedIndexLists.size();
+		 ++ListIndex )
+	{
+		std::vector<std::uint32_t>& CurIndexList = CachedIndexLists[ListIndex];
+
+		std::uint32_t IndexCount = 0;
+		CacheFile.read(
+			reinterpret_cast<char*>(&IndexCount), sizeof(IndexCount)
+		);
+		if( !CacheFile || IndexCount % 3 != 0
+			|| RemainingSize < sizeof(IndexCount) )
+		{
+			return false;
+		}
+		RemainingSize -= sizeof(IndexCount);
+
+		const std::uintmax_t ListSize
+			= std::uintmax_t(IndexCount) * sizeof(std::uint32_t);
+		if( ListSize > RemainingSize )
+		{
+			return false;
+		}
+		RemainingSize -= ListSize;
+
+		CurIndexList.resize(IndexCount);
+		CacheFile.read(
+			reinterpret_cast<char*>(CurIndexList.data()), ListSize
+		);
+		if( !CacheFile )
+		{
+			return false;
+		}
+
+		// The file may have been written for different geometry if the
+		// source-hash has collided
+		if( std::any_of(
+				CurIndexList.begin(), CurIndexList.end(),
+				[&](std::uint32_t CurIndex) -> bool {
+					return CurIndex >= VertexCounts[ListIndex];
+				}
+			) )
+		{
+			return false;
+		}
+	}
+
+	std::move(
+		CachedIndexLists.begin(), CachedIndexLists.end(), IndexLists.begin()
+	);
+	return true;
+}
+
+static void WriteLODCache(
+	const std::filesystem::path&                CachePath,
+	std::span<const std::vector<std::uint32_t>> IndexLists
+)
+{
+	std::error_code ErrorCode;
+	std::filesystem::create_directories(CachePath.parent_path(), ErrorCode);
+
+	// Written to a temporary file first so that an interrupted write never
+	// leaves a partial cache behind
+	std::filesystem::path TempPath = CachePath;
+	TempPath += ".tmp";
+	{
+		std::ofstream CacheFile(TempPath, std::ios::binary | std::ios::trunc);
+
+		const LODCacheHeader Header = {
+			LODCacheMagic, LODCacheVersion,
+			static_cast<std::uint32_t>(IndexLists.size()), 0};
+		CacheFile.write(
+			reinterpret_cast<const char*>(&Header), sizeof(Header)
+		);
+
+		for( const std::vector<std::uint32_t>& CurIndexList : IndexLists )
+		{
+			const std::uint32_t IndexCount = CurIndexList.size();
+			CacheFile.write(
+				reinterpret_cast<const char*>(&IndexCount), sizeof(IndexCount)
+			);
+			CacheFile.write(
+				reinterpret_cast<const char*>(CurIndexList.data()),
+				IndexCount * sizeof(std::uint32_t)
+			);
+		}
+
+		if( !CacheFile )
+		{
+			std::fprintf(
+				stderr, "Error writing LOD cache: %s\n",
+				TempPath.string().c_str()
+			);
+			return;
+		}
+	}
+
+	std::filesystem::rename(TempPath, CachePath, ErrorCode);
+	if( ErrorCode )
+	{
+		std::fprintf(
+			stderr, "Error writing LOD cache: %s\n",
+			ErrorCode.message().c_str()
+		);
+	}
+}
+
+// Must match CompactSurfaces.comp
+struct CompactionMesh
+{
+	std::uint32_t BSPIndex;
+	std::uint32_t SurfaceCount;
+	std::uint32_t IndexOffset;
+	std::int32_t  VertexOffset;
+};
+
+static vk::DescriptorSetLayoutBinding CompactionBindings[] = {
+	{// VisibleSurfaces
+	 0, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// SourceIndices
+	 1, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// Meshes
+	 2, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// VisibleIndices
+	 3, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// DrawCommands
+	 4, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// DirtyMeshes
+	 5, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+	{// SurfaceIDs
+	 6, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eCompute},
+};
+
 static vk::DescriptorSetLayoutBinding SceneBindings[] = {
 	{// Default2DSamplerFiltered
 	 0, vk::DescriptorType::eSampler, 1, vk::ShaderStageFlagBits::eFragment},
@@ -182,6 +748,15 @@ static vk::DescriptorSetLayoutBinding SceneBindings[] = {
 	 1, vk::DescriptorType::eSampler, 1, vk::ShaderStageFlagBits::eFragment},
 	{// DefaultCubeSampler
 	 2, vk::DescriptorType::eSampler, 1, vk::ShaderStageFlagBits::eFragment},
+	{// SceneGlobalsBuffer
+	 3, vk::DescriptorType::eUniformBuffer, 1,
+	 vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment},
+	{// MaterialTable
+	 4, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eFragment},
+	{// MeshMaterialIndices
+	 5, vk::DescriptorType::eStorageBuffer, 1,
+	 vk::ShaderStageFlagBits::eFragment},
 };
 
 static vk::DescriptorSetLayoutBinding ShaderEnvironmentBindings[] = {
@@ -210,968 +785,6083 @@ static vk::DescriptorSetLayoutBinding ShaderEnvironmentBindings[] = {
 
 namespace VkBlam
 {
-Scene::Scene(Renderer& TargetRenderer, const World& TargetWorld)
-	: TargetWorld(TargetWorld), TargetRenderer(TargetRenderer)
+Scene::Scene(
+	Renderer& TargetRenderer, const World& TargetWorld,
+	const SceneConfig& Config
+)
+	: TargetWorld(TargetWorld), TargetRenderer(TargetRenderer), Config(Config)
 {
 }
 
 Scene::~Scene()
 {
+	// Pending pipeline-variants are compiled against the layout and
+	// shader-modules of this scene
+	if( !PendingPipelines.empty() )
+	{
+		TargetRenderer.GetPipelineRegistry().WaitIdle();
+	}
+
+	for( const std::uint64_t& CurKey : PipelineVariants )
+	{
+		TargetRenderer.GetPipelineRegistry().ReleasePipeline(CurKey);
+	}
 }
 
-void Scene::Render(const SceneView& View, vk::CommandBuffer CommandBuffer)
+void Scene::SetVisibleSurfaces(
+	std::size_t BSPIndex, Blam::SurfaceOcclusionBitArrayConst VisibleSurfaces
+)
 {
+	if( Config.VisibleSurfaceCompaction == SurfaceCompaction::None
+		|| BSPIndex >= BSPVisibilities.size() )
+	{
+		return;
+	}
 
-	vk::Viewport Viewport = {};
-	Viewport.width        = float(View.Viewport.x);
-	Viewport.height       = -float(View.Viewport.y);
-	Viewport.x            = 0.0f;
-	Viewport.y            = float(View.Viewport.y);
-	Viewport.minDepth     = 0.0f;
-	Viewport.maxDepth     = 1.0f;
-	CommandBuffer.setViewport(0, {Viewport});
-	// Scissor
-	vk::Rect2D Scissor    = {};
-	Scissor.extent.width  = View.Viewport.x;
-	Scissor.extent.height = View.Viewport.y;
-	CommandBuffer.setScissor(0, {Scissor});
+	BSPVisibility& CurBSP = BSPVisibilities[BSPIndex];
 
-	CommandBuffer.bindPipeline(
-		vk::PipelineBindPoint::eGraphics, DebugDrawPipeline.get()
+	const Blam::SurfaceOcclusionBitArrayConst PrevVisibleSurfaces(
+		CurBSP.VisibleSurfaces.data(), CurBSP.VisibleSurfaces.size()
 	);
 
-	// Bing Scene globals
-	CommandBuffer.bindDescriptorSets(
-		vk::PipelineBindPoint::eGraphics, DebugDrawPipelineLayout.get(), 0,
-		{CurSceneDescriptor}, {}
-	);
+	std::vector<std::array<std::uint16_t, 3>> CompactedSurfaces;
 
-	CommandBuffer.pushConstants<VkBlam::CameraGlobals>(
-		DebugDrawPipelineLayout.get(), vk::ShaderStageFlagBits::eAllGraphics, 0,
-		{View.CameraGlobalsData}
-	);
+	bool VisibilityChanged = false;
+	for( std::uint32_t MeshIndex = 0; MeshIndex < LightmapMeshs.size();
+		 ++MeshIndex )
+	{
+		LightmapMesh& CurLightmapMesh = LightmapMeshs[MeshIndex];
+		if( CurLightmapMesh.BSPIndex != BSPIndex )
+		{
+			continue;
+		}
 
-	CommandBuffer.bindVertexBuffers(
-		0, {BSPVertexBuffer.get(), BSPLightmapVertexBuffer.get()}, {0, 0}
-	);
+		// Skip meshes whose visibility has not changed
+		if( !Blam::SurfaceVisibilityChanged(
+				VisibleSurfaces, PrevVisibleSurfaces,
+				CurLightmapMesh.SurfaceStart, CurLightmapMesh.SurfaceCount
+			) )
+		{
+			continue;
+		}
 
-	CommandBuffer.bindIndexBuffer(
-		BSPIndexBuffer.get(), 0, vk::IndexType::eUint16
-	);
+		VisibilityChanged = true;
 
-	for( std::size_t i = 0; i < LightmapMeshs.size(); ++i )
-	{
-		const auto& CurLightmapMesh = LightmapMeshs[i];
-		Vulkan::InsertDebugLabel(
-			CommandBuffer, {0.5, 0.5, 0.5, 1.0}, "BSP Draw: %zu", i
-		);
-
-		// Bind Shader descriptors
-		if( ShaderEnvironmentDescriptors.contains(CurLightmapMesh.ShaderTag) )
+		if( Config.VisibleSurfaceCompaction == SurfaceCompaction::CPU )
 		{
-			CommandBuffer.bindDescriptorSets(
-				vk::PipelineBindPoint::eGraphics, DebugDrawPipelineLayout.get(),
-				1, {ShaderEnvironmentDescriptors.at(CurLightmapMesh.ShaderTag)},
-				{}
-			);
-		}
+			CompactedSurfaces.resize(CurLightmapMesh.SurfaceCount);
 
-		// Bind Mesh descriptors
-		if( CurLightmapMesh.LightmapTag.has_value()
-			&& CurLightmapMesh.LightmapIndex.has_value() )
-		{
-			CommandBuffer.bindDescriptorSets(
-				vk::PipelineBindPoint::eGraphics, DebugDrawPipelineLayout.get(),
-				2,
-				{BitmapHeap.Sets.at(CurLightmapMesh.LightmapTag.value())
-					 .at(CurLightmapMesh.LightmapIndex.value())},
-				{}
+			const std::size_t VisibleSurfaceCount
+				= Blam::CompactVisibleSurfaces(
+					CurBSP.Surfaces, VisibleSurfaces,
+					CurLightmapMesh.SurfaceStart, CurLightmapMesh.SurfaceCount,
+					CompactedSurfaces
+				);
+
+			CurLightmapMesh.VisibleIndexCount = VisibleSurfaceCount * 3;
+
+			TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+				std::as_bytes(
+					std::span(CompactedSurfaces).first(VisibleSurfaceCount)
+				),
+				VisibleIndexBuffer.get(),
+				CurLightmapMesh.IndexOffset * sizeof(std::uint16_t)
 			);
 		}
-		else
+		else if( std::find(DirtyMeshes.begin(), DirtyMeshes.end(), MeshIndex)
+				 == DirtyMeshes.end() )
 		{
-			CommandBuffer.bindDescriptorSets(
-				vk::PipelineBindPoint::eGraphics, DebugDrawPipelineLayout.get(),
-				2,
-				{BitmapHeap.Sets.at(BitmapHeap.Default2D)
-					 .at(std::uint32_t(Blam::DefaultTextureIndex::Multiplicative
-					 ))},
-				{}
-			);
+			DirtyMeshes.push_back(MeshIndex);
 		}
+	}
 
-		CommandBuffer.drawIndexed(
-			CurLightmapMesh.IndexCount, 1, CurLightmapMesh.IndexOffset,
-			CurLightmapMesh.VertexIndexOffset, 0
+	if( !VisibilityChanged )
+	{
+		return;
+	}
+
+	// The visible index-counts are recorded into the draws
+	if( Config.VisibleSurfaceCompaction == SurfaceCompaction::CPU )
+	{
+		DrawsDirty = true;
+	}
+
+	if( Config.VisibleSurfaceCompaction == SurfaceCompaction::GPU )
+	{
+		TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+			std::as_bytes(VisibleSurfaces), VisibleSurfaceBitsBuffer.get(),
+			BSPIndex * VisibleSurfaces.size_bytes()
 		);
 	}
+
+	std::copy(
+		VisibleSurfaces.begin(), VisibleSurfaces.end(),
+		CurBSP.VisibleSurfaces.begin()
+	);
 }
 
-std::optional<Scene>
-	Scene::Create(Renderer& TargetRenderer, const World& TargetWorld)
+void Scene::UpdateVisibleSurfaces(const SceneView& View)
 {
-	Scene NewScene(TargetRenderer, TargetWorld);
-
-	const Vulkan::Context& VulkanContext = TargetRenderer.GetVulkanContext();
-
-	// Descriptor pools
+	const CameraGlobals& Camera = View.CameraGlobalsData;
+
+	// The frustum is a pyramid from the view's position to the corners of
+	// its far-plane, so it is bounded by those five points
+	const glm::f32mat4 InverseViewProjection
+		= glm::inverse(Camera.ViewProjection);
+
+	glm::f32vec3 FrustumMin = glm::f32vec3(glm::inverse(Camera.View)[3]);
+	glm::f32vec3 FrustumMax = FrustumMin;
+	for( const glm::f32vec2& Corner :
+		 {glm::f32vec2(-1.0f, -1.0f), glm::f32vec2(1.0f, -1.0f),
+		  glm::f32vec2(-1.0f, 1.0f), glm::f32vec2(1.0f, 1.0f)} )
 	{
-		NewScene.ShaderEnvironmentDescriptorPool
-			= std::make_unique<Vulkan::DescriptorHeap>(
-				Vulkan::DescriptorHeap::Create(
-					VulkanContext, ShaderEnvironmentBindings
-				)
-					.value()
-			);
-		NewScene.DebugDrawDescriptorPool
-			= std::make_unique<Vulkan::DescriptorHeap>(
-				Vulkan::DescriptorHeap::Create(
-					VulkanContext, {{vk::DescriptorSetLayoutBinding(
-									   0, vk::DescriptorType::eSampledImage, 1,
-									   vk::ShaderStageFlagBits::eFragment
-								   )}}
-				).value()
-			);
+		const glm::f32vec4 FarCorner
+			= InverseViewProjection * glm::f32vec4(Corner, 1.0f, 1.0f);
+		const glm::f32vec3 Point = glm::f32vec3(FarCorner) / FarCorner.w;
 
-		NewScene.UnlitDescriptorPool = std::make_unique<Vulkan::DescriptorHeap>(
-			Vulkan::DescriptorHeap::Create(
-				VulkanContext, {{vk::DescriptorSetLayoutBinding(
-								   0, vk::DescriptorType::eSampledImage, 1,
-								   vk::ShaderStageFlagBits::eFragment
-							   )}}
-			).value()
-		);
-		NewScene.SceneDescriptorPool = std::make_unique<Vulkan::DescriptorHeap>(
-			Vulkan::DescriptorHeap::Create(VulkanContext, SceneBindings).value()
-		);
+		FrustumMin = glm::min(FrustumMin, Point);
+		FrustumMax = glm::max(FrustumMax, Point);
 	}
 
-	// Scene Descriptor
-	{
-		NewScene.CurSceneDescriptor
-			= NewScene.SceneDescriptorPool->AllocateDescriptorSet().value();
-		// Default2DSamplerFiltered
-		TargetRenderer.GetDescriptorUpdateBatch().AddSampler(
-			NewScene.CurSceneDescriptor, 0,
-			TargetRenderer.GetSamplerCache().GetSampler(Sampler2D())
-		);
+	const Blam::Bounds3D FrustumBounds = {
+		{FrustumMin.x, FrustumMax.x},
+		{FrustumMin.y, FrustumMax.y},
+		{FrustumMin.z, FrustumMax.z},
+	};
 
-		// Default2DSamplerUnfiltered
-		TargetRenderer.GetDescriptorUpdateBatch().AddSampler(
-			NewScene.CurSceneDescriptor, 1,
-			TargetRenderer.GetSamplerCache().GetSampler(Sampler2D(false))
+	std::vector<std::uint32_t> VisibleSurfaces(0x2'0000 / 32);
+	for( std::size_t BSPIndex = 0; BSPIndex < BSPVisibilities.size();
+		 ++BSPIndex )
+	{
+		BSPVisibility& CurBSP = BSPVisibilities[BSPIndex];
+
+		const Blam::Tag<Blam::TagClass::Scenario>::StructureBSP& CurSBSP
+			= TargetWorld.GetMapFile().GetScenarioBSPs()[BSPIndex];
+		const Blam::VirtualHeap SBSPHeap
+			= CurSBSP.GetSBSPHeap(TargetWorld.GetMapFile().GetMapData());
+
+		std::fill(VisibleSurfaces.begin(), VisibleSurfaces.end(), 0u);
+		Blam::GenerateVisibleSurfaceIndices(
+			SBSPHeap, CurBSP.SubClusterBounds, FrustumBounds,
+			CurBSP.SubClusterHitMask,
+			Blam::SurfaceOcclusionBitArray(VisibleSurfaces),
+			CurBSP.VisibleClusters
 		);
 
-		// Default2DSamplerUnfiltered
-		TargetRenderer.GetDescriptorUpdateBatch().AddSampler(
-			NewScene.CurSceneDescriptor, 2,
-			TargetRenderer.GetSamplerCache().GetSampler(SamplerCube())
+		SetVisibleSurfaces(
+			BSPIndex, Blam::SurfaceOcclusionBitArrayConst(VisibleSurfaces)
 		);
 	}
+}
 
+void Scene::SetVisibleClusters(
+	std::size_t BSPIndex, std::span<const std::uint32_t> VisibleClusters
+)
+{
+	if( BSPIndex >= BSPVisibilities.size() )
 	{
-		// Main Shader modules
-		const auto DefaultVertShaderData
-			= VkBlam::OpenResource("shaders/Default.vert.spv").value();
-		const auto DefaultFragShaderData
-			= VkBlam::OpenResource("shaders/Default.frag.spv").value();
-		const auto UnlitFragShaderData
-			= VkBlam::OpenResource("shaders/Unlit.frag.spv").value();
-
-		std::hash<std::string> StringHasher = {};
+		return;
+	}
 
-		NewScene.DefaultVertexShaderModule
-			= TargetRenderer.GetShaderModuleCache()
-				  .GetShaderModule(
-					  StringHasher("shaders/Default.vert.spv"),
-					  DefaultVertShaderData
-				  )
-				  .value();
-		NewScene.DefaultFragmentShaderModule
-			= TargetRenderer.GetShaderModuleCache()
-				  .GetShaderModule(
-					  StringHasher("shaders/Default.frag.spv"),
-					  DefaultFragShaderData
-				  )
-				  .value();
-		NewScene.UnlitFragmentShaderModule
-			= TargetRenderer.GetShaderModuleCache()
-				  .GetShaderModule(
-					  StringHasher("shaders/Unlit.frag.spv"),
-					  UnlitFragShaderData
-				  )
-				  .value();
+	std::vector<std::uint32_t>& CurVisibleClusters
+		= BSPVisibilities[BSPIndex].VisibleClusters;
 
-		const vk::RenderPass RenderPass
-			= TargetRenderer.GetDefaultRenderPass(RenderSamples);
+	if( std::equal(
+			VisibleClusters.begin(), VisibleClusters.end(),
+			CurVisibleClusters.begin(), CurVisibleClusters.end()
+		) )
+	{
+		return;
+	}
 
-		const auto [VertexBindingDescriptions, VertexAttributeDescriptions]
-			= VkBlam::GetVertexInputDescriptions({{
-				Blam::VertexFormat::SBSPVertexUncompressed,
-				Blam::VertexFormat::SBSPLightmapVertexUncompressed,
-			}});
+	CurVisibleClusters.assign(VisibleClusters.begin(), VisibleClusters.end());
 
-		std::tie(NewScene.DebugDrawPipeline, NewScene.DebugDrawPipelineLayout)
-			= CreateGraphicsPipeline(
-				VulkanContext.LogicalDevice,
-				{{vk::PushConstantRange(
-					vk::ShaderStageFlagBits::eAllGraphics, 0,
-					sizeof(VkBlam::CameraGlobals)
-				)}},
-				{{NewScene.SceneDescriptorPool->GetDescriptorSetLayout(),
-				  NewScene.ShaderEnvironmentDescriptorPool
-					  ->GetDescriptorSetLayout(),
-				  NewScene.DebugDrawDescriptorPool->GetDescriptorSetLayout()}},
-				NewScene.DefaultVertexShaderModule,
-				NewScene.DefaultFragmentShaderModule, VertexBindingDescriptions,
-				VertexAttributeDescriptions, RenderPass, RenderSamples,
-				vk::PolygonMode::eFill
-			);
+	DecalsDirty = true;
 
-		std::tie(NewScene.UnlitDrawPipeline, NewScene.UnlitDrawPipelineLayout)
-			= CreateGraphicsPipeline(
-				VulkanContext.LogicalDevice,
-				{{vk::PushConstantRange(
-					vk::ShaderStageFlagBits::eAllGraphics, 0,
-					sizeof(VkBlam::CameraGlobals)
-				)}},
-				{{NewScene.UnlitDescriptorPool->GetDescriptorSetLayout(),
-				  NewScene.UnlitDescriptorPool->GetDescriptorSetLayout()}},
-				NewScene.DefaultVertexShaderModule,
-				NewScene.UnlitFragmentShaderModule, VertexBindingDescriptions,
-				VertexAttributeDescriptions, RenderPass, RenderSamples,
-				vk::PolygonMode::eLine
-			);
+	// The visible cluster-ranges are recorded into the draws, unless they
+	// are culled on the GPU
+	if( !CullPipeline )
+	{
+		DrawsDirty = true;
 	}
+}
 
-	std::vector<Blam::TagVisitorProc> TagVisitors = {};
-
-	// Load BSP
+void Scene::SetViewPosition(const glm::f32vec3& Position)
+{
+	for( std::size_t BSPIndex = 0; BSPIndex < BSPVisibilities.size();
+		 ++BSPIndex )
 	{
-		// Index in elements, not bytes
-		std::uint32_t VertexHeapIndexEnd = 0;
-		std::uint32_t IndexHeapIndexEnd  = 0;
+		const std::optional<std::uint16_t> ViewCluster
+			= TargetWorld.FindCluster(Position, BSPIndex);
 
-		for( const Blam::Tag<Blam::TagClass::Scenario>::StructureBSP& CurSBSP :
-			 TargetWorld.GetMapFile().GetScenarioBSPs() )
+		if( !ViewCluster.has_value() )
 		{
-			const Blam::VirtualHeap SBSPHeap
-				= CurSBSP.GetSBSPHeap(TargetWorld.GetMapFile().GetMapData());
-
-			const Blam::Tag<Blam::TagClass::ScenarioStructureBsp>& ScenarioBSP
-				= CurSBSP.GetSBSP(SBSPHeap);
-
-			const auto Surfaces = SBSPHeap.GetBlock(ScenarioBSP.Surfaces);
-
-			std::uint32_t SBSPIndexHeapEnd = IndexHeapIndexEnd;
-
-			// Lightmap
-			for( const auto& CurLightmap :
-				 SBSPHeap.GetBlock(ScenarioBSP.Lightmaps) )
-			{
-				const auto& LightmapTextureTag
-					= TargetWorld.GetMapFile().GetTag<Blam::TagClass::Bitmap>(
-						ScenarioBSP.LightmapTexture.TagID
-					);
-				const std::int16_t LightmapTextureIndex
-					= CurLightmap.LightmapIndex;
+			SetVisibleClusters(BSPIndex, {});
+			continue;
+		}
 
-				for( const auto& CurMaterial :
-					 SBSPHeap.GetBlock(CurLightmap.Materials) )
-				{
+		const Blam::Tag<Blam::TagClass::Scenario>::StructureBSP& CurSBSP
+			= TargetWorld.GetMapFile().GetScenarioBSPs()[BSPIndex];
+		const Blam::VirtualHeap SBSPHeap
+			= CurSBSP.GetSBSPHeap(TargetWorld.GetMapFile().GetMapData());
 
-					std::printf(
-						"Shader(%s): %s | Permutation: %04X | Surfaces: "
-						"[%04d,%04d)\n",
-						Blam::FormatTagClass(CurMaterial.Shader.Class).c_str(),
-						TargetWorld.GetMapFile()
-							.GetTagName(CurMaterial.Shader.TagID)
-							.data(),
-						CurMaterial.ShaderPermutation,
-						CurMaterial.SurfacesIndexStart,
-						CurMaterial.SurfacesIndexStart
-							+ CurMaterial.SurfacesCount
-					);
+		SetVisibleClusters(
+			BSPIndex,
+			Blam::GetClusterPVS(
+				SBSPHeap, CurSBSP.GetSBSP(SBSPHeap), ViewCluster.value()
+			)
+		);
+	}
+}
 
-					auto& CurLightmapMesh
-						= NewScene.LightmapMeshs.emplace_back();
-					//// Vertex Buffer data
-					{
-						// Copy vertex data into the staging buffer
-						const std::span<const Blam::Vertex> CurVertexData
-							= CurMaterial.GetVertices(SBSPHeap);
+void Scene::SetSimulationTime(float Time)
+{
+	SimulationTime = Time;
+}
 
-						CurLightmapMesh.VertexData = CurVertexData;
+bool Scene::SelectLODs(const SceneView& View)
+{
+	const CameraGlobals& Camera = View.CameraGlobalsData;
 
-						// Add the offset needed to begin indexing into
-						// this particular part of the vertex buffer,
-						// used when drawing
-						CurLightmapMesh.VertexIndexOffset = VertexHeapIndexEnd;
+	// Only perspective projections shrink a mesh with its distance
+	const bool         Perspective = Camera.Projection[2][3] != 0.0f;
+	const glm::f32vec3 ViewPosition
+		= glm::f32vec3(glm::inverse(Camera.View)[3]);
 
-						CurLightmapMesh.ShaderTag = CurMaterial.Shader.TagID;
+	// Pixels that one unit covers at a distance of one unit
+	const float PixelScale
+		= 0.5f * float(View.Viewport.y) * std::abs(Camera.Projection[1][1]);
 
-						if( ScenarioBSP.LightmapTexture.Valid()
-							&& LightmapTextureIndex != -1 )
-						{
-							CurLightmapMesh.LightmapTag
-								= ScenarioBSP.LightmapTexture.TagID;
-							CurLightmapMesh.LightmapIndex
-								= LightmapTextureIndex;
-						}
+	bool Changed = false;
+	for( std::size_t MeshIndex = 0; MeshIndex < LightmapMeshs.size();
+		 ++MeshIndex )
+	{
+		const LightmapMesh& CurLightmapMesh = LightmapMeshs[MeshIndex];
+		if( CurLightmapMesh.LODCount <= 1 )
+		{
+			continue;
+		}
 
-						//// Lightmap vertex buffer data
-						{
-							const std::span<const Blam::LightmapVertex>
-								CurLightmapVertexData
-								= CurMaterial.GetLightmapVertices(SBSPHeap);
-							CurLightmapMesh.LightmapVertexData
-								= CurLightmapVertexData;
-						}
+		const glm::f32vec3 Center
+			= (CurLightmapMesh.BoundsMin + CurLightmapMesh.BoundsMax) * 0.5f;
+		const float Radius
+			= glm::length(CurLightmapMesh.BoundsMax - CurLightmapMesh.BoundsMin)
+			* 0.5f;
 
-						VertexHeapIndexEnd += CurVertexData.size();
-					}
+		// Projected radius of the bounding-sphere, which covers the whole
+		// view when it contains the view
+		float PixelRadius = Radius * PixelScale;
+		if( Perspective )
+		{
+			const float Distance = glm::distance(Center, ViewPosition);
+			if( Distance > Radius )
+			{
+				PixelRadius /= Distance;
+			}
+			else
+			{
+				PixelRadius = std::numeric_limits<float>::infinity();
+			}
+		}
+		const float PixelArea
+			= std::numbers::pi_v<float> * PixelRadius * PixelRadius;
 
-					//// Index Buffer data
-					CurLightmapMesh.IndexOffset = SBSPIndexHeapEnd;
-					CurLightmapMesh.IndexCount  = CurMaterial.SurfacesCount * 3;
-					SBSPIndexHeapEnd += CurMaterial.SurfacesCount * 3;
-				}
+		// The most detailed level whose triangles still cover enough pixels
+		std::uint32_t LOD = 0;
+		while( LOD + 1 < CurLightmapMesh.LODCount )
+		{
+			const float TriangleCount
+				= float(CurLightmapMesh.LODIndexCounts[LOD] / 3);
+			if( TriangleCount * Config.LODTrianglePixels <= PixelArea )
+			{
+				break;
 			}
+			++LOD;
+		}
 
-			IndexHeapIndexEnd += ScenarioBSP.Surfaces.Count * 3;
+		if( MeshLODs[MeshIndex] != LOD )
+		{
+			MeshLODs[MeshIndex] = LOD;
+			Changed             = true;
 		}
+	}
+	return Changed;
+}
 
-		//// Create Vertex buffer heap
-		vk::BufferCreateInfo BSPVertexBufferInfo = {};
-		BSPVertexBufferInfo.size  = VertexHeapIndexEnd * sizeof(Blam::Vertex);
-		BSPVertexBufferInfo.usage = vk::BufferUsageFlagBits::eVertexBuffer
-								  | vk::BufferUsageFlagBits::eTransferDst;
+// Selects the level-of-detail of each bounding-sphere from its projected
+// diameter in pixels, one level less detailed for each of its `Cutoffs` that
+// the diameter does not exceed. Spheres that contain the view are always drawn
+// at their most detailed level
+static void SelectSphereLODs(
+	std::span<const float> CenterX, std::span<const float> CenterY,
+	std::span<const float> CenterZ, std::span<const float> Radius,
+	std::span<const std::vector<float>> Cutoffs,
+	const glm::f32vec3& ViewPosition, float PixelScale, bool Perspective,
+	std::span<std::uint32_t> LODs
+)
+{
+	const float       DiameterScale = 2.0f * PixelScale;
+	const float       Infinity      = std::numeric_limits<float>::infinity();
+	const std::size_t Count         = LODs.size();
+
+	std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+	const __m128 ViewX     = _mm_set1_ps(ViewPosition.x);
+	const __m128 ViewY     = _mm_set1_ps(ViewPosition.y);
+	const __m128 ViewZ     = _mm_set1_ps(ViewPosition.z);
+	const __m128 Scale     = _mm_set1_ps(DiameterScale);
+	const __m128 Unbounded = _mm_set1_ps(Infinity);
+	for( ; i + 4 <= Count; i += 4 )
+	{
+		const __m128 CurRadius = _mm_loadu_ps(&Radius[i]);
 
-		if( auto CreateResult
-			= VulkanContext.LogicalDevice.createBufferUnique(BSPVertexBufferInfo
-			);
-			CreateResult.result == vk::Result::eSuccess )
+		__m128 Pixels = _mm_mul_ps(CurRadius, Scale);
+		if( Perspective )
 		{
-			NewScene.BSPVertexBuffer = std::move(CreateResult.value);
+			const __m128 DX = _mm_sub_ps(_mm_loadu_ps(&CenterX[i]), ViewX);
+			const __m128 DY = _mm_sub_ps(_mm_loadu_ps(&CenterY[i]), ViewY);
+			const __m128 DZ = _mm_sub_ps(_mm_loadu_ps(&CenterZ[i]), ViewZ);
+			const __m128 Distance = _mm_sqrt_ps(_mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(DX, DX), _mm_mul_ps(DY, DY)),
+				_mm_mul_ps(DZ, DZ)
+			));
+			const __m128 Outside = _mm_cmpgt_ps(Distance, CurRadius);
+
+			Pixels = _mm_or_ps(
+				_mm_and_ps(Outside, _mm_div_ps(Pixels, Distance)),
+				_mm_andnot_ps(Outside, Unbounded)
+			);
 		}
-		else
+
+		// Each passing comparison is -1
+		__m128i LOD = _mm_setzero_si128();
+		for( const std::vector<float>& CurCutoffs : Cutoffs )
 		{
-			std::fprintf(
-				stderr, "Error creating vertex buffer: %s\n",
-				vk::to_string(CreateResult.result).c_str()
+			LOD = _mm_sub_epi32(
+				LOD, _mm_castps_si128(
+						 _mm_cmpge_ps(_mm_loadu_ps(&CurCutoffs[i]), Pixels)
+					 )
 			);
-			return {};
 		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&LODs[i]), LOD);
+	}
+#elif defined(__aarch64__)
+	const float32x4_t ViewX     = vdupq_n_f32(ViewPosition.x);
+	const float32x4_t ViewY     = vdupq_n_f32(ViewPosition.y);
+	const float32x4_t ViewZ     = vdupq_n_f32(ViewPosition.z);
+	const float32x4_t Scale     = vdupq_n_f32(DiameterScale);
+	const float32x4_t Unbounded = vdupq_n_f32(Infinity);
+	for( ; i + 4 <= Count; i += 4 )
+	{
+		const float32x4_t CurRadius = vld1q_f32(&Radius[i]);
 
-		Vulkan::SetObjectName(
-			VulkanContext.LogicalDevice, NewScene.BSPVertexBuffer.get(),
-			"VkBlam::Scene: BSP Vertex Buffer( %s )",
-			Common::FormatByteCount(BSPVertexBufferInfo.size).c_str()
-		);
+		float32x4_t Pixels = vmulq_f32(CurRadius, Scale);
+		if( Perspective )
+		{
+			const float32x4_t DX = vsubq_f32(vld1q_f32(&CenterX[i]), ViewX);
+			const float32x4_t DY = vsubq_f32(vld1q_f32(&CenterY[i]), ViewY);
+			const float32x4_t DZ = vsubq_f32(vld1q_f32(&CenterZ[i]), ViewZ);
+			const float32x4_t Distance = vsqrtq_f32(vaddq_f32(
+				vaddq_f32(vmulq_f32(DX, DX), vmulq_f32(DY, DY)),
+				vmulq_f32(DZ, DZ)
+			));
+			Pixels = vbslq_f32(
+				vcgtq_f32(Distance, CurRadius), vdivq_f32(Pixels, Distance),
+				Unbounded
+			);
+		}
 
-		//// Create Vertex buffer heap
-		vk::BufferCreateInfo BSPLightmapVertexBufferInfo = {};
+		// Each passing comparison is all ones
+		uint32x4_t LOD = vdupq_n_u32(0);
+		for( const std::vector<float>& CurCutoffs : Cutoffs )
+		{
+			LOD = vsubq_u32(LOD, vcgeq_f32(vld1q_f32(&CurCutoffs[i]), Pixels));
+		}
+		vst1q_u32(&LODs[i], LOD);
+	}
+#endif
 
-		BSPLightmapVertexBufferInfo.size
-			= VertexHeapIndexEnd * sizeof(Blam::LightmapVertex);
-		BSPLightmapVertexBufferInfo.usage
-			= vk::BufferUsageFlagBits::eVertexBuffer
-			| vk::BufferUsageFlagBits::eTransferDst;
+	for( ; i < Count; ++i )
+	{
+		float Pixels = Radius[i] * DiameterScale;
+		if( Perspective )
+		{
+			const float DX       = CenterX[i] - ViewPosition.x;
+			const float DY       = CenterY[i] - ViewPosition.y;
+			const float DZ       = CenterZ[i] - ViewPosition.z;
+			const float Distance = std::sqrt(DX * DX + DY * DY + DZ * DZ);
+			Pixels = Distance > Radius[i] ? Pixels / Distance : Infinity;
+		}
 
-		if( auto CreateResult = VulkanContext.LogicalDevice.createBufferUnique(
-				BSPLightmapVertexBufferInfo
-			);
-			CreateResult.result == vk::Result::eSuccess )
+		std::uint32_t LOD = 0;
+		for( const std::vector<float>& CurCutoffs : Cutoffs )
 		{
-			NewScene.BSPLightmapVertexBuffer = std::move(CreateResult.value);
+			LOD += CurCutoffs[i] >= Pixels ? 1 : 0;
 		}
-		else
+		LODs[i] = LOD;
+	}
+}
+
+bool Scene::SelectObjectLODs(const SceneView& View)
+{
+	const CameraGlobals& Camera = View.CameraGlobalsData;
+
+	// Only perspective projections shrink a placement with its distance
+	const bool         Perspective = Camera.Projection[2][3] != 0.0f;
+	const glm::f32vec3 ViewPosition
+		= glm::f32vec3(glm::inverse(Camera.View)[3]);
+
+	// Pixels that one unit covers at a distance of one unit
+	const float PixelScale
+		= 0.5f * float(View.Viewport.y) * std::abs(Camera.Projection[1][1]);
+
+	std::vector<std::uint32_t> LODs(ObjectInstances.LODs.size());
+	SelectSphereLODs(
+		ObjectInstances.CenterX, ObjectInstances.CenterY,
+		ObjectInstances.CenterZ, ObjectInstances.Radius,
+		ObjectInstances.Cutoffs, ViewPosition, PixelScale, Perspective, LODs
+	);
+
+	if( LODs == ObjectInstances.LODs )
+	{
+		return false;
+	}
+	ObjectInstances.LODs = std::move(LODs);
+	return true;
+}
+
+std::uint32_t Scene::SortObjectInstances(
+	std::vector<vk::DrawIndexedIndirectCommand>& DrawCommands,
+	std::vector<InstanceTransform>&              Transforms
+) const
+{
+	DrawCommands.resize(ObjectModels.size() * ObjectLODCount);
+	Transforms.resize(ObjectInstances.Transforms.size());
+
+	std::uint32_t TrianglesSaved = 0;
+	for( std::size_t ModelIndex = 0; ModelIndex < ObjectModels.size();
+		 ++ModelIndex )
+	{
+		const ObjectModel& CurModel = ObjectModels[ModelIndex];
+
+		const std::span<const std::uint32_t> InstanceLODs
+			= std::span(ObjectInstances.LODs)
+				  .subspan(CurModel.InstanceOffset, CurModel.InstanceCount);
+
+		// Counting-sort of the model's placements by their level-of-detail,
+		// within the model's range of the instance-buffer
+		std::array<std::uint32_t, ObjectLODCount> LODInstanceCounts = {};
+		for( const std::uint32_t& CurLOD : InstanceLODs )
 		{
-			std::fprintf(
-				stderr, "Error creating lightmap vertex buffer: %s\n",
-				vk::to_string(CreateResult.result).c_str()
-			);
-			return {};
+			++LODInstanceCounts[CurLOD];
 		}
 
-		Vulkan::SetObjectName(
-			VulkanContext.LogicalDevice, NewScene.BSPLightmapVertexBuffer.get(),
-			"VkBlam::Scene: BSP Lightmap Vertex Buffer( %s )",
-			Common::FormatByteCount(BSPLightmapVertexBufferInfo.size).c_str()
+		std::array<std::uint32_t, ObjectLODCount> LODInstanceOffsets = {};
+		std::exclusive_scan(
+			LODInstanceCounts.begin(), LODInstanceCounts.end(),
+			LODInstanceOffsets.begin(), CurModel.InstanceOffset
 		);
 
-		//// Create Index buffer heap
-		vk::BufferCreateInfo BSPIndexBufferInfo = {};
-		BSPIndexBufferInfo.size  = IndexHeapIndexEnd * sizeof(std::uint16_t);
-		BSPIndexBufferInfo.usage = vk::BufferUsageFlagBits::eIndexBuffer
-								 | vk::BufferUsageFlagBits::eTransferDst;
+		for( std::size_t LOD = 0; LOD < ObjectLODCount; ++LOD )
+		{
+			vk::DrawIndexedIndirectCommand& CurCommand
+				= DrawCommands[ModelIndex * ObjectLODCount + LOD];
+			CurCommand.indexCount    = CurModel.LODIndexCounts[LOD];
+			CurCommand.instanceCount = LODInstanceCounts[LOD];
+			CurCommand.firstIndex    = CurModel.LODIndexOffsets[LOD];
+			CurCommand.vertexOffset  = std::int32_t(CurModel.VertexOffset);
+			CurCommand.firstInstance = LODInstanceOffsets[LOD];
+
+			const std::uint32_t IndicesSaved
+				= CurModel.LODIndexCounts[0]
+				- std::min(
+					CurModel.LODIndexCounts[0], CurModel.LODIndexCounts[LOD]
+				);
+			TrianglesSaved += LODInstanceCounts[LOD] * (IndicesSaved / 3);
+		}
 
-		if( auto CreateResult
-			= VulkanContext.LogicalDevice.createBufferUnique(BSPIndexBufferInfo
-			);
-			CreateResult.result == vk::Result::eSuccess )
+		for( std::size_t i = 0; i < InstanceLODs.size(); ++i )
 		{
-			NewScene.BSPIndexBuffer = std::move(CreateResult.value);
+			Transforms[LODInstanceOffsets[InstanceLODs[i]]++]
+				= ObjectInstances.Transforms[CurModel.InstanceOffset + i];
 		}
-		else
-		{
-			std::fprintf(
-				stderr, "Error creating Index buffer: %s\n",
-				vk::to_string(CreateResult.result).c_str()
-			);
-			return {};
-		}
-		Vulkan::SetObjectName(
-			VulkanContext.LogicalDevice, NewScene.BSPIndexBuffer.get(),
-			"VkBlam::Scene: BSP Index Buffer( %s )",
-			Common::FormatByteCount(BSPIndexBufferInfo.size).c_str()
-		);
+	}
+	return TrianglesSaved;
+}
 
-		// Create singular allocation of device memory for all vertex and index
-		// data
-		if( auto [Result, Value] = Vulkan::CommitBufferHeap(
-				VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
-				std::array{
-					NewScene.BSPVertexBuffer.get(),
-					NewScene.BSPIndexBuffer.get(),
-					NewScene.BSPLightmapVertexBuffer.get()}
-			);
-			Result == vk::Result::eSuccess )
-		{
-			NewScene.BSPGeometryMemory = std::move(Value);
-		}
-		else
-		{
-			std::fprintf(
-				stderr, "Error committing vertex/index memory: %s\n",
-				vk::to_string(Result).c_str()
-			);
-			return {};
-		}
-		Vulkan::SetObjectName(
-			VulkanContext.LogicalDevice, NewScene.BSPGeometryMemory.get(),
-			"VkBlam::Scene: BSP Geometry Device Memory( %s )",
-			Common::FormatByteCount(BSPIndexBufferInfo.size).c_str()
-		);
+bool Scene::LoadGeometry(std::size_t GeometryIndex)
+{
+	const Vulkan::Context& VulkanContext = TargetRenderer.GetVulkanContext();
+	Vulkan::StreamBuffer&  StreamBuffer  = TargetRenderer.GetStreamBuffer();
 
-		// Buffers are all now binded to device memory, begin streaming
-		for( const auto& CurLightmapMesh : NewScene.LightmapMeshs )
-		{
-			TargetRenderer.GetStreamBuffer().QueueBufferUpload(
-				std::as_bytes(CurLightmapMesh.VertexData),
-				NewScene.BSPVertexBuffer.get(),
-				CurLightmapMesh.VertexIndexOffset * sizeof(Blam::Vertex)
-			);
+	GeometryRegion&  CurRegion  = GeometryRegions[GeometryIndex];
+	GeometryBuffers& CurBuffers = CurRegion.Buffers;
 
-			TargetRenderer.GetStreamBuffer().QueueBufferUpload(
-				std::as_bytes(CurLightmapMesh.LightmapVertexData),
-				NewScene.BSPLightmapVertexBuffer.get(),
-				CurLightmapMesh.VertexIndexOffset * sizeof(Blam::LightmapVertex)
-			);
-		}
+	// Avoid zero-sized buffers
+	const std::size_t VertexCount
+		= std::max<std::size_t>(CurRegion.VertexCount, 1);
 
-		// Index Buffer
-		{
-			std::uint32_t IndexOffset = 0;
-			for( const Blam::Tag<Blam::TagClass::Scenario>::StructureBSP&
-					 CurSBSP : TargetWorld.GetMapFile().GetScenarioBSPs() )
-			{
-				const Blam::VirtualHeap SBSPHeap
-					= CurSBSP.GetSBSPHeap(TargetWorld.GetMapFile().GetMapData()
-					);
+	CurBuffers.VertexBuffer = CreateSceneBuffer(
+		VulkanContext.LogicalDevice, VertexCount * sizeof(Blam::Vertex),
+		vk::BufferUsageFlagBits::eVertexBuffer,
+		Common::Format("BSP %zu Vertex Buffer", GeometryIndex).c_str()
+	);
+	CurBuffers.LightmapVertexBuffer = CreateSceneBuffer(
+		VulkanContext.LogicalDevice,
+		VertexCount * sizeof(Blam::LightmapVertex),
+		vk::BufferUsageFlagBits::eVertexBuffer,
+		Common::Format("BSP %zu Lightmap Vertex Buffer", GeometryIndex).c_str()
+	);
+	// Padded to a whole word so that the compaction-shader may read it as an
+	// array of 32-bit values
+	CurBuffers.IndexBuffer = CreateSceneBuffer(
+		VulkanContext.LogicalDevice,
+		Common::AlignUp<vk::DeviceSize>(
+			std::max<std::size_t>(CurRegion.IndexData.size(), 1),
+			sizeof(std::uint32_t)
+		),
+		vk::BufferUsageFlagBits::eIndexBuffer
+			| (Config.VisibleSurfaceCompaction == SurfaceCompaction::GPU
+				   ? vk::BufferUsageFlagBits::eStorageBuffer
+				   : vk::BufferUsageFlags()),
+		Common::Format("BSP %zu Index Buffer", GeometryIndex).c_str()
+	);
 
-				const Blam::Tag<Blam::TagClass::ScenarioStructureBsp>&
-					ScenarioBSP
-					= CurSBSP.GetSBSP(SBSPHeap);
+	if( !CurBuffers.VertexBuffer || !CurBuffers.LightmapVertexBuffer
+		|| !CurBuffers.IndexBuffer )
+	{
+		CurBuffers = {};
+		return false;
+	}
 
-				const auto Surfaces = SBSPHeap.GetBlock(ScenarioBSP.Surfaces);
+	std::vector<vk::Buffer> Buffers = {
+		CurBuffers.VertexBuffer.get(), CurBuffers.LightmapVertexBuffer.get(),
+		CurBuffers.IndexBuffer.get()};
 
-				TargetRenderer.GetStreamBuffer().QueueBufferUpload(
-					std::as_bytes(Surfaces), NewScene.BSPIndexBuffer.get(),
-					IndexOffset
-				);
-				IndexOffset += Surfaces.size_bytes();
-			}
+	if( Config.DepthPrepass )
+	{
+		CurBuffers.PositionBuffer = CreateSceneBuffer(
+			VulkanContext.LogicalDevice, VertexCount * sizeof(glm::f32vec3),
+			vk::BufferUsageFlagBits::eVertexBuffer,
+			Common::Format("BSP %zu Position Buffer", GeometryIndex).c_str()
+		);
+		if( !CurBuffers.PositionBuffer )
+		{
+			CurBuffers = {};
+			return false;
 		}
+		Buffers.push_back(CurBuffers.PositionBuffer.get());
 	}
 
-	// Load bitmaps
+	// Create singular allocation of device memory for all of the region's
+	// vertex and index data
+	if( auto [Result, Value] = Vulkan::CommitBufferHeap(
+			VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice, Buffers
+		);
+		Result == vk::Result::eSuccess )
+	{
+		CurBuffers.Memory = std::move(Value);
+	}
+	else
 	{
+		std::fprintf(
+			stderr, "Error committing vertex/index memory: %s\n",
+			vk::to_string(Result).c_str()
+		);
+		CurBuffers = {};
+		return false;
+	}
+	Vulkan::SetObjectName(
+		VulkanContext.LogicalDevice, CurBuffers.Memory.get(),
+		"VkBlam::Scene: BSP %zu Geometry Device Memory( %s )", GeometryIndex,
+		Common::FormatByteCount(CurRegion.MemorySize).c_str()
+	);
 
-		// Create image handles
-		const auto CreateBitmapImage
-			= [&](VkBlam::BitmapHeapT::Bitmap&                   TargetBitmap,
-				  Blam::Tag<Blam::TagClass::Bitmap>::BitmapEntry BitmapEntry
-			  ) -> bool {
-			vk::ImageCreateInfo ImageInfo = {};
-			ImageInfo.imageType           = VkBlam::BlamToVk(BitmapEntry.Type);
-			ImageInfo.format = VkBlam::BlamToVk(BitmapEntry.Format);
-			ImageInfo.extent = vk::Extent3D(
-				BitmapEntry.Width, BitmapEntry.Height, BitmapEntry.Depth
-			);
-			ImageInfo.mipLevels
-				= std::max<std::uint16_t>(BitmapEntry.MipmapCount, 1);
-			ImageInfo.arrayLayers
-				= BitmapEntry.Type == Blam::BitmapEntryType::CubeMap ? 6 : 1;
-			ImageInfo.samples = vk::SampleCountFlagBits::e1;
-			ImageInfo.tiling  = vk::ImageTiling::eOptimal;
-			ImageInfo.usage   = vk::ImageUsageFlagBits::eSampled
-							| vk::ImageUsageFlagBits::eTransferDst
-							| vk::ImageUsageFlagBits::eTransferSrc;
-			ImageInfo.sharingMode   = vk::SharingMode::eExclusive;
-			ImageInfo.initialLayout = vk::ImageLayout::eUndefined;
+	// Buffers are all now binded to device memory, begin streaming
+	for( const GeometryRegion::VertexSource& CurSource :
+		 CurRegion.VertexSources )
+	{
+		StreamBuffer.QueueBufferUpload(
+			std::as_bytes(CurSource.Vertices), CurBuffers.VertexBuffer.get(),
+			CurSource.VertexOffset * sizeof(Blam::Vertex)
+		);
 
-			if( BitmapEntry.Type == Blam::BitmapEntryType::CubeMap )
-			{
-				ImageInfo.flags = vk::ImageCreateFlagBits::eCubeCompatible;
-			}
+		StreamBuffer.QueueBufferUpload(
+			std::as_bytes(CurSource.LightmapVertices),
+			CurBuffers.LightmapVertexBuffer.get(),
+			CurSource.VertexOffset * sizeof(Blam::LightmapVertex)
+		);
+	}
 
-			auto& ImageDest = TargetBitmap.Image;
+	StreamBuffer.QueueBufferUpload(
+		CurRegion.IndexData, CurBuffers.IndexBuffer.get()
+	);
 
-			if( auto CreateResult
-				= VulkanContext.LogicalDevice.createImageUnique(ImageInfo);
-				CreateResult.result == vk::Result::eSuccess )
-			{
-				ImageDest = std::move(CreateResult.value);
-			}
-			else
-			{
-				std::fprintf(
-					stderr, "Error creating image: %s\n",
-					vk::to_string(CreateResult.result).c_str()
-				);
-				return false;
-			}
-			return true;
-		};
+	if( CurBuffers.PositionBuffer )
+	{
+		StreamBuffer.QueueBufferUpload(
+			std::as_bytes(std::span(CurRegion.Positions)),
+			CurBuffers.PositionBuffer.get()
+		);
+	}
 
-		const auto CreateBitmap
-			= [&](const Blam::TagIndexEntry&               TagEntry,
-				  const Blam::Tag<Blam::TagClass::Bitmap>& Bitmap,
-				  const Blam::MapFile&                     Map) -> void {
-			// std::printf("%s\n",
-			// CurWorld.GetMapFile().GetTagName(TagEntry.TagID).data());
-			for( std::size_t CurSubTextureIdx = 0;
-				 CurSubTextureIdx < Bitmap.Bitmaps.Count; ++CurSubTextureIdx )
-			{
-				const auto& CurSubTexture
-					= Map.TagHeap.GetBlock(Bitmap.Bitmaps)[CurSubTextureIdx];
+	return true;
+}
 
-				auto& BitmapDest
-					= NewScene.BitmapHeap
-						  .Bitmaps[TagEntry.TagID][CurSubTextureIdx];
+bool Scene::UpdateResidency(const SceneView& View)
+{
+	if( !StreamGeometry )
+	{
+		return false;
+	}
 
-				CreateBitmapImage(BitmapDest, CurSubTexture);
+	const Vulkan::Context& VulkanContext = TargetRenderer.GetVulkanContext();
+	Vulkan::StreamBuffer&  StreamBuffer  = TargetRenderer.GetStreamBuffer();
 
-				Vulkan::SetObjectName(
-					VulkanContext.LogicalDevice, BitmapDest.Image.get(),
-					"VkBlam::Scene: Bitmap %08X[%2zu] | %s", TagEntry.TagID,
-					CurSubTextureIdx, Map.GetTagName(TagEntry.TagID).data()
-				);
-			}
-		};
+	++ResidencyFrame;
 
-		Blam::TagVisitorProc& BitmapLoader = TagVisitors.emplace_back();
+	bool Changed = false;
 
-		BitmapLoader.VisitClass = Blam::TagClass::Bitmap;
+	// Free the buffers of evicted regions that the GPU is done with
+	if( auto GetResult = VulkanContext.LogicalDevice.getSemaphoreCounterValue(
+			TargetRenderer.GetUniformRingBuffer().GetSemaphore()
+		);
+		GetResult.result == vk::Result::eSuccess )
+	{
+		std::erase_if(
+			RetiredGeometries,
+			[&](const RetiredGeometry& CurRetired) -> bool {
+				return CurRetired.Tick <= GetResult.value;
+			}
+		);
+	}
 
-		BitmapLoader.VisitTags
-			= [&](std::span<const Blam::TagIndexEntry> TagIndexEntries,
-				  const Blam::MapFile&                 Map) -> void {
-			for( const auto& TagIndexEntry : TagIndexEntries )
+	// Regions whose upload has finished in the background
+	if( auto GetResult = VulkanContext.LogicalDevice.getSemaphoreCounterValue(
+			StreamBuffer.GetSemaphore()
+		);
+		GetResult.result == vk::Result::eSuccess )
+	{
+		for( GeometryRegion& CurRegion : GeometryRegions )
+		{
+			if( CurRegion.Residency == GeometryRegion::State::Loading
+				&& CurRegion.UploadTick <= GetResult.value )
 			{
-				const auto& CurBitmap
-					= Map.GetTag<Blam::TagClass::Bitmap>(TagIndexEntry.TagID);
-				CreateBitmap(TagIndexEntry, *CurBitmap, Map);
+				CurRegion.Residency = GeometryRegion::State::Resident;
+				Changed             = true;
 			}
-		};
+		}
+	}
 
-		BitmapLoader.EndVisits = [&](const Blam::MapFile& Map) -> void {
-			Map.VisitTagClass<Blam::TagClass::Globals>(
-				[&](const Blam::TagIndexEntry&                TagEntry,
-					const Blam::Tag<Blam::TagClass::Globals>& Globals) -> void {
-					const auto& CurGlobal = Globals;
-					for( const auto& RasterData :
-						 TargetWorld.GetMapFile().TagHeap.GetBlock(
-							 CurGlobal.RasterizerData
-						 ) )
-					{
-						NewScene.BitmapHeap.Default2D
-							= RasterData.Default2D.TagID;
-						NewScene.BitmapHeap.Default3D
-							= RasterData.Default3D.TagID;
-						NewScene.BitmapHeap.DefaultCube
-							= RasterData.DefaultCube.TagID;
-					}
-				}
-			);
-		};
+	const glm::f32vec3 ViewPosition
+		= glm::f32vec3(glm::inverse(View.CameraGlobalsData.View)[3]);
 
-		Blam::TagVisitorProc& BitmapCommitter = TagVisitors.emplace_back();
+	// Outside of all BSPs, the BSP that last contained the view stays
+	// requested
+	std::optional<std::uint16_t> ViewCluster = {};
+	for( std::uint32_t BSPIndex = 0; BSPIndex < GeometryRegions.size();
+		 ++BSPIndex )
+	{
+		ViewCluster = TargetWorld.FindCluster(ViewPosition, BSPIndex);
+		if( ViewCluster.has_value() )
+		{
+			ViewBSPIndex = BSPIndex;
+			break;
+		}
+	}
 
-		BitmapCommitter.VisitClass = Blam::TagClass::Bitmap;
+	// The view's BSP along with every BSP that one of its potentially-visible
+	// clusters transitions into
+	std::vector<bool> Requested(GeometryRegions.size(), false);
+	Requested[ViewBSPIndex] = true;
+	if( ViewCluster.has_value() )
+	{
+		const Blam::Tag<Blam::TagClass::Scenario>::StructureBSP& CurSBSP
+			= TargetWorld.GetMapFile().GetScenarioBSPs()[ViewBSPIndex];
+		const Blam::VirtualHeap SBSPHeap
+			= CurSBSP.GetSBSPHeap(TargetWorld.GetMapFile().GetMapData());
+		const Blam::Tag<Blam::TagClass::ScenarioStructureBsp>& SBSP
+			= CurSBSP.GetSBSP(SBSPHeap);
+
+		const std::span<const std::uint32_t> ClusterPVS
+			= Blam::GetClusterPVS(SBSPHeap, SBSP, ViewCluster.value());
+		const auto Clusters = SBSPHeap.GetBlock(SBSP.Clusters);
+		for( std::size_t ClusterIndex = 0; ClusterIndex < Clusters.size();
+			 ++ClusterIndex )
+		{
+			const std::size_t WordIndex = ClusterIndex / 32;
+			if( WordIndex >= ClusterPVS.size()
+				|| !((ClusterPVS[WordIndex] >> (ClusterIndex % 32)) & 1) )
+			{
+				continue;
+			}
 
-		// Allocate and bind memory for all bitmaps
-		BitmapCommitter.BeginVisits = [&](const Blam::MapFile& Map) -> void {
-			std::vector<vk::Image> Bitmaps;
-			for( const auto& CurBitmap : NewScene.BitmapHeap.Bitmaps )
+			const std::uint16_t TransitionBSPIndex
+				= Clusters[ClusterIndex].TransitionStructureBSPIndex;
+			if( TransitionBSPIndex < GeometryRegions.size() )
 			{
-				for( const auto& CurSubBitmap : CurBitmap.second )
+				Requested[TransitionBSPIndex] = true;
+			}
+		}
+	}
+
+	vk::DeviceSize LoadedSize = 0;
+	for( std::size_t GeometryIndex = 0; GeometryIndex < GeometryRegions.size();
+		 ++GeometryIndex )
+	{
+		GeometryRegion& CurRegion = GeometryRegions[GeometryIndex];
+		if( Requested[GeometryIndex] )
+		{
+			CurRegion.LastRequestFrame = ResidencyFrame;
+		}
+		if( CurRegion.Residency != GeometryRegion::State::Evicted )
+		{
+			LoadedSize += CurRegion.MemorySize;
+		}
+	}
+
+	// Evicts the least-recently requested regions until `Size` more bytes
+	// fit into the budget. Requested regions are never evicted, so the
+	// budget may be exceeded by them alone
+	const auto MakeRoom = [&](vk::DeviceSize Size) -> void {
+		while( LoadedSize + Size > Config.BSPMemoryBudget )
+		{
+			GeometryRegion* LeastRecent = nullptr;
+			for( std::size_t GeometryIndex = 0;
+				 GeometryIndex < GeometryRegions.size(); ++GeometryIndex )
+			{
+				GeometryRegion& CurRegion = GeometryRegions[GeometryIndex];
+				if( Requested[GeometryIndex]
+					|| CurRegion.Residency == GeometryRegion::State::Evicted )
 				{
-					Bitmaps.emplace_back(CurSubBitmap.second.Image.get());
+					continue;
+				}
+				if( !LeastRecent
+					|| CurRegion.LastRequestFrame
+						   < LeastRecent->LastRequestFrame )
+				{
+					LeastRecent = &CurRegion;
 				}
 			}
 
-			if( auto [Result, Value] = Vulkan::CommitImageHeap(
-					VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
-					Bitmaps
-				);
-				Result == vk::Result::eSuccess )
+			if( !LeastRecent )
 			{
-				NewScene.BitmapHeapMemory = std::move(Value);
+				return;
 			}
-			else
+
+			// Draws that have already been submitted may still read it
+			RetiredGeometries.push_back(RetiredGeometry{
+				TargetRenderer.GetUniformRingBuffer().GetPendingTick(),
+				std::move(LeastRecent->Buffers)});
+			LeastRecent->Buffers = {};
+
+			if( LeastRecent->Residency == GeometryRegion::State::Resident )
 			{
-				std::fprintf(
-					stderr, "Error committing bitmap memory: %s\n",
-					vk::to_string(Result).c_str()
-				);
-				return;
+				Changed = true;
 			}
-		};
+			LeastRecent->Residency = GeometryRegion::State::Evicted;
+			LoadedSize -= LeastRecent->MemorySize;
+		}
+	};
 
-		// All images are now created and binded to memory
+	// Starts loading a region, returning false if it could not be created
+	const auto Load = [&](std::size_t GeometryIndex) -> bool {
+		GeometryRegion& CurRegion = GeometryRegions[GeometryIndex];
+
+		MakeRoom(CurRegion.MemorySize);
+		if( !LoadGeometry(GeometryIndex) )
 		{
-			// Todo: This would be the draft of a bitmap manager's stream
-			// function
-			const auto StreamBitmapImage =
-				[&](VkBlam::BitmapHeapT::Bitmap&                   TargetBitmap,
-					Blam::Tag<Blam::TagClass::Bitmap>::BitmapEntry BitmapEntry,
-					std::span<const std::byte> PixelData) -> bool {
-				// Upload image data
-				const std::size_t MipCount
-					= std::max<std::uint16_t>(BitmapEntry.MipmapCount, 1);
-				const std::size_t LayerCount
-					= BitmapEntry.Type == Blam::BitmapEntryType::CubeMap ? 6
-																		 : 1;
+			return false;
+		}
 
-				const std::size_t BlockSize
-					= vk::blockSize(VkBlam::BlamToVk(BitmapEntry.Format));
-				const std::array<std::uint8_t, 3> BlockExtent
-					= vk::blockExtent(VkBlam::BlamToVk(BitmapEntry.Format));
+		// Submitted right away so that the upload happens in the background
+		CurRegion.UploadTick = StreamBuffer.Flush();
+		CurRegion.Residency  = GeometryRegion::State::Loading;
+		LoadedSize += CurRegion.MemorySize;
+		return true;
+	};
 
-				std::size_t PixelDataOff = 0;
+	// Nothing may be drawn without the view's own BSP, so it is waited upon
+	GeometryRegion& ViewRegion = GeometryRegions[ViewBSPIndex];
+	if( ViewRegion.Residency == GeometryRegion::State::Evicted
+		&& !Load(ViewBSPIndex) )
+	{
+		return Changed;
+	}
+	if( ViewRegion.Residency == GeometryRegion::State::Loading )
+	{
+		vk::SemaphoreWaitInfo WaitInfo;
+		WaitInfo.semaphoreCount = 1;
+		WaitInfo.pSemaphores    = &StreamBuffer.GetSemaphore();
+		WaitInfo.pValues        = &ViewRegion.UploadTick;
+		if( auto WaitResult
+			= VulkanContext.LogicalDevice.waitSemaphores(WaitInfo, ~0ULL);
+			WaitResult != vk::Result::eSuccess )
+		{
+			std::fprintf(
+				stderr, "Error waiting for BSP %u upload: %s\n", ViewBSPIndex,
+				vk::to_string(WaitResult).c_str()
+			);
+			return Changed;
+		}
+		ViewRegion.Residency = GeometryRegion::State::Resident;
+		Changed              = true;
+	}
+
+	// Only one other region starts loading each frame to spread the cost of
+	// its uploads
+	for( std::size_t GeometryIndex = 0; GeometryIndex < GeometryRegions.size();
+		 ++GeometryIndex )
+	{
+		if( Requested[GeometryIndex]
+			&& GeometryRegions[GeometryIndex].Residency
+				   == GeometryRegion::State::Evicted )
+		{
+			Load(GeometryIndex);
+			break;
+		}
+	}
+
+	return Changed;
+}
+
+void Scene::PrepareRender(
+	const SceneView& View, vk::CommandBuffer CommandBuffer
+)
+{
+	// Scene globals. The recorded draws read them from a fixed buffer, so
+	// they are copied out of the uniform ring-buffer
+	SceneGlobals Globals    = {};
+	Globals.Camera          = View.CameraGlobalsData;
+	Globals.Pass.ScreenSize = glm::f32vec4(
+		View.Viewport.x, View.Viewport.y, 1.0f / View.Viewport.x,
+		1.0f / View.Viewport.y
+	);
+	Globals.Simulation.Time = SimulationTime;
+
+	if( const std::optional<std::uint32_t> GlobalsOffset
+		= TargetRenderer.GetUniformRingBuffer().Push(Globals);
+		GlobalsOffset.has_value() )
+	{
+		// Previous draws must be done reading the globals before they are
+		// overwritten
+		CommandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eVertexShader
+				| vk::PipelineStageFlagBits::eFragmentShader,
+			vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags(), {}, {},
+			{}
+		);
+
+		CommandBuffer.copyBuffer(
+			TargetRenderer.GetUniformRingBuffer().GetBuffer(),
+			SceneGlobalsBuffer.get(),
+			{vk::BufferCopy(GlobalsOffset.value(), 0, sizeof(SceneGlobals))}
+		);
+
+		CommandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eTransfer,
+			vk::PipelineStageFlagBits::eVertexShader
+				| vk::PipelineStageFlagBits::eFragmentShader,
+			vk::DependencyFlags(),
+			{vk::MemoryBarrier(
+				vk::AccessFlagBits::eTransferWrite,
+				vk::AccessFlagBits::eUniformRead
+			)},
+			{}, {}
+		);
+	}
+
+	if( Config.VisibleSurfaceCompaction != SurfaceCompaction::None
+		&& Config.FrustumSurfaceVisibility )
+	{
+		UpdateVisibleSurfaces(View);
+	}
+
+	if( UpdateResidency(View) )
+	{
+		DrawsDirty = true;
+	}
+
+	// Re-record the draws as their pipeline-variants become ready
+	if( std::erase_if(
+			PendingPipelines,
+			[&](std::uint64_t Key) -> bool {
+				return !TargetRenderer.GetPipelineRegistry().IsPending(Key);
+			}
+		) )
+	{
+		DrawsDirty = true;
+	}
+
+	if( SelectLODs(View) )
+	{
+		if( CullPipeline )
+		{
+			if( const std::optional<std::uint32_t> MeshLODsOffset
+				= TargetRenderer.GetUniformRingBuffer().Push(
+					std::as_bytes(std::span(MeshLODs))
+				);
+				MeshLODsOffset.has_value() )
+			{
+				// Previous culling must be done reading the levels before
+				// they are overwritten
+				CommandBuffer.pipelineBarrier(
+					vk::PipelineStageFlagBits::eComputeShader,
+					vk::PipelineStageFlagBits::eTransfer,
+					vk::DependencyFlags(), {}, {}, {}
+				);
+
+				CommandBuffer.copyBuffer(
+					TargetRenderer.GetUniformRingBuffer().GetBuffer(),
+					CullMeshLODBuffer.get(),
+					{vk::BufferCopy(
+						MeshLODsOffset.value(), 0,
+						MeshLODs.size() * sizeof(std::uint32_t)
+					)}
+				);
+
+				CommandBuffer.pipelineBarrier(
+					vk::PipelineStageFlagBits::eTransfer,
+					vk::PipelineStageFlagBits::eComputeShader,
+					vk::DependencyFlags(),
+					{vk::MemoryBarrier(
+						vk::AccessFlagBits::eTransferWrite,
+						vk::AccessFlagBits::eShaderRead
+					)},
+					{}, {}
+				);
+			}
+		}
+		else
+		{
+			DrawsDirty = true;
+		}
+	}
+
+	// The draws of the objects are indirect, so the recorded draws stay valid
+	// as their levels-of-detail change
+	if( !ObjectModels.empty() && HasObjectLODs() && SelectObjectLODs(View) )
+	{
+		std::vector<vk::DrawIndexedIndirectCommand> DrawCommands;
+		std::vector<InstanceTransform>              Transforms;
+		LastRenderStats.ObjectTrianglesSaved
+			= SortObjectInstances(DrawCommands, Transforms);
+
+		Vulkan::UniformRingBuffer& UniformRingBuffer
+			= TargetRenderer.GetUniformRingBuffer();
+		const std::optional<std::uint32_t> DrawCommandsOffset
+			= UniformRingBuffer.Push(std::as_bytes(std::span(DrawCommands)));
+		const std::optional<std::uint32_t> TransformsOffset
+			= UniformRingBuffer.Push(std::as_bytes(std::span(Transforms)));
+
+		if( DrawCommandsOffset.has_value() && TransformsOffset.has_value() )
+		{
+			// Previous draws must be done reading the draw-commands and
+			// transforms before they are overwritten
+			CommandBuffer.pipelineBarrier(
+				vk::PipelineStageFlagBits::eDrawIndirect
+					| vk::PipelineStageFlagBits::eVertexInput,
+				vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags(),
+				{}, {}, {}
+			);
+
+			CommandBuffer.copyBuffer(
+				UniformRingBuffer.GetBuffer(), ObjectDrawCommandBuffer.get(),
+				{vk::BufferCopy(
+					DrawCommandsOffset.value(), 0,
+					DrawCommands.size() * sizeof(vk::DrawIndexedIndirectCommand)
+				)}
+			);
+			CommandBuffer.copyBuffer(
+				UniformRingBuffer.GetBuffer(), ObjectInstanceBuffer.get(),
+				{vk::BufferCopy(
+					TransformsOffset.value(), 0,
+					Transforms.size() * sizeof(InstanceTransform)
+				)}
+			);
+
+			CommandBuffer.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,
+				vk::PipelineStageFlagBits::eDrawIndirect
+					| vk::PipelineStageFlagBits::eVertexInput,
+				vk::DependencyFlags(),
+				{vk::MemoryBarrier(
+					vk::AccessFlagBits::eTransferWrite,
+					vk::AccessFlagBits::eIndirectCommandRead
+						| vk::AccessFlagBits::eVertexAttributeRead
+				)},
+				{}, {}
+			);
+		}
+	}
+
+	// Only the decals of the visible clusters are drawn, and only gathered
+	// again when the visible clusters change
+	if( DecalPipeline && DecalsDirty )
+	{
+		std::vector<DecalInstance> VisibleDecals;
+		GatherVisibleDecals(VisibleDecals);
+
+		const vk::DrawIndirectCommand DrawCommand(
+			6, std::uint32_t(VisibleDecals.size()), 0, 0
+		);
+
+		Vulkan::UniformRingBuffer& UniformRingBuffer
+			= TargetRenderer.GetUniformRingBuffer();
+		const std::optional<std::uint32_t> DrawCommandOffset
+			= UniformRingBuffer.Push(DrawCommand);
+		const std::optional<std::uint32_t> DecalsOffset
+			= UniformRingBuffer.Push(std::as_bytes(std::span(VisibleDecals)));
+
+		if( DrawCommandOffset.has_value() && DecalsOffset.has_value() )
+		{
+			// Previous draws must be done reading the draw-command and
+			// decals before they are overwritten
+			CommandBuffer.pipelineBarrier(
+				vk::PipelineStageFlagBits::eDrawIndirect
+					| vk::PipelineStageFlagBits::eVertexInput,
+				vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags(),
+				{}, {}, {}
+			);
+
+			CommandBuffer.copyBuffer(
+				UniformRingBuffer.GetBuffer(), DecalDrawCommandBuffer.get(),
+				{vk::BufferCopy(
+					DrawCommandOffset.value(), 0,
+					sizeof(vk::DrawIndirectCommand)
+				)}
+			);
+			if( !VisibleDecals.empty() )
+			{
+				CommandBuffer.copyBuffer(
+					UniformRingBuffer.GetBuffer(), DecalInstanceBuffer.get(),
+					{vk::BufferCopy(
+						DecalsOffset.value(), 0,
+						VisibleDecals.size() * sizeof(DecalInstance)
+					)}
+				);
+			}
+
+			CommandBuffer.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,
+				vk::PipelineStageFlagBits::eDrawIndirect
+					| vk::PipelineStageFlagBits::eVertexInput,
+				vk::DependencyFlags(),
+				{vk::MemoryBarrier(
+					vk::AccessFlagBits::eTransferWrite,
+					vk::AccessFlagBits::eIndirectCommandRead
+						| vk::AccessFlagBits::eVertexAttributeRead
+				)},
+				{}, {}
+			);
+
+			DecalsDirty = false;
+		}
+	}
+
+	if( DetailCullPipeline )
+	{
+		Vulkan::DebugLabelScope DetailScope(
+			CommandBuffer, {0.25, 0.75, 0.0, 1.0}, "Cull Detail Objects: %u",
+			DetailObjectCount
+		);
+
+		// Previous draws must be done reading the draw-command and visible
+		// detail-objects before they are overwritten
+		CommandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eDrawIndirect
+				| vk::PipelineStageFlagBits::eVertexShader,
+			vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags(), {},
+			{}, {}
+		);
+
+		CommandBuffer.fillBuffer(
+			DetailObjectDrawCommandBuffer.get(),
+			offsetof(vk::DrawIndirectCommand, instanceCount),
+			sizeof(std::uint32_t), 0
+		);
+
+		CommandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eTransfer,
+			vk::PipelineStageFlagBits::eComputeShader, vk::DependencyFlags(),
+			{vk::MemoryBarrier(
+				vk::AccessFlagBits::eTransferWrite,
+				vk::AccessFlagBits::eShaderRead
+					| vk::AccessFlagBits::eShaderWrite
+			)},
+			{}, {}
+		);
+
+		DispatchDetailObjectCull(View, CommandBuffer);
+	}
+
+	if( Config.VisibleSurfaceCompaction == SurfaceCompaction::GPU
+		&& !DirtyMeshes.empty() )
+	{
+		Vulkan::DebugLabelScope CompactionScope(
+			CommandBuffer, {0.0, 1.0, 1.0, 1.0},
+			"Compact Visible Surfaces: %zu", DirtyMeshes.size()
+		);
+
+		TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+			std::as_bytes(std::span(DirtyMeshes)), DirtyMeshBuffer.get()
+		);
+
+		// Previous draws must be done reading the indices and draw-commands
+		// before they are overwritten
+		CommandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eDrawIndirect
+				| vk::PipelineStageFlagBits::eVertexInput,
+			vk::PipelineStageFlagBits::eComputeShader, vk::DependencyFlags(),
+			{}, {}, {}
+		);
+
+		CommandBuffer.bindPipeline(
+			vk::PipelineBindPoint::eCompute, CompactionPipeline.get()
+		);
+		CommandBuffer.bindDescriptorSets(
+			vk::PipelineBindPoint::eCompute, CompactionPipelineLayout.get(), 0,
+			{CompactionDescriptor}, {}
+		);
+		CommandBuffer.dispatch(DirtyMeshes.size(), 1, 1);
+
+		CommandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eDrawIndirect
+				| vk::PipelineStageFlagBits::eVertexInput,
+			vk::DependencyFlags(),
+			{vk::MemoryBarrier(
+				vk::AccessFlagBits::eShaderWrite,
+				vk::AccessFlagBits::eIndirectCommandRead
+					| vk::AccessFlagBits::eIndexRead
+			)},
+			{}, {}
+		);
+
+		DirtyMeshes.clear();
+	}
+
+	if( CullPipeline )
+	{
+		// Without occlusion-culling the pyramid is only ever created once
+		const glm::uvec2 PyramidSize
+			= HasLatePhase() ? View.Viewport : glm::uvec2(1, 1);
+		if( PyramidSize != DepthPyramidSize
+			&& !CreateDepthPyramid(PyramidSize, CommandBuffer) )
+		{
+			return;
+		}
+
+		Vulkan::DebugLabelScope CullScope(
+			CommandBuffer, {0.0, 1.0, 0.5, 1.0}, "Cull Draws: %u",
+			CullItemCount
+		);
+
+		// Previous draws must be done reading the draw-commands and counts
+		// before they are overwritten, and the visibility written by the
+		// previous late phase must be visible to this one
+		CommandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eDrawIndirect
+				| vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eTransfer
+				| vk::PipelineStageFlagBits::eComputeShader,
+			vk::DependencyFlags(),
+			{vk::MemoryBarrier(
+				vk::AccessFlagBits::eShaderWrite,
+				vk::AccessFlagBits::eShaderRead
+			)},
+			{}, {}
+		);
+
+		CommandBuffer.fillBuffer(CullCountBuffer.get(), 0, VK_WHOLE_SIZE, 0);
+
+		CommandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eTransfer,
+			vk::PipelineStageFlagBits::eComputeShader, vk::DependencyFlags(),
+			{vk::MemoryBarrier(
+				vk::AccessFlagBits::eTransferWrite,
+				vk::AccessFlagBits::eShaderRead
+					| vk::AccessFlagBits::eShaderWrite
+			)},
+			{}, {}
+		);
+
+		DispatchCull(
+			View, CommandBuffer,
+			HasLatePhase() ? CullPhase::Early : CullPhase::All
+		);
+	}
+}
+
+void Scene::DispatchCull(
+	const SceneView& View, vk::CommandBuffer CommandBuffer, CullPhase Phase
+)
+{
+	CullGlobals CurCullGlobals = {};
+	CurCullGlobals.FrustumPlanes
+		= GetFrustumPlanes(View.CameraGlobalsData.ViewProjection);
+	CurCullGlobals.ViewProjection = View.CameraGlobalsData.ViewProjection;
+	CurCullGlobals.ItemCount      = CullItemCount;
+	CurCullGlobals.GroupCount     = CullGroups.size();
+	CurCullGlobals.Phase          = std::uint32_t(Phase);
+
+	const std::optional<std::uint32_t> CullGlobalsOffset
+		= TargetRenderer.GetUniformRingBuffer().Push(CurCullGlobals);
+	if( !CullGlobalsOffset.has_value() )
+	{
+		return;
+	}
+
+	CommandBuffer.bindPipeline(
+		vk::PipelineBindPoint::eCompute, CullPipeline.get()
+	);
+	CommandBuffer.bindDescriptorSets(
+		vk::PipelineBindPoint::eCompute, CullPipelineLayout.get(), 0,
+		{CullDescriptor}, {CullGlobalsOffset.value()}
+	);
+	CommandBuffer.dispatch((CullItemCount + 63) / 64, 1, 1);
+
+	CommandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eComputeShader,
+		vk::PipelineStageFlagBits::eDrawIndirect, vk::DependencyFlags(),
+		{vk::MemoryBarrier(
+			vk::AccessFlagBits::eShaderWrite,
+			vk::AccessFlagBits::eIndirectCommandRead
+		)},
+		{}, {}
+	);
+}
+
+void Scene::DispatchDetailObjectCull(
+	const SceneView& View, vk::CommandBuffer CommandBuffer
+)
+{
+	const CameraGlobals& Camera = View.CameraGlobalsData;
+
+	DetailGlobals CurDetailGlobals = {};
+	CurDetailGlobals.FrustumPlanes = GetFrustumPlanes(Camera.ViewProjection);
+	CurDetailGlobals.ViewPosition
+		= glm::f32vec3(glm::inverse(Camera.View)[3]);
+	CurDetailGlobals.MaxDistance   = Config.DetailObjectDistance;
+	CurDetailGlobals.InstanceCount = DetailObjectCount;
+
+	const std::optional<std::uint32_t> DetailGlobalsOffset
+		= TargetRenderer.GetUniformRingBuffer().Push(CurDetailGlobals);
+	if( !DetailGlobalsOffset.has_value() )
+	{
+		return;
+	}
+
+	CommandBuffer.bindPipeline(
+		vk::PipelineBindPoint::eCompute, DetailCullPipeline.get()
+	);
+	CommandBuffer.bindDescriptorSets(
+		vk::PipelineBindPoint::eCompute, DetailCullPipelineLayout.get(), 0,
+		{DetailCullDescriptor}, {DetailGlobalsOffset.value()}
+	);
+	CommandBuffer.dispatch((DetailObjectCount + 63) / 64, 1, 1);
+
+	CommandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eComputeShader,
+		vk::PipelineStageFlagBits::eDrawIndirect
+			| vk::PipelineStageFlagBits::eVertexShader,
+		vk::DependencyFlags(),
+		{vk::MemoryBarrier(
+			vk::AccessFlagBits::eShaderWrite,
+			vk::AccessFlagBits::eIndirectCommandRead
+				| vk::AccessFlagBits::eShaderRead
+		)},
+		{}, {}
+	);
+}
+
+bool Scene::CreateDepthPyramid(
+	glm::uvec2 Size, vk::CommandBuffer CommandBuffer
+)
+{
+	const Vulkan::Context& VulkanContext = TargetRenderer.GetVulkanContext();
+
+	// Each level is half of the previous, rounded down
+	const std::uint32_t LevelCount = std::min<std::uint32_t>(
+		std::bit_width(std::max(Size.x, Size.y)), MaxDepthPyramidLevels
+	);
+
+	DepthPyramidLevelViews.clear();
+	DepthPyramidView.reset();
+	DepthPyramidImage.reset();
+	DepthPyramidMemory.reset();
+	DepthPyramidSize = {};
+
+	vk::ImageCreateInfo ImageInfo = {};
+	ImageInfo.imageType           = vk::ImageType::e2D;
+	ImageInfo.format              = vk::Format::eR32Sfloat;
+	ImageInfo.extent              = vk::Extent3D(Size.x, Size.y, 1);
+	ImageInfo.mipLevels           = LevelCount;
+	ImageInfo.arrayLayers         = 1;
+	ImageInfo.samples             = vk::SampleCountFlagBits::e1;
+	ImageInfo.tiling              = vk::ImageTiling::eOptimal;
+	ImageInfo.usage               = vk::ImageUsageFlagBits::eStorage
+					| vk::ImageUsageFlagBits::eSampled
+					| vk::ImageUsageFlagBits::eTransferDst;
+	ImageInfo.sharingMode         = vk::SharingMode::eExclusive;
+	ImageInfo.initialLayout       = vk::ImageLayout::eUndefined;
+
+	if( auto CreateResult
+		= VulkanContext.LogicalDevice.createImageUnique(ImageInfo);
+		CreateResult.result == vk::Result::eSuccess )
+	{
+		DepthPyramidImage = std::move(CreateResult.value);
+	}
+	else
+	{
+		std::fprintf(
+			stderr, "Error creating depth pyramid: %s\n",
+			vk::to_string(CreateResult.result).c_str()
+		);
+		return false;
+	}
+	Vulkan::SetObjectName(
+		VulkanContext.LogicalDevice, DepthPyramidImage.get(),
+		"VkBlam::Scene: Depth Pyramid( %u x %u )", Size.x, Size.y
+	);
+
+	if( auto [Result, Value] = Vulkan::CommitImageHeap(
+			VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
+			std::array{DepthPyramidImage.get()}
+		);
+		Result == vk::Result::eSuccess )
+	{
+		DepthPyramidMemory = std::move(Value);
+	}
+	else
+	{
+		std::fprintf(
+			stderr, "Error committing depth pyramid memory: %s\n",
+			vk::to_string(Result).c_str()
+		);
+		return false;
+	}
+
+	// The whole pyramid is sampled by the culling-shader, while each level
+	// is written to on its own
+	const auto CreateView
+		= [&](std::uint32_t BaseLevel,
+			  std::uint32_t LevelViewCount) -> vk::UniqueImageView {
+		vk::ImageViewCreateInfo ViewInfo = {};
+		ViewInfo.image                   = DepthPyramidImage.get();
+		ViewInfo.viewType                = vk::ImageViewType::e2D;
+		ViewInfo.format                  = ImageInfo.format;
+		ViewInfo.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+		ViewInfo.subresourceRange.baseMipLevel   = BaseLevel;
+		ViewInfo.subresourceRange.levelCount     = LevelViewCount;
+		ViewInfo.subresourceRange.baseArrayLayer = 0;
+		ViewInfo.subresourceRange.layerCount     = 1;
+
+		if( auto CreateResult
+			= VulkanContext.LogicalDevice.createImageViewUnique(ViewInfo);
+			CreateResult.result == vk::Result::eSuccess )
+		{
+			return std::move(CreateResult.value);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error creating depth pyramid view: %s\n",
+				vk::to_string(CreateResult.result).c_str()
+			);
+			return {};
+		}
+	};
+
+	DepthPyramidView = CreateView(0, LevelCount);
+	if( !DepthPyramidView )
+	{
+		return false;
+	}
+
+	Vulkan::DescriptorUpdateBatch& DescriptorUpdateBatch
+		= TargetRenderer.GetDescriptorUpdateBatch();
+
+	// Level-views are only needed to build the pyramid
+	if( HasLatePhase() )
+	{
+		for( std::uint32_t Level = 0; Level < LevelCount; ++Level )
+		{
+			vk::UniqueImageView& CurLevelView
+				= DepthPyramidLevelViews.emplace_back(CreateView(Level, 1));
+			if( !CurLevelView )
+			{
+				return false;
+			}
+
+			DescriptorUpdateBatch.AddImage(
+				DepthPyramidDescriptors[Level], 2, CurLevelView.get()
+			);
+			if( Level > 0 )
+			{
+				DescriptorUpdateBatch.AddImage(
+					DepthPyramidDescriptors[Level], 1,
+					DepthPyramidLevelViews[Level - 1].get()
+				);
+			}
+		}
+	}
+
+	DescriptorUpdateBatch.AddImageSampler(
+		CullDescriptor, 5, DepthPyramidView.get(),
+		TargetRenderer.GetSamplerCache().GetSampler(DepthPyramidSampler()),
+		vk::ImageLayout::eGeneral
+	);
+	DescriptorUpdateBatch.Flush();
+
+	// Nothing is occluded until the pyramid is first built
+	CommandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTopOfPipe,
+		vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlags(), {}, {},
+		{vk::ImageMemoryBarrier(
+			vk::AccessFlags(), vk::AccessFlagBits::eTransferWrite,
+			vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			DepthPyramidImage.get(),
+			vk::ImageSubresourceRange(
+				vk::ImageAspectFlagBits::eColor, 0, VK_REMAINING_MIP_LEVELS,
+				0, 1
+			)
+		)}
+	);
+
+	CommandBuffer.clearColorImage(
+		DepthPyramidImage.get(), vk::ImageLayout::eGeneral,
+		vk::ClearColorValue(std::array<float, 4>{1.0f, 1.0f, 1.0f, 1.0f}),
+		{vk::ImageSubresourceRange(
+			vk::ImageAspectFlagBits::eColor, 0, VK_REMAINING_MIP_LEVELS, 0, 1
+		)}
+	);
+
+	CommandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTransfer,
+		vk::PipelineStageFlagBits::eComputeShader, vk::DependencyFlags(),
+		{vk::MemoryBarrier(
+			vk::AccessFlagBits::eTransferWrite,
+			vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite
+		)},
+		{}, {}
+	);
+
+	DepthPyramidSize = Size;
+	return true;
+}
+
+void Scene::Render(const SceneView& View, vk::CommandBuffer CommandBuffer)
+{
+	if( (DrawsDirty || View.Viewport != RecordedViewport)
+		&& RecordDrawStream(View) )
+	{
+		RecordedViewport = View.Viewport;
+		DrawsDirty       = false;
+	}
+
+	if( !RecordedCommandBuffers[0].empty() )
+	{
+		CommandBuffer.executeCommands(RecordedCommandBuffers[0]);
+		ExecutedTick = TargetRenderer.GetUniformRingBuffer().GetPendingTick();
+	}
+
+	// Counted as the recorded draws are executed, so that the stats describe
+	// a single frame no matter how often the draws are re-recorded.
+	// `ObjectTrianglesSaved` is only updated by `PrepareRender`
+	const std::uint32_t ObjectTrianglesSaved
+		= LastRenderStats.ObjectTrianglesSaved;
+	LastRenderStats                      = RecordedStats[0];
+	LastRenderStats.ObjectTrianglesSaved = ObjectTrianglesSaved;
+}
+
+void Scene::PrepareLateRender(
+	const SceneView& View, vk::CommandBuffer CommandBuffer,
+	vk::Image DepthImage, vk::ImageView DepthImageView
+)
+{
+	if( !HasLatePhase() )
+	{
+		return;
+	}
+
+	Vulkan::DescriptorUpdateBatch& DescriptorUpdateBatch
+		= TargetRenderer.GetDescriptorUpdateBatch();
+
+	if( DepthImageView != DepthPyramidSource )
+	{
+		DescriptorUpdateBatch.AddImageSampler(
+			DepthPyramidDescriptors[0], 0, DepthImageView,
+			TargetRenderer.GetSamplerCache().GetSampler(DepthPyramidSampler()),
+			vk::ImageLayout::eDepthStencilReadOnlyOptimal
+		);
+		DescriptorUpdateBatch.Flush();
+		DepthPyramidSource = DepthImageView;
+	}
+
+	const vk::ImageSubresourceRange DepthRange(
+		vk::ImageAspectFlagBits::eDepth, 0, 1, 0, 1
+	);
+
+	{
+		Vulkan::DebugLabelScope PyramidScope(
+			CommandBuffer, {0.5, 0.5, 1.0, 1.0}, "Build Depth Pyramid: %u x %u",
+			DepthPyramidSize.x, DepthPyramidSize.y
+		);
+
+		// The early draws must be done writing depth, and the previous late
+		// phase must be done reading the pyramid before it is overwritten
+		CommandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eEarlyFragmentTests
+				| vk::PipelineStageFlagBits::eLateFragmentTests
+				| vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eComputeShader, vk::DependencyFlags(),
+			{}, {},
+			{vk::ImageMemoryBarrier(
+				vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+				vk::AccessFlagBits::eShaderRead,
+				vk::ImageLayout::eDepthStencilAttachmentOptimal,
+				vk::ImageLayout::eDepthStencilReadOnlyOptimal,
+				VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, DepthImage,
+				DepthRange
+			)}
+		);
+
+		for( std::uint32_t Level = 0; Level < DepthPyramidLevelViews.size();
+			 ++Level )
+		{
+			const glm::uvec2 LevelSize
+				= glm::max(DepthPyramidSize >> Level, glm::uvec2(1, 1));
+
+			if( Level == 0 )
+			{
+				CommandBuffer.bindPipeline(
+					vk::PipelineBindPoint::eCompute,
+					DepthPyramidBasePipeline.get()
+				);
+				CommandBuffer.bindDescriptorSets(
+					vk::PipelineBindPoint::eCompute,
+					DepthPyramidBasePipelineLayout.get(), 0,
+					{DepthPyramidDescriptors[Level]}, {}
+				);
+			}
+			else
+			{
+				// Each level reads all writes of the previous level
+				CommandBuffer.pipelineBarrier(
+					vk::PipelineStageFlagBits::eComputeShader,
+					vk::PipelineStageFlagBits::eComputeShader,
+					vk::DependencyFlags(),
+					{vk::MemoryBarrier(
+						vk::AccessFlagBits::eShaderWrite,
+						vk::AccessFlagBits::eShaderRead
+					)},
+					{}, {}
+				);
+
+				if( Level == 1 )
+				{
+					CommandBuffer.bindPipeline(
+						vk::PipelineBindPoint::eCompute,
+						DepthPyramidReducePipeline.get()
+					);
+				}
+				CommandBuffer.bindDescriptorSets(
+					vk::PipelineBindPoint::eCompute,
+					DepthPyramidReducePipelineLayout.get(), 0,
+					{DepthPyramidDescriptors[Level]}, {}
+				);
+			}
+
+			CommandBuffer.dispatch(
+				(LevelSize.x + 7) / 8, (LevelSize.y + 7) / 8, 1
+			);
+		}
+
+		// The pyramid is read by the late phase, and the depth-attachment is
+		// loaded by the render pass of `RenderLate`
+		CommandBuffer.pipelineBarrier(
+			vk::PipelineStageFlagBits::eComputeShader,
+			vk::PipelineStageFlagBits::eComputeShader
+				| vk::PipelineStageFlagBits::eEarlyFragmentTests
+				| vk::PipelineStageFlagBits::eLateFragmentTests,
+			vk::DependencyFlags(),
+			{vk::MemoryBarrier(
+				vk::AccessFlagBits::eShaderWrite,
+				vk::AccessFlagBits::eShaderRead
+			)},
+			{},
+			{vk::ImageMemoryBarrier(
+				vk::AccessFlagBits::eShaderRead,
+				vk::AccessFlagBits::eDepthStencilAttachmentRead
+					| vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+				vk::ImageLayout::eDepthStencilReadOnlyOptimal,
+				vk::ImageLayout::eDepthStencilAttachmentOptimal,
+				VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, DepthImage,
+				DepthRange
+			)}
+		);
+	}
+
+	Vulkan::DebugLabelScope CullScope(
+		CommandBuffer, {0.0, 1.0, 0.5, 1.0}, "Cull Late Draws: %u",
+		CullItemCount
+	);
+
+	DispatchCull(View, CommandBuffer, CullPhase::Late);
+}
+
+void Scene::RenderLate(
+	const SceneView& View, vk::CommandBuffer CommandBuffer
+)
+{
+	if( !RecordedCommandBuffers[1].empty() )
+	{
+		CommandBuffer.executeCommands(RecordedCommandBuffers[1]);
+		ExecutedTick = TargetRenderer.GetUniformRingBuffer().GetPendingTick();
+	}
+
+	LastRenderStats.Draws += RecordedStats[1].Draws;
+	LastRenderStats.Binds += RecordedStats[1].Binds;
+	LastRenderStats.StateChanges += RecordedStats[1].StateChanges;
+	LastRenderStats.DepthPrepassDraws += RecordedStats[1].DepthPrepassDraws;
+}
+
+bool Scene::RecordDrawStream(const SceneView& View)
+{
+	Vulkan::UniformRingBuffer& UniformRingBuffer
+		= TargetRenderer.GetUniformRingBuffer();
+
+	// The frame that is currently being recorded has already executed the
+	// draws, and is only signaled once it is submitted, so waiting on it
+	// would never return
+	if( ExecutedTick == UniformRingBuffer.GetPendingTick() )
+	{
+		std::fprintf(
+			stderr, "Error re-recording draws: already executed by the "
+					"current frame\n"
+		);
+		return false;
+	}
+
+	// Resetting the command-pools invalidates the command-buffers of any
+	// earlier frame that is still executing them
+	if( ExecutedTick != 0 )
+	{
+		vk::SemaphoreWaitInfo WaitInfo;
+		WaitInfo.semaphoreCount = 1;
+		WaitInfo.pSemaphores    = &UniformRingBuffer.GetSemaphore();
+		WaitInfo.pValues        = &ExecutedTick;
+		if( auto WaitResult
+			= TargetRenderer.GetVulkanContext().LogicalDevice.waitSemaphores(
+				WaitInfo, ~0ULL
+			);
+			WaitResult != vk::Result::eSuccess )
+		{
+			std::fprintf(
+				stderr, "Error waiting for recorded draws: %s\n",
+				vk::to_string(WaitResult).c_str()
+			);
+			return false;
+		}
+	}
+
+	// Sort each run of draws that share the same state front-to-back from
+	// the view that the draws are recorded with. The order of GPU-culled
+	// draws is decided by the culling-shader
+	if( !CullPipeline )
+	{
+		const glm::f32vec3 ViewPosition
+			= glm::f32vec3(glm::inverse(View.CameraGlobalsData.View)[3]);
+
+		for( DrawItem& CurDraw : DrawList )
+		{
+			CurDraw.ViewDistance = glm::distance(
+				ViewPosition, LightmapMeshs[CurDraw.MeshIndex].Centroid
+			);
+		}
+
+		for( auto StateBegin = DrawList.begin();
+			 StateBegin != DrawList.end(); )
+		{
+			const auto StateEnd = std::find_if(
+				StateBegin, DrawList.end(),
+				[&](const DrawItem& CurDraw) -> bool {
+					return CurDraw.GetStateKey() != StateBegin->GetStateKey();
+				}
+			);
+			std::sort(
+				StateBegin, StateEnd,
+				[](const DrawItem& A, const DrawItem& B) -> bool {
+					return A.ViewDistance < B.ViewDistance;
+				}
+			);
+			StateBegin = StateEnd;
+		}
+	}
+
+	// Either each group of GPU-culled draws or each draw-item is recorded
+	const std::size_t DrawCount
+		= CullPipeline ? CullGroups.size() : DrawList.size();
+
+	// Split the draws evenly across the recording-threads, each recording
+	// into the secondary command-buffer of its own command-pool
+	const std::size_t DrawsPerThread = std::max<std::size_t>(
+		(DrawCount + RecordingContexts.size() - 1) / RecordingContexts.size(),
+		1
+	);
+
+	vk::CommandBufferInheritanceInfo InheritanceInfo = {};
+	InheritanceInfo.renderPass
+		= TargetRenderer.GetDefaultRenderPass(RenderSamples);
+	InheritanceInfo.subpass = 0;
+	InheritanceInfo.pipelineStatistics = Config.InheritedPipelineStatistics;
+
+	vk::CommandBufferBeginInfo BeginInfo = {};
+	// The draws are re-used across frames that may still be in flight. They
+	// are only re-recorded once all of those frames have completed
+	BeginInfo.flags = vk::CommandBufferUsageFlagBits::eSimultaneousUse
+					| vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+	BeginInfo.pInheritanceInfo = &InheritanceInfo;
+
+	// Indexed by render-phase, then by whether the stream is depth-only
+	using StreamStats
+		= std::array<std::array<RenderStats, 2>, RenderPhaseCount>;
+	std::vector<StreamStats> ThreadStats(RecordingContexts.size());
+	std::vector<vk::Result>  ThreadResults(RecordingContexts.size());
+
+	const auto ThreadProc = [&](std::size_t ThreadIndex) -> void {
+		const RecordingContext& CurContext = RecordingContexts[ThreadIndex];
+
+		const std::size_t DrawBegin
+			= std::min(ThreadIndex * DrawsPerThread, DrawCount);
+		const std::size_t DrawEnd
+			= std::min(DrawBegin + DrawsPerThread, DrawCount);
+
+		if( auto ResetResult
+			= TargetRenderer.GetVulkanContext().LogicalDevice.resetCommandPool(
+				CurContext.CommandPool.get()
+			);
+			ResetResult != vk::Result::eSuccess )
+		{
+			ThreadResults[ThreadIndex] = ResetResult;
+			return;
+		}
+
+		for( std::size_t Phase = 0; Phase < RenderPhaseCount; ++Phase )
+		{
+			for( const bool DepthOnly : {false, true} )
+			{
+				const vk::CommandBuffer CurCommandBuffer
+					= DepthOnly ? CurContext.DepthCommandBuffers[Phase].get()
+								: CurContext.CommandBuffers[Phase].get();
+
+				// Not allocated
+				if( !CurCommandBuffer )
+				{
+					continue;
+				}
+
+				if( auto BeginResult = CurCommandBuffer.begin(BeginInfo);
+					BeginResult != vk::Result::eSuccess )
+				{
+					ThreadResults[ThreadIndex] = BeginResult;
+					return;
+				}
+
+				RenderStats& CurStats
+					= ThreadStats[ThreadIndex][Phase][DepthOnly];
+
+				RecordDraws(
+					View, CurCommandBuffer, DrawBegin, DrawEnd, DepthOnly,
+					Phase == 1, CurStats
+				);
+
+				// Objects, decals, and detail-objects are drawn after the
+				// BSP by the first thread
+				if( ThreadIndex == 0 && Phase == 0 && !DepthOnly )
+				{
+					RecordObjectDraws(CurCommandBuffer, CurStats);
+					RecordDecalDraws(CurCommandBuffer, CurStats);
+					RecordDetailObjectDraws(CurCommandBuffer, CurStats);
+				}
+
+				if( auto EndResult = CurCommandBuffer.end();
+					EndResult != vk::Result::eSuccess )
+				{
+					ThreadResults[ThreadIndex] = EndResult;
+					return;
+				}
+			}
+		}
+	};
+
+	// Each range is recorded exactly once, so each recording-context is only
+	// ever used by a single thread at a time
+	RecordingWorkers->ParallelFor(RecordingContexts.size(), ThreadProc);
+
+	// Each phase executes the streams of all threads. The state of the
+	// depth pre-pass never changes, so only its draws are counted
+	RecordedStats = {};
+	for( std::size_t ThreadIndex = 0; ThreadIndex < RecordingContexts.size();
+		 ++ThreadIndex )
+	{
+		if( ThreadResults[ThreadIndex] != vk::Result::eSuccess )
+		{
+			std::fprintf(
+				stderr, "Error recording secondary command buffer: %s\n",
+				vk::to_string(ThreadResults[ThreadIndex]).c_str()
+			);
+			continue;
+		}
+
+		for( std::size_t Phase = 0; Phase < RenderPhaseCount; ++Phase )
+		{
+			const RenderStats& ShadeStats = ThreadStats[ThreadIndex][Phase][0];
+			const RenderStats& DepthStats = ThreadStats[ThreadIndex][Phase][1];
+
+			RenderStats& CurStats = RecordedStats[Phase];
+			CurStats.Draws += ShadeStats.Draws;
+			CurStats.Binds += ShadeStats.Binds;
+			CurStats.StateChanges += ShadeStats.StateChanges;
+			CurStats.DepthPrepassDraws += DepthStats.Draws;
+		}
+	}
+
+	for( std::size_t Phase = 0; Phase < RenderPhaseCount; ++Phase )
+	{
+		std::vector<vk::CommandBuffer>& CurRecordedCommandBuffers
+			= RecordedCommandBuffers[Phase];
+		CurRecordedCommandBuffers.clear();
+
+		// All of the depth pre-pass of a phase is executed before any of its
+		// shading
+		for( const bool DepthOnly : {true, false} )
+		{
+			for( std::size_t ThreadIndex = 0;
+				 ThreadIndex < RecordingContexts.size(); ++ThreadIndex )
+			{
+				const RecordingContext& CurContext
+					= RecordingContexts[ThreadIndex];
+				const vk::CommandBuffer CurCommandBuffer
+					= DepthOnly ? CurContext.DepthCommandBuffers[Phase].get()
+								: CurContext.CommandBuffers[Phase].get();
+
+				if( CurCommandBuffer
+					&& ThreadResults[ThreadIndex] == vk::Result::eSuccess )
+				{
+					CurRecordedCommandBuffers.push_back(CurCommandBuffer);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+void Scene::RecordDraws(
+	const SceneView& View, vk::CommandBuffer CommandBuffer,
+	std::size_t DrawBegin, std::size_t DrawEnd, bool DepthOnly, bool Late,
+	RenderStats& Stats
+) const
+{
+	vk::Viewport Viewport = {};
+	Viewport.width        = float(View.Viewport.x);
+	Viewport.height       = -float(View.Viewport.y);
+	Viewport.x            = 0.0f;
+	Viewport.y            = float(View.Viewport.y);
+	Viewport.minDepth     = 0.0f;
+	Viewport.maxDepth     = 1.0f;
+	CommandBuffer.setViewport(0, {Viewport});
+	// Scissor
+	vk::Rect2D Scissor    = {};
+	Scissor.extent.width  = View.Viewport.x;
+	Scissor.extent.height = View.Viewport.y;
+	CommandBuffer.setScissor(0, {Scissor});
+
+	// Nothing to draw
+	if( DrawBegin == DrawEnd )
+	{
+		return;
+	}
+
+	vk::PipelineLayout DrawPipelineLayout
+		= Config.BindlessTextures ? BindlessDrawPipelineLayout.get()
+								  : DebugDrawPipelineLayout.get();
+	if( DepthOnly )
+	{
+		DrawPipelineLayout = DepthPrepassPipelineLayout.get();
+	}
+
+	// Bing Scene globals
+	CommandBuffer.bindDescriptorSets(
+		vk::PipelineBindPoint::eGraphics, DrawPipelineLayout, 0,
+		{CurSceneDescriptor}, {}
+	);
+	++Stats.Binds;
+
+	// Bind all bitmaps and materials
+	if( Config.BindlessTextures && !DepthOnly )
+	{
+		CommandBuffer.bindDescriptorSets(
+			vk::PipelineBindPoint::eGraphics, DrawPipelineLayout, 1,
+			{BindlessDescriptor}, {}
+		);
+		++Stats.Binds;
+	}
+
+	// All draws of the depth pre-pass share the same state
+	if( DepthOnly )
+	{
+		CommandBuffer.bindPipeline(
+			vk::PipelineBindPoint::eGraphics, DepthPrepassPipeline.get()
+		);
+		++Stats.Binds;
+		++Stats.StateChanges;
+	}
+
+	// Compaction draws all regions from its own index-buffer
+	switch( Config.VisibleSurfaceCompaction )
+	{
+	case SurfaceCompaction::None:
+	{
+		break;
+	}
+	case SurfaceCompaction::CPU:
+	{
+		CommandBuffer.bindIndexBuffer(
+			VisibleIndexBuffer.get(), 0, vk::IndexType::eUint16
+		);
+		break;
+	}
+	case SurfaceCompaction::GPU:
+	{
+		CommandBuffer.bindIndexBuffer(
+			VisibleIndexBuffer.get(), 0, vk::IndexType::eUint32
+		);
+		break;
+	}
+	}
+
+	// Binds the vertex-buffers, and without compaction the index-buffer, of
+	// a draw's geometry-region. Returns false if the region is not resident
+	std::optional<std::uint32_t> BoundGeometry = {};
+	const auto BindGeometry = [&](const DrawItem& CurDraw) -> bool {
+		const GeometryRegion& CurRegion
+			= GeometryRegions[CurDraw.GeometryIndex];
+		if( CurRegion.Residency != GeometryRegion::State::Resident )
+		{
+			return false;
+		}
+
+		if( CurDraw.GeometryIndex == BoundGeometry )
+		{
+			return true;
+		}
+
+		const GeometryBuffers& CurBuffers = CurRegion.Buffers;
+		if( DepthOnly )
+		{
+			CommandBuffer.bindVertexBuffers(
+				0, {CurBuffers.PositionBuffer.get()}, {0}
+			);
+		}
+		else
+		{
+			CommandBuffer.bindVertexBuffers(
+				0,
+				{CurBuffers.VertexBuffer.get(),
+				 CurBuffers.LightmapVertexBuffer.get()},
+				{0, 0}
+			);
+		}
+
+		if( Config.VisibleSurfaceCompaction == SurfaceCompaction::None )
+		{
+			CommandBuffer.bindIndexBuffer(
+				CurBuffers.IndexBuffer.get(), 0, BSPIndexType
+			);
+		}
+
+		BoundGeometry = CurDraw.GeometryIndex;
+		return true;
+	};
+
+	// The mesh-index is passed as `firstInstance` to index bindless materials
+	const auto DrawIndexed
+		= [&](std::uint32_t IndexCount, std::uint32_t FirstIndex,
+			  std::uint32_t VertexOffset, std::uint32_t MeshIndex) -> void {
+		CommandBuffer.drawIndexed(
+			IndexCount, 1, FirstIndex, VertexOffset, MeshIndex
+		);
+		++Stats.Draws;
+	};
+
+	// Currently bound state
+	vk::Pipeline      BoundPipeline    = {};
+	vk::DescriptorSet BoundShaderSet   = {};
+	vk::DescriptorSet BoundLightmapSet = {};
+
+	// Binds only the state of a draw that differs from the bound state
+	const auto BindDrawState = [&](const DrawItem& CurDraw) -> void {
+		if( DepthOnly )
+		{
+			return;
+		}
+
+		bool StateChanged = false;
+
+		// Specialized variants are only drawn with once they have compiled
+		vk::Pipeline DrawPipeline = CurDraw.Pipeline;
+		if( CurDraw.VariantKey )
+		{
+			if( const vk::Pipeline Variant
+				= TargetRenderer.GetPipelineRegistry().FindPipeline(
+					CurDraw.VariantKey
+				) )
+			{
+				DrawPipeline = Variant;
+			}
+		}
+
+		if( DrawPipeline != BoundPipeline )
+		{
+			CommandBuffer.bindPipeline(
+				vk::PipelineBindPoint::eGraphics, DrawPipeline
+			);
+			BoundPipeline = DrawPipeline;
+			++Stats.Binds;
+			StateChanged = true;
+		}
+
+		// Bind Shader descriptors
+		if( CurDraw.ShaderSet && CurDraw.ShaderSet != BoundShaderSet )
+		{
+			CommandBuffer.bindDescriptorSets(
+				vk::PipelineBindPoint::eGraphics, DrawPipelineLayout, 1,
+				{CurDraw.ShaderSet}, {}
+			);
+			BoundShaderSet = CurDraw.ShaderSet;
+			++Stats.Binds;
+			StateChanged = true;
+		}
+
+		// Bind Mesh descriptors
+		if( CurDraw.LightmapSet != BoundLightmapSet )
+		{
+			CommandBuffer.bindDescriptorSets(
+				vk::PipelineBindPoint::eGraphics, DrawPipelineLayout, 2,
+				{CurDraw.LightmapSet}, {}
+			);
+			BoundLightmapSet = CurDraw.LightmapSet;
+			++Stats.Binds;
+			StateChanged = true;
+		}
+
+		if( StateChanged )
+		{
+			++Stats.StateChanges;
+		}
+	};
+
+	// Draws of the same state were culled into their own range of
+	// draw-commands by `PrepareRender`
+	if( CullPipeline )
+	{
+		// The draw-commands and counts of the late phase follow all of those
+		// of the early phase
+		const std::size_t CommandOffset = Late ? CullItemCount : 0;
+		const std::size_t CountOffset   = Late ? CullGroups.size() : 0;
+
+		for( std::size_t GroupIndex = DrawBegin; GroupIndex < DrawEnd;
+			 ++GroupIndex )
+		{
+			const CullGroup& CurCullGroup = CullGroups[GroupIndex];
+			const DrawItem&  CurDraw
+				= DrawList[CurCullGroup.DrawItemIndex];
+
+			if( DepthOnly && LightmapMeshs[CurDraw.MeshIndex].AlphaTested )
+			{
+				continue;
+			}
+
+			if( !BindGeometry(CurDraw) )
+			{
+				continue;
+			}
+
+			BindDrawState(CurDraw);
+
+			CommandBuffer.drawIndexedIndirectCount(
+				CullCommandBuffer.get(),
+				(CommandOffset + CurCullGroup.CommandStart)
+					* sizeof(vk::DrawIndexedIndirectCommand),
+				CullCountBuffer.get(),
+				(CountOffset + GroupIndex) * sizeof(std::uint32_t),
+				CurCullGroup.CommandCount,
+				sizeof(vk::DrawIndexedIndirectCommand)
+			);
+			++Stats.Draws;
+		}
+
+		return;
+	}
+
+	for( const DrawItem& CurDraw :
+		 std::span(DrawList).subspan(DrawBegin, DrawEnd - DrawBegin) )
+	{
+		const auto& CurLightmapMesh = LightmapMeshs[CurDraw.MeshIndex];
+
+		// Nothing of this mesh is visible
+		if( Config.VisibleSurfaceCompaction == SurfaceCompaction::CPU
+			&& CurLightmapMesh.VisibleIndexCount == 0 )
+		{
+			continue;
+		}
+
+		if( DepthOnly && CurLightmapMesh.AlphaTested )
+		{
+			continue;
+		}
+
+		if( !BindGeometry(CurDraw) )
+		{
+			continue;
+		}
+
+		BindDrawState(CurDraw);
+
+		switch( Config.VisibleSurfaceCompaction )
+		{
+		case SurfaceCompaction::None:
+		{
+			// Simplified levels are drawn whole, regardless of the visible
+			// clusters
+			if( const std::uint32_t LOD = MeshLODs[CurDraw.MeshIndex]; LOD )
+			{
+				DrawIndexed(
+					CurLightmapMesh.LODIndexCounts[LOD],
+					CurLightmapMesh.LODIndexOffsets[LOD],
+					CurLightmapMesh.VertexIndexOffset, CurDraw.MeshIndex
+				);
+				break;
+			}
+
+			const auto& VisibleClusters
+				= BSPVisibilities[CurLightmapMesh.BSPIndex].VisibleClusters;
+
+			if( VisibleClusters.empty() )
+			{
+				DrawIndexed(
+					CurLightmapMesh.IndexCount, CurLightmapMesh.IndexOffset,
+					CurLightmapMesh.VertexIndexOffset, CurDraw.MeshIndex
+				);
+				break;
+			}
+
+			const auto IsClusterVisible
+				= [&](std::uint16_t Cluster) -> bool {
+				if( Cluster == NoCluster )
+				{
+					return true;
+				}
+				const std::size_t WordIndex = Cluster / 32;
+				return WordIndex < VisibleClusters.size()
+					&& ((VisibleClusters[WordIndex] >> (Cluster % 32)) & 1);
+			};
+
+			// Adjacent visible ranges are contiguous and drawn together
+			std::uint32_t DrawIndexOffset = 0;
+			std::uint32_t DrawIndexCount  = 0;
+			for( const ClusterRange& CurClusterRange : std::span(
+					 ClusterRanges.begin() + CurLightmapMesh.ClusterRangeStart,
+					 CurLightmapMesh.ClusterRangeCount
+				 ) )
+			{
+				if( !IsClusterVisible(CurClusterRange.Cluster) )
+				{
+					continue;
+				}
+
+				if( DrawIndexCount
+					&& DrawIndexOffset + DrawIndexCount
+						   != CurClusterRange.IndexOffset )
+				{
+					DrawIndexed(
+						DrawIndexCount, DrawIndexOffset,
+						CurLightmapMesh.VertexIndexOffset, CurDraw.MeshIndex
+					);
+					DrawIndexCount = 0;
+				}
+
+				if( DrawIndexCount == 0 )
+				{
+					DrawIndexOffset = CurClusterRange.IndexOffset;
+				}
+				DrawIndexCount += CurClusterRange.IndexCount;
+			}
+
+			if( DrawIndexCount )
+			{
+				DrawIndexed(
+					DrawIndexCount, DrawIndexOffset,
+					CurLightmapMesh.VertexIndexOffset, CurDraw.MeshIndex
+				);
+			}
+			break;
+		}
+		case SurfaceCompaction::CPU:
+		{
+			DrawIndexed(
+				CurLightmapMesh.VisibleIndexCount, CurLightmapMesh.IndexOffset,
+				CurLightmapMesh.VertexIndexOffset, CurDraw.MeshIndex
+			);
+			break;
+		}
+		case SurfaceCompaction::GPU:
+		{
+			CommandBuffer.drawIndexedIndirect(
+				VisibleDrawCommandBuffer.get(),
+				CurDraw.MeshIndex * sizeof(vk::DrawIndexedIndirectCommand), 1,
+				sizeof(vk::DrawIndexedIndirectCommand)
+			);
+			++Stats.Draws;
+			break;
+		}
+		}
+	}
+}
+
+void Scene::RecordObjectDraws(
+	vk::CommandBuffer CommandBuffer, RenderStats& Stats
+) const
+{
+	if( ObjectModels.empty() )
+	{
+		return;
+	}
+
+	// All models share the same state and buffers
+	CommandBuffer.bindPipeline(
+		vk::PipelineBindPoint::eGraphics, ObjectPipeline.get()
+	);
+	CommandBuffer.bindDescriptorSets(
+		vk::PipelineBindPoint::eGraphics, ObjectPipelineLayout.get(), 0,
+		{CurSceneDescriptor}, {}
+	);
+	Stats.Binds += 2;
+	++Stats.StateChanges;
+
+	CommandBuffer.bindVertexBuffers(
+		0, {ObjectVertexBuffer.get(), ObjectInstanceBuffer.get()}, {0, 0}
+	);
+	CommandBuffer.bindIndexBuffer(
+		ObjectIndexBuffer.get(), 0, vk::IndexType::eUint32
+	);
+
+	Vulkan::InsertDebugLabel(
+		CommandBuffer, {0.5, 0.5, 0.5, 1.0}, "Object Draws: %zu",
+		ObjectModels.size()
+	);
+
+	if( HasObjectLODs() )
+	{
+		CommandBuffer.drawIndexedIndirect(
+			ObjectDrawCommandBuffer.get(), 0,
+			ObjectModels.size() * ObjectLODCount,
+			sizeof(vk::DrawIndexedIndirectCommand)
+		);
+		++Stats.Draws;
+		return;
+	}
+
+	// The placements stay in the order of `ObjectModels`, all at their most
+	// detailed level
+	for( const ObjectModel& CurModel : ObjectModels )
+	{
+		CommandBuffer.drawIndexed(
+			CurModel.LODIndexCounts[0], CurModel.InstanceCount,
+			CurModel.LODIndexOffsets[0], std::int32_t(CurModel.VertexOffset),
+			CurModel.InstanceOffset
+		);
+		++Stats.Draws;
+	}
+}
+
+void Scene::GatherVisibleDecals(
+	std::vector<DecalInstance>& VisibleDecals
+) const
+{
+	VisibleDecals.clear();
+	for( std::size_t DecalIndex = 0; DecalIndex < Decals.size(); ++DecalIndex )
+	{
+		const DecalLocation& CurLocation = DecalLocations[DecalIndex];
+		if( CurLocation.Cluster != NoCluster )
+		{
+			const std::vector<std::uint32_t>& VisibleClusters
+				= BSPVisibilities[CurLocation.BSPIndex].VisibleClusters;
+
+			// An empty bit-array draws all clusters
+			const std::size_t   WordIndex  = CurLocation.Cluster / 32;
+			const std::uint32_t ClusterBit = 1u << (CurLocation.Cluster % 32);
+			if( !VisibleClusters.empty()
+				&& (WordIndex >= VisibleClusters.size()
+					|| !(VisibleClusters[WordIndex] & ClusterBit)) )
+			{
+				continue;
+			}
+		}
+
+		VisibleDecals.push_back(Decals[DecalIndex]);
+	}
+}
+
+void Scene::RecordDecalDraws(
+	vk::CommandBuffer CommandBuffer, RenderStats& Stats
+) const
+{
+	if( !DecalPipeline )
+	{
+		return;
+	}
+
+	CommandBuffer.bindPipeline(
+		vk::PipelineBindPoint::eGraphics, DecalPipeline.get()
+	);
+	CommandBuffer.bindDescriptorSets(
+		vk::PipelineBindPoint::eGraphics, DecalPipelineLayout.get(), 0,
+		{CurSceneDescriptor, BindlessDescriptor, DecalDescriptor}, {}
+	);
+	Stats.Binds += 2;
+	++Stats.StateChanges;
+
+	CommandBuffer.bindVertexBuffers(0, {DecalInstanceBuffer.get()}, {0});
+
+	Vulkan::InsertDebugLabel(
+		CommandBuffer, {0.5, 0.25, 0.0, 1.0}, "Decal Draw: %zu", Decals.size()
+	);
+
+	CommandBuffer.drawIndirect(
+		DecalDrawCommandBuffer.get(), 0, 1, sizeof(vk::DrawIndirectCommand)
+	);
+	++Stats.Draws;
+}
+
+void Scene::RecordDetailObjectDraws(
+	vk::CommandBuffer CommandBuffer, RenderStats& Stats
+) const
+{
+	if( !DetailObjectPipeline )
+	{
+		return;
+	}
+
+	CommandBuffer.bindPipeline(
+		vk::PipelineBindPoint::eGraphics, DetailObjectPipeline.get()
+	);
+	CommandBuffer.bindDescriptorSets(
+		vk::PipelineBindPoint::eGraphics, DetailObjectPipelineLayout.get(), 0,
+		{CurSceneDescriptor, DetailObjectDescriptor}, {}
+	);
+	Stats.Binds += 2;
+	++Stats.StateChanges;
+
+	Vulkan::InsertDebugLabel(
+		CommandBuffer, {0.25, 0.75, 0.0, 1.0}, "Detail Object Draw: %u",
+		DetailObjectCount
+	);
+
+	CommandBuffer.drawIndirect(
+		DetailObjectDrawCommandBuffer.get(), 0, 1,
+		sizeof(vk::DrawIndirectCommand)
+	);
+	++Stats.Draws;
+}
+
+std::optional<Scene> Scene::Create(
+	Renderer& TargetRenderer, const World& TargetWorld,
+	const SceneConfig& RequestedConfig
+)
+{
+	// Fall back from whatever the enabled device-features can not support
+	SceneConfig Config = RequestedConfig;
+	if( !Config.DrawIndirectFirstInstance )
+	{
+		Config.GPUCulling = false;
+		if( Config.VisibleSurfaceCompaction == SurfaceCompaction::GPU )
+		{
+			Config.VisibleSurfaceCompaction = SurfaceCompaction::CPU;
+		}
+	}
+
+	Scene NewScene(TargetRenderer, TargetWorld, Config);
+
+	const Vulkan::Context& VulkanContext = TargetRenderer.GetVulkanContext();
+	Common::WorkerPool&    LoadWorkers   = TargetRenderer.GetLoadWorkers();
+
+	// All pipelines are created through the renderer's persistent cache
+	const vk::PipelineCache PipelineCache
+		= TargetRenderer.GetPipelineCache().GetPipelineCache();
+
+	// Culling needs the indices of each cluster-range to be left in place
+	const bool GPUCulling
+		= Config.GPUCulling
+	   && Config.VisibleSurfaceCompaction == SurfaceCompaction::None;
+
+	// Descriptor pools
+	{
+		NewScene.ShaderEnvironmentDescriptorPool
+			= std::make_unique<Vulkan::DescriptorHeap>(
+				Vulkan::DescriptorHeap::Create(
+					VulkanContext, ShaderEnvironmentBindings
+				)
+					.value()
+			);
+		NewScene.DebugDrawDescriptorPool
+			= std::make_unique<Vulkan::DescriptorHeap>(
+				Vulkan::DescriptorHeap::Create(
+					VulkanContext, {{vk::DescriptorSetLayoutBinding(
+									   0, vk::DescriptorType::eSampledImage, 1,
+									   vk::ShaderStageFlagBits::eFragment
+								   )}}
+				).value()
+			);
+
+		NewScene.UnlitDescriptorPool = std::make_unique<Vulkan::DescriptorHeap>(
+			Vulkan::DescriptorHeap::Create(
+				VulkanContext, {{vk::DescriptorSetLayoutBinding(
+								   0, vk::DescriptorType::eSampledImage, 1,
+								   vk::ShaderStageFlagBits::eFragment
+							   )}}
+			).value()
+		);
+		NewScene.SceneDescriptorPool = std::make_unique<Vulkan::DescriptorHeap>(
+			Vulkan::DescriptorHeap::Create(VulkanContext, SceneBindings).value()
+		);
+	}
+
+	// Scene Descriptor
+	{
+		NewScene.CurSceneDescriptor
+			= NewScene.SceneDescriptorPool->AllocateDescriptorSet().value();
+		// Default2DSamplerFiltered
+		TargetRenderer.GetDescriptorUpdateBatch().AddSampler(
+			NewScene.CurSceneDescriptor, 0,
+			TargetRenderer.GetSamplerCache().GetSampler(Sampler2D())
+		);
+
+		// Default2DSamplerUnfiltered
+		TargetRenderer.GetDescriptorUpdateBatch().AddSampler(
+			NewScene.CurSceneDescriptor, 1,
+			TargetRenderer.GetSamplerCache().GetSampler(Sampler2D(false))
+		);
+
+		// Default2DSamplerUnfiltered
+		TargetRenderer.GetDescriptorUpdateBatch().AddSampler(
+			NewScene.CurSceneDescriptor, 2,
+			TargetRenderer.GetSamplerCache().GetSampler(SamplerCube())
+		);
+
+		// SceneGlobalsBuffer
+		NewScene.SceneGlobalsBuffer = CreateSceneBuffer(
+			VulkanContext.LogicalDevice, sizeof(SceneGlobals),
+			vk::BufferUsageFlagBits::eUniformBuffer, "Scene Globals"
+		);
+		if( !NewScene.SceneGlobalsBuffer )
+		{
+			return {};
+		}
+
+		if( auto [Result, Value] = Vulkan::CommitBufferHeap(
+				VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
+				std::array{NewScene.SceneGlobalsBuffer.get()}
+			);
+			Result == vk::Result::eSuccess )
+		{
+			NewScene.SceneGlobalsMemory = std::move(Value);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error committing scene globals memory: %s\n",
+				vk::to_string(Result).c_str()
+			);
+			return {};
+		}
+
+		TargetRenderer.GetDescriptorUpdateBatch().AddBuffer(
+			NewScene.CurSceneDescriptor, 3, NewScene.SceneGlobalsBuffer.get(),
+			0, VK_WHOLE_SIZE, vk::DescriptorType::eUniformBuffer
+		);
+	}
+
+	{
+		// Main Shader modules
+		const auto DefaultVertShaderData
+			= VkBlam::OpenResource("shaders/Default.vert.spv").value();
+		const auto DefaultFragShaderData
+			= VkBlam::OpenResource("shaders/Default.frag.spv").value();
+		const auto UnlitFragShaderData
+			= VkBlam::OpenResource("shaders/Unlit.frag.spv").value();
+
+		NewScene.DefaultVertexShaderModule
+			= TargetRenderer.GetShaderModuleCache()
+				  .GetShaderModule(DefaultVertShaderData)
+				  .value();
+		NewScene.DefaultFragmentShaderModule
+			= TargetRenderer.GetShaderModuleCache()
+				  .GetShaderModule(DefaultFragShaderData)
+				  .value();
+		NewScene.UnlitFragmentShaderModule
+			= TargetRenderer.GetShaderModuleCache()
+				  .GetShaderModule(UnlitFragShaderData)
+				  .value();
+
+		const vk::RenderPass RenderPass
+			= TargetRenderer.GetDefaultRenderPass(RenderSamples);
+
+		const auto [VertexBindingDescriptions, VertexAttributeDescriptions]
+			= VkBlam::GetVertexInputDescriptions({{
+				Blam::VertexFormat::SBSPVertexUncompressed,
+				Blam::VertexFormat::SBSPLightmapVertexUncompressed,
+			}});
+
+		std::tie(NewScene.DebugDrawPipeline, NewScene.DebugDrawPipelineLayout)
+			= CreateGraphicsPipeline(
+				VulkanContext.LogicalDevice, PipelineCache, {},
+				{{NewScene.SceneDescriptorPool->GetDescriptorSetLayout(),
+				  NewScene.ShaderEnvironmentDescriptorPool
+					  ->GetDescriptorSetLayout(),
+				  NewScene.DebugDrawDescriptorPool->GetDescriptorSetLayout()}},
+				NewScene.DefaultVertexShaderModule,
+				NewScene.DefaultFragmentShaderModule, VertexBindingDescriptions,
+				VertexAttributeDescriptions, RenderPass, RenderSamples,
+				vk::PolygonMode::eFill
+			);
+
+		std::tie(NewScene.UnlitDrawPipeline, NewScene.UnlitDrawPipelineLayout)
+			= CreateGraphicsPipeline(
+				VulkanContext.LogicalDevice, PipelineCache,
+				{{vk::PushConstantRange(
+					vk::ShaderStageFlagBits::eFragment, 0, sizeof(glm::f32vec4)
+				)}},
+				{{NewScene.SceneDescriptorPool->GetDescriptorSetLayout(),
+				  NewScene.UnlitDescriptorPool->GetDescriptorSetLayout()}},
+				NewScene.DefaultVertexShaderModule,
+				NewScene.UnlitFragmentShaderModule, VertexBindingDescriptions,
+				VertexAttributeDescriptions, RenderPass, RenderSamples,
+				vk::PolygonMode::eLine
+			);
+
+		if( Config.DepthPrepass )
+		{
+			// Shares the layout of `DebugDrawPipeline`
+			std::tie(NewScene.DebugDrawDepthEqualPipeline, std::ignore)
+				= CreateGraphicsPipeline(
+					VulkanContext.LogicalDevice, PipelineCache, {},
+					{{NewScene.SceneDescriptorPool->GetDescriptorSetLayout(),
+					  NewScene.ShaderEnvironmentDescriptorPool
+						  ->GetDescriptorSetLayout(),
+					  NewScene.DebugDrawDescriptorPool
+						  ->GetDescriptorSetLayout()}},
+					NewScene.DefaultVertexShaderModule,
+					NewScene.DefaultFragmentShaderModule,
+					VertexBindingDescriptions, VertexAttributeDescriptions,
+					RenderPass, RenderSamples, vk::PolygonMode::eFill,
+					vk::CompareOp::eEqual, false
+				);
+
+			const auto DepthPrepassVertShaderData
+				= VkBlam::OpenResource("shaders/DepthPrepass.vert.spv").value();
+
+			NewScene.DepthPrepassVertexShaderModule
+				= TargetRenderer.GetShaderModuleCache()
+					  .GetShaderModule(DepthPrepassVertShaderData)
+					  .value();
+
+			// Tightly packed positions within each region's `PositionBuffer`
+			const vk::VertexInputBindingDescription PositionBinding(
+				0, sizeof(glm::f32vec3), vk::VertexInputRate::eVertex
+			);
+			const vk::VertexInputAttributeDescription PositionAttribute(
+				0, 0, vk::Format::eR32G32B32Sfloat, 0
+			);
+
+			// Depth-only, without a fragment shader
+			std::tie(
+				NewScene.DepthPrepassPipeline,
+				NewScene.DepthPrepassPipelineLayout
+			)
+				= CreateGraphicsPipeline(
+					VulkanContext.LogicalDevice, PipelineCache, {},
+					{{NewScene.SceneDescriptorPool->GetDescriptorSetLayout()}},
+					NewScene.DepthPrepassVertexShaderModule, {},
+					{{PositionBinding}}, {{PositionAttribute}}, RenderPass,
+					RenderSamples, vk::PolygonMode::eFill
+				);
+		}
+	}
+
+	std::vector<Blam::TagVisitorProc> TagVisitors = {};
+
+	// Load BSP
+	{
+		// Index in elements, not bytes
+		std::uint32_t VertexHeapIndexEnd = 0;
+		std::uint32_t IndexHeapIndexEnd  = 0;
+
+		// Merge the meshes of a BSP that share the same shader and lightmap
+		// into a single draw. Indices are rebased onto the first vertex of
+		// the merged mesh and only become 32-bit if they no longer fit into
+		// 16 bits. Compaction relies on the per-material layout of the
+		// indices, so merging only happens without it
+		const bool MergeMeshes
+			= Config.VisibleSurfaceCompaction == SurfaceCompaction::None;
+
+		// Simplified levels-of-detail follow all of the merged indices
+		std::uint32_t LODCount = 0;
+		if( MergeMeshes )
+		{
+			LODCount
+				= std::min<std::uint32_t>(Config.LODCount, MaxLODCount - 1);
+		}
+
+		// Positions of all vertices, to find the bounds of each cluster-range,
+		// to simplify each mesh, and for the vertex-stream of the depth
+		// pre-pass
+		const bool GatherPositions
+			= GPUCulling || Config.DepthPrepass || LODCount;
+
+		// Triangles of all BSPs, with each mesh's surfaces sorted by cluster,
+		// along with the BSP surface-index of each triangle
+		std::vector<std::array<std::uint16_t, 3>> SortedSurfaces;
+		std::vector<std::uint32_t>                SortedSurfaceIDs;
+
+		std::vector<glm::f32vec3> VertexPositions;
+
+		// The geometry of all BSPs is packed in parallel. Each material's
+		// vertices, surfaces, and cluster-ranges are counted, the counts are
+		// turned into offsets with an exclusive prefix-sum, and then each
+		// material fills its own region of the packed arrays. Only the
+		// enumeration of the tag-blocks is serial
+		struct BSPSource
+		{
+			Blam::VirtualHeap                                      Heap;
+			const Blam::Tag<Blam::TagClass::ScenarioStructureBsp>* Tag;
+
+			// The first cluster that lists each surface
+			std::vector<std::uint16_t> SurfaceClusters;
+		};
+		std::vector<BSPSource> BSPSources;
+
+		const auto ScenarioBSPs = TargetWorld.GetMapFile().GetScenarioBSPs();
+		BSPSources.reserve(ScenarioBSPs.size());
+
+		for( const Blam::Tag<Blam::TagClass::Scenario>::StructureBSP& CurSBSP :
+			 ScenarioBSPs )
+		{
+			const Blam::VirtualHeap SBSPHeap
+				= CurSBSP.GetSBSPHeap(TargetWorld.GetMapFile().GetMapData());
+
+			const Blam::Tag<Blam::TagClass::ScenarioStructureBsp>& ScenarioBSP
+				= CurSBSP.GetSBSP(SBSPHeap);
+
+			const auto Surfaces = SBSPHeap.GetBlock(ScenarioBSP.Surfaces);
+
+			const std::uint32_t BSPIndex = NewScene.BSPVisibilities.size();
+
+			auto& CurBSPVisibility = NewScene.BSPVisibilities.emplace_back();
+			CurBSPVisibility.Surfaces    = Surfaces;
+			CurBSPVisibility.IndexOffset = IndexHeapIndexEnd;
+
+			if( Config.VisibleSurfaceCompaction != SurfaceCompaction::None )
+			{
+				CurBSPVisibility.SubClusterBounds
+					= Blam::BakeSubClusterBounds(SBSPHeap, ScenarioBSP);
+				CurBSPVisibility.SubClusterHitMask.resize(
+					CurBSPVisibility.SubClusterBounds.GetPaddedCount() / 8
+				);
+			}
+
+			BSPSources.push_back(BSPSource{SBSPHeap, &ScenarioBSP, {}});
+
+			std::uint32_t SBSPIndexHeapEnd = IndexHeapIndexEnd;
+
+			// Lightmap
+			for( const auto& CurLightmap :
+				 SBSPHeap.GetBlock(ScenarioBSP.Lightmaps) )
+			{
+				const std::int16_t LightmapTextureIndex
+					= CurLightmap.LightmapIndex;
+
+				for( const auto& CurMaterial :
+					 SBSPHeap.GetBlock(CurLightmap.Materials) )
+				{
+					auto& CurLightmapMesh
+						= NewScene.LightmapMeshs.emplace_back();
+
+					CurLightmapMesh.VertexData
+						= CurMaterial.GetVertices(SBSPHeap);
+					CurLightmapMesh.LightmapVertexData
+						= CurMaterial.GetLightmapVertices(SBSPHeap);
+
+					CurLightmapMesh.ShaderTag = CurMaterial.Shader.TagID;
+
+					if( ScenarioBSP.LightmapTexture.Valid()
+						&& LightmapTextureIndex != -1 )
+					{
+						CurLightmapMesh.LightmapTag
+							= ScenarioBSP.LightmapTexture.TagID;
+						CurLightmapMesh.LightmapIndex = LightmapTextureIndex;
+					}
+
+					CurLightmapMesh.IndexOffset = SBSPIndexHeapEnd;
+					CurLightmapMesh.IndexCount  = CurMaterial.SurfacesCount * 3;
+					SBSPIndexHeapEnd += CurMaterial.SurfacesCount * 3;
+
+					CurLightmapMesh.Centroid = glm::f32vec3(
+						CurMaterial.Centroid[0], CurMaterial.Centroid[1],
+						CurMaterial.Centroid[2]
+					);
+
+					CurLightmapMesh.BSPIndex     = BSPIndex;
+					CurLightmapMesh.SurfaceStart
+						= CurMaterial.SurfacesIndexStart;
+					CurLightmapMesh.SurfaceCount = CurMaterial.SurfacesCount;
+
+					// All surfaces are initially visible
+					CurLightmapMesh.VisibleIndexCount
+						= CurLightmapMesh.IndexCount;
+				}
+			}
+
+			IndexHeapIndexEnd += ScenarioBSP.Surfaces.Count * 3;
+		}
+
+		const std::size_t MeshCount = NewScene.LightmapMeshs.size();
+
+		SortedSurfaces.resize(IndexHeapIndexEnd / 3);
+		SortedSurfaceIDs.resize(IndexHeapIndexEnd / 3);
+
+		// Assign each surface to the first cluster that lists it
+		LoadWorkers.ParallelFor(
+			BSPSources.size(),
+			[&](std::size_t BSPIndex) -> void {
+				BSPSource&  CurBSPSource = BSPSources[BSPIndex];
+				const auto& SBSPHeap     = CurBSPSource.Heap;
+
+				CurBSPSource.SurfaceClusters.assign(
+					CurBSPSource.Tag->Surfaces.Count, NoCluster
+				);
+
+				const auto Clusters
+					= SBSPHeap.GetBlock(CurBSPSource.Tag->Clusters);
+				for( std::uint16_t ClusterIndex = 0;
+					 ClusterIndex < Clusters.size(); ++ClusterIndex )
+				{
+					for( const std::uint32_t& SurfaceIndex : SBSPHeap.GetBlock(
+							 Clusters[ClusterIndex].SurfaceIndices
+						 ) )
+					{
+						if( SurfaceIndex < CurBSPSource.SurfaceClusters.size()
+							&& CurBSPSource.SurfaceClusters[SurfaceIndex]
+								   == NoCluster )
+						{
+							CurBSPSource.SurfaceClusters[SurfaceIndex]
+								= ClusterIndex;
+						}
+					}
+				}
+			}
+		);
+
+		// Count pass. The surfaces of each material are sorted by cluster,
+		// leaving the surfaces without a cluster at the end, and written
+		// into the material's region of the sorted surfaces, which is already
+		// known. The material's cluster-ranges are kept until their offset is
+		std::vector<std::vector<ClusterRange>> MeshClusterRanges(MeshCount);
+		LoadWorkers.ParallelFor(MeshCount, [&](std::size_t MeshIndex) -> void {
+			const auto& CurLightmapMesh = NewScene.LightmapMeshs[MeshIndex];
+			const auto& CurBSPVisibility
+				= NewScene.BSPVisibilities[CurLightmapMesh.BSPIndex];
+			const auto& SurfaceClusters
+				= BSPSources[CurLightmapMesh.BSPIndex].SurfaceClusters;
+
+			std::vector<std::uint32_t> MaterialSurfaces(
+				CurLightmapMesh.SurfaceCount
+			);
+			std::iota(
+				MaterialSurfaces.begin(), MaterialSurfaces.end(),
+				CurLightmapMesh.SurfaceStart
+			);
+			std::stable_sort(
+				MaterialSurfaces.begin(), MaterialSurfaces.end(),
+				[&](std::uint32_t A, std::uint32_t B) -> bool {
+					return SurfaceClusters[A] < SurfaceClusters[B];
+				}
+			);
+
+			std::vector<ClusterRange>& CurClusterRanges
+				= MeshClusterRanges[MeshIndex];
+			for( std::size_t i = 0; i < MaterialSurfaces.size(); ++i )
+			{
+				const std::uint32_t SurfaceIndex = MaterialSurfaces[i];
+				const std::size_t   SortedIndex
+					= CurLightmapMesh.IndexOffset / 3 + i;
+
+				SortedSurfaces[SortedIndex]
+					= CurBSPVisibility.Surfaces[SurfaceIndex];
+				SortedSurfaceIDs[SortedIndex] = SurfaceIndex;
+
+				const std::uint16_t Cluster = SurfaceClusters[SurfaceIndex];
+				if( CurClusterRanges.empty()
+					|| CurClusterRanges.back().Cluster != Cluster )
+				{
+					CurClusterRanges.push_back(ClusterRange{
+						Cluster,
+						CurLightmapMesh.IndexOffset
+							+ static_cast<std::uint32_t>(i * 3),
+						0});
+				}
+				CurClusterRanges.back().IndexCount += 3;
+			}
+		});
+
+		// Prefix-sum pass
+		std::vector<std::uint32_t> VertexOffsets(MeshCount);
+		std::vector<std::uint32_t> ClusterRangeOffsets(MeshCount);
+
+		std::transform_exclusive_scan(
+			NewScene.LightmapMeshs.begin(), NewScene.LightmapMeshs.end(),
+			VertexOffsets.begin(), std::uint32_t(0), std::plus<>(),
+			[](const LightmapMesh& CurLightmapMesh) -> std::uint32_t {
+				return CurLightmapMesh.VertexData.size();
+			}
+		);
+		std::transform_exclusive_scan(
+			MeshClusterRanges.begin(), MeshClusterRanges.end(),
+			ClusterRangeOffsets.begin(), std::uint32_t(0), std::plus<>(),
+			[](const std::vector<ClusterRange>& CurClusterRanges)
+				-> std::uint32_t { return CurClusterRanges.size(); }
+		);
+
+		if( MeshCount )
+		{
+			VertexHeapIndexEnd
+				= VertexOffsets.back()
+				+ NewScene.LightmapMeshs.back().VertexData.size();
+			NewScene.ClusterRanges.resize(
+				ClusterRangeOffsets.back() + MeshClusterRanges.back().size()
+			);
+		}
+
+		if( GatherPositions )
+		{
+			VertexPositions.resize(VertexHeapIndexEnd);
+		}
+
+		// Fill pass
+		LoadWorkers.ParallelFor(MeshCount, [&](std::size_t MeshIndex) -> void {
+			auto& CurLightmapMesh = NewScene.LightmapMeshs[MeshIndex];
+
+			CurLightmapMesh.VertexIndexOffset = VertexOffsets[MeshIndex];
+
+			CurLightmapMesh.ClusterRangeStart = ClusterRangeOffsets[MeshIndex];
+			CurLightmapMesh.ClusterRangeCount
+				= MeshClusterRanges[MeshIndex].size();
+			std::copy(
+				MeshClusterRanges[MeshIndex].begin(),
+				MeshClusterRanges[MeshIndex].end(),
+				NewScene.ClusterRanges.begin()
+					+ CurLightmapMesh.ClusterRangeStart
+			);
+
+			if( GatherPositions )
+			{
+				std::transform(
+					CurLightmapMesh.VertexData.begin(),
+					CurLightmapMesh.VertexData.end(),
+					VertexPositions.begin() + CurLightmapMesh.VertexIndexOffset,
+					[](const Blam::Vertex& CurVertex) -> glm::f32vec3 {
+						return glm::f32vec3(
+							CurVertex.Position[0], CurVertex.Position[1],
+							CurVertex.Position[2]
+						);
+					}
+				);
+			}
+		});
+
+		std::printf(
+			"BSP geometry: %zu BSPs | %zu materials | %u vertices | %u "
+			"surfaces\n",
+			BSPSources.size(), MeshCount, VertexHeapIndexEnd,
+			IndexHeapIndexEnd / 3
+		);
+
+		std::vector<LightmapMesh>  MergedMeshes;
+		std::vector<ClusterRange>  MergedClusterRanges;
+		std::vector<std::uint32_t> MergedIndices;
+		std::uint32_t              MergedIndexMax = 0;
+
+		if( MergeMeshes )
+		{
+			std::map<
+				std::tuple<
+					std::uint32_t, std::uint32_t, std::optional<std::uint32_t>,
+					std::optional<std::uint32_t>>,
+				std::vector<std::uint32_t>>
+				MeshGroups;
+
+			for( std::uint32_t MeshIndex = 0;
+				 MeshIndex < NewScene.LightmapMeshs.size(); ++MeshIndex )
+			{
+				const auto& CurLightmapMesh = NewScene.LightmapMeshs[MeshIndex];
+				MeshGroups[{
+							   CurLightmapMesh.BSPIndex,
+							   CurLightmapMesh.ShaderTag,
+							   CurLightmapMesh.LightmapTag,
+							   CurLightmapMesh.LightmapIndex,
+						   }]
+					.push_back(MeshIndex);
+			}
+
+			MergedIndices.reserve(IndexHeapIndexEnd);
+
+			for( const auto& [GroupKey, GroupMeshes] : MeshGroups )
+			{
+				const LightmapMesh& FirstMesh
+					= NewScene.LightmapMeshs[GroupMeshes.front()];
+
+				LightmapMesh& MergedMesh = MergedMeshes.emplace_back();
+				MergedMesh.ShaderTag     = FirstMesh.ShaderTag;
+				MergedMesh.LightmapTag   = FirstMesh.LightmapTag;
+				MergedMesh.LightmapIndex = FirstMesh.LightmapIndex;
+				MergedMesh.BSPIndex      = FirstMesh.BSPIndex;
+				MergedMesh.IndexOffset   = MergedIndices.size();
+
+				// Gather the cluster-ranges of all meshes and order them by
+				// cluster so that each cluster stays contiguous
+				std::vector<std::pair<ClusterRange, std::uint32_t>>
+					GroupRanges;
+
+				MergedMesh.VertexIndexOffset = FirstMesh.VertexIndexOffset;
+				for( const std::uint32_t MeshIndex : GroupMeshes )
+				{
+					const auto& CurLightmapMesh
+						= NewScene.LightmapMeshs[MeshIndex];
+
+					MergedMesh.VertexIndexOffset = std::min(
+						MergedMesh.VertexIndexOffset,
+						CurLightmapMesh.VertexIndexOffset
+					);
+					MergedMesh.IndexCount += CurLightmapMesh.IndexCount;
+					MergedMesh.Centroid
+						+= CurLightmapMesh.Centroid
+						 * float(CurLightmapMesh.IndexCount);
+
+					for( std::uint32_t i = 0;
+						 i < CurLightmapMesh.ClusterRangeCount; ++i )
+					{
+						GroupRanges.emplace_back(
+							NewScene.ClusterRanges
+								[CurLightmapMesh.ClusterRangeStart + i],
+							CurLightmapMesh.VertexIndexOffset
+						);
+					}
+				}
+				MergedMesh.VisibleIndexCount = MergedMesh.IndexCount;
+				if( MergedMesh.IndexCount )
+				{
+					MergedMesh.Centroid /= float(MergedMesh.IndexCount);
+				}
+
+				std::stable_sort(
+					GroupRanges.begin(), GroupRanges.end(),
+					[](const auto& A, const auto& B) -> bool {
+						return A.first.Cluster < B.first.Cluster;
+					}
+				);
+
+				MergedMesh.ClusterRangeStart = MergedClusterRanges.size();
+				for( const auto& [CurClusterRange, VertexIndexOffset] :
+					 GroupRanges )
+				{
+					const std::uint32_t VertexRebase
+						= VertexIndexOffset - MergedMesh.VertexIndexOffset;
+
+					if( MergedClusterRanges.size()
+							== MergedMesh.ClusterRangeStart
+						|| MergedClusterRanges.back().Cluster
+							   != CurClusterRange.Cluster )
+					{
+						MergedClusterRanges.push_back(ClusterRange{
+							CurClusterRange.Cluster,
+							static_cast<std::uint32_t>(MergedIndices.size()),
+							0});
+					}
+					MergedClusterRanges.back().IndexCount
+						+= CurClusterRange.IndexCount;
+
+					for( std::uint32_t i = 0; i < CurClusterRange.IndexCount;
+						 ++i )
+					{
+						const std::uint32_t SourceIndex
+							= CurClusterRange.IndexOffset + i;
+						const std::uint32_t RebasedIndex
+							= SortedSurfaces[SourceIndex / 3][SourceIndex % 3]
+							+ VertexRebase;
+
+						MergedIndexMax = std::max(MergedIndexMax, RebasedIndex);
+						MergedIndices.push_back(RebasedIndex);
+					}
+				}
+				MergedMesh.ClusterRangeCount
+					= MergedClusterRanges.size() - MergedMesh.ClusterRangeStart;
+			}
+
+			if( MergedIndexMax > std::numeric_limits<std::uint16_t>::max() )
+			{
+				NewScene.BSPIndexType = vk::IndexType::eUint32;
+			}
+		}
+
+		//// Levels of detail
+		if( LODCount )
+		{
+			// The simplified indices of each level of each mesh. Each level
+			// is simplified from the previous one. A mesh's levels end at the
+			// first empty list
+			std::vector<std::vector<std::uint32_t>> LODIndices(
+				MergedMeshes.size() * LODCount
+			);
+
+			// Only the vertices that each mesh references, repeated for
+			// each of its levels
+			std::vector<std::uint32_t> LODVertexCounts(LODIndices.size());
+			for( std::size_t MeshIndex = 0; MeshIndex < MergedMeshes.size();
+				 ++MeshIndex )
+			{
+				const LightmapMesh& CurMergedMesh = MergedMeshes[MeshIndex];
+				const auto SourceBegin
+					= MergedIndices.begin() + CurMergedMesh.IndexOffset;
+				const auto SourceEnd = SourceBegin + CurMergedMesh.IndexCount;
+				const std::uint32_t VertexCount
+					= SourceBegin == SourceEnd
+						? 0
+						: *std::max_element(SourceBegin, SourceEnd) + 1;
+				std::fill_n(
+					LODVertexCounts.begin() + MeshIndex * LODCount, LODCount,
+					VertexCount
+				);
+			}
+
+			std::filesystem::path LODCacheFile = {};
+			if( !Config.LODCachePath.empty() )
+			{
+				std::uint64_t SourceHash = Common::HashFNV1a(
+					std::as_bytes(std::span(&LODCount, 1))
+				);
+				for( const LightmapMesh& CurMergedMesh : MergedMeshes )
+				{
+					const std::uint32_t MeshRange[] = {
+						CurMergedMesh.VertexIndexOffset,
+						CurMergedMesh.IndexOffset, CurMergedMesh.IndexCount};
+					SourceHash = Common::HashFNV1a(
+						std::as_bytes(std::span(MeshRange)), SourceHash
+					);
+				}
+				SourceHash = Common::HashFNV1a(
+					std::as_bytes(std::span(MergedIndices)), SourceHash
+				);
+				SourceHash = Common::HashFNV1a(
+					std::as_bytes(std::span(VertexPositions)), SourceHash
+				);
+
+				LODCacheFile = Config.LODCachePath
+							 / Common::Format(
+								   "%016llx.lod",
+								   static_cast<unsigned long long>(SourceHash)
+							 );
+			}
+
+			if( LODCacheFile.empty()
+				|| !ReadLODCache(LODCacheFile, LODIndices, LODVertexCounts) )
+			{
+				LoadWorkers.ParallelFor(
+					MergedMeshes.size(),
+					[&](std::size_t MeshIndex) -> void {
+						const LightmapMesh& CurMergedMesh
+							= MergedMeshes[MeshIndex];
+
+						std::span<const std::uint32_t> SourceIndices(
+							MergedIndices.begin() + CurMergedMesh.IndexOffset,
+							CurMergedMesh.IndexCount
+						);
+						if( SourceIndices.empty() )
+						{
+							return;
+						}
+
+						const std::span<const glm::f32vec3> Positions(
+							VertexPositions.begin()
+								+ CurMergedMesh.VertexIndexOffset,
+							LODVertexCounts[MeshIndex * LODCount]
+						);
+
+						for( std::uint32_t Level = 0; Level < LODCount;
+							 ++Level )
+						{
+							// Half of the triangles, allowing the surface to
+							// drift further with each level
+							const std::size_t TargetIndexCount
+								= (SourceIndices.size() / 6) * 3;
+							const float TargetError
+								= 0.01f * float(1u << Level);
+
+							std::vector<std::uint32_t>& CurLODIndices
+								= LODIndices[MeshIndex * LODCount + Level];
+							CurLODIndices = SimplifyMesh(
+								SourceIndices, Positions, TargetIndexCount,
+								TargetError
+							);
+
+							// Not worth another draw-range
+							if( CurLODIndices.size() * 10
+								> SourceIndices.size() * 9 )
+							{
+								CurLODIndices.clear();
+								break;
+							}
+							SourceIndices = CurLODIndices;
+						}
+					}
+				);
+
+				if( !LODCacheFile.empty() )
+				{
+					WriteLODCache(LODCacheFile, LODIndices);
+				}
+			}
+
+			// Triangles of the whole scene when drawn at each level. Meshes
+			// without a level are drawn at their least detailed one
+			std::array<std::size_t, MaxLODCount> LODTriangleCounts = {};
+
+			for( std::size_t MeshIndex = 0; MeshIndex < MergedMeshes.size();
+				 ++MeshIndex )
+			{
+				LightmapMesh& CurMergedMesh = MergedMeshes[MeshIndex];
+
+				CurMergedMesh.LODIndexOffsets[0] = CurMergedMesh.IndexOffset;
+				CurMergedMesh.LODIndexCounts[0]  = CurMergedMesh.IndexCount;
+
+				for( std::uint32_t Level = 0; Level < LODCount; ++Level )
+				{
+					const std::vector<std::uint32_t>& CurLODIndices
+						= LODIndices[MeshIndex * LODCount + Level];
+					if( CurLODIndices.empty() )
+					{
+						break;
+					}
+
+					const std::uint32_t LOD = CurMergedMesh.LODCount++;
+					CurMergedMesh.LODIndexOffsets[LOD] = MergedIndices.size();
+					CurMergedMesh.LODIndexCounts[LOD]  = CurLODIndices.size();
+					MergedIndices.insert(
+						MergedIndices.end(), CurLODIndices.begin(),
+						CurLODIndices.end()
+					);
+				}
+
+				for( std::uint32_t LOD = 0; LOD <= LODCount; ++LOD )
+				{
+					const std::uint32_t DrawnLOD
+						= std::min(LOD, CurMergedMesh.LODCount - 1);
+					LODTriangleCounts[LOD]
+						+= CurMergedMesh.LODIndexCounts[DrawnLOD] / 3;
+				}
+
+				CurMergedMesh.BoundsMin
+					= glm::f32vec3(std::numeric_limits<float>::max());
+				CurMergedMesh.BoundsMax
+					= glm::f32vec3(std::numeric_limits<float>::lowest());
+				for( std::uint32_t i = 0; i < CurMergedMesh.IndexCount; ++i )
+				{
+					const glm::f32vec3& CurPosition = VertexPositions
+						[CurMergedMesh.VertexIndexOffset
+						 + MergedIndices[CurMergedMesh.IndexOffset + i]];
+					CurMergedMesh.BoundsMin
+						= glm::min(CurMergedMesh.BoundsMin, CurPosition);
+					CurMergedMesh.BoundsMax
+						= glm::max(CurMergedMesh.BoundsMax, CurPosition);
+				}
+			}
+
+			for( std::uint32_t LOD = 1; LOD <= LODCount; ++LOD )
+			{
+				std::printf(
+					"LOD %u: %zu -> %zu triangles (%.1f%%)\n", LOD,
+					LODTriangleCounts[0], LODTriangleCounts[LOD],
+					100.0 * double(LODTriangleCounts[LOD])
+						/ double(std::max<std::size_t>(LODTriangleCounts[0], 1))
+				);
+			}
+		}
+
+		// The geometry of each BSP is placed within its own region so that
+		// it may be streamed in and out on its own. Compaction indexes the
+		// surfaces of all BSPs through a single index-buffer, so without
+		// merged meshes all of them share a single region
+		NewScene.GeometryRegions.resize(MergeMeshes ? BSPSources.size() : 1);
+
+		// The vertices of each BSP are contiguous, starting at the lowest
+		// vertex-offset of its meshes
+		std::vector<std::uint32_t> RegionVertexStarts(
+			NewScene.GeometryRegions.size(), VertexHeapIndexEnd
+		);
+		for( LightmapMesh& CurLightmapMesh : NewScene.LightmapMeshs )
+		{
+			if( MergeMeshes )
+			{
+				CurLightmapMesh.GeometryIndex = CurLightmapMesh.BSPIndex;
+			}
+
+			GeometryRegion& CurRegion
+				= NewScene.GeometryRegions[CurLightmapMesh.GeometryIndex];
+			CurRegion.VertexSources.push_back(GeometryRegion::VertexSource{
+				CurLightmapMesh.VertexData, CurLightmapMesh.LightmapVertexData,
+				CurLightmapMesh.VertexIndexOffset});
+			CurRegion.VertexCount += CurLightmapMesh.VertexData.size();
+
+			std::uint32_t& CurVertexStart
+				= RegionVertexStarts[CurLightmapMesh.GeometryIndex];
+			CurVertexStart
+				= std::min(CurVertexStart, CurLightmapMesh.VertexIndexOffset);
+		}
+
+		for( std::size_t GeometryIndex = 0;
+			 GeometryIndex < NewScene.GeometryRegions.size(); ++GeometryIndex )
+		{
+			GeometryRegion& CurRegion = NewScene.GeometryRegions[GeometryIndex];
+			const std::uint32_t VertexStart
+				= RegionVertexStarts[GeometryIndex];
+
+			for( GeometryRegion::VertexSource& CurSource :
+				 CurRegion.VertexSources )
+			{
+				CurSource.VertexOffset -= VertexStart;
+			}
+
+			// Position-only vertex-stream, 12 bytes per vertex rather than
+			// the 56 bytes of `Blam::Vertex`
+			if( Config.DepthPrepass && CurRegion.VertexCount )
+			{
+				CurRegion.Positions.assign(
+					VertexPositions.begin() + VertexStart,
+					VertexPositions.begin() + VertexStart
+						+ CurRegion.VertexCount
+				);
+			}
+		}
+
+		if( !MergeMeshes )
+		{
+			NewScene.GeometryRegions[0].IndexData.assign(
+				std::as_bytes(std::span(SortedSurfaces)).begin(),
+				std::as_bytes(std::span(SortedSurfaces)).end()
+			);
+		}
+		else
+		{
+			// Vertex data has been gathered, draw the merged meshes instead
+			NewScene.LightmapMeshs = std::move(MergedMeshes);
+			NewScene.ClusterRanges = std::move(MergedClusterRanges);
+		}
+
+		// All meshes start at full detail
+		NewScene.MeshLODs.assign(NewScene.LightmapMeshs.size(), 0);
+
+		// GPU-culling implies merged meshes
+		if( GPUCulling )
+		{
+			for( const auto& CurLightmapMesh : NewScene.LightmapMeshs )
+			{
+				for( ClusterRange& CurClusterRange : std::span(
+						 NewScene.ClusterRanges.begin()
+							 + CurLightmapMesh.ClusterRangeStart,
+						 CurLightmapMesh.ClusterRangeCount
+					 ) )
+				{
+					CurClusterRange.BoundsMin
+						= glm::f32vec3(std::numeric_limits<float>::max());
+					CurClusterRange.BoundsMax
+						= glm::f32vec3(std::numeric_limits<float>::lowest());
+					for( std::uint32_t i = 0; i < CurClusterRange.IndexCount;
+						 ++i )
+					{
+						const glm::f32vec3& CurPosition = VertexPositions
+							[CurLightmapMesh.VertexIndexOffset
+							 + MergedIndices[CurClusterRange.IndexOffset + i]];
+						CurClusterRange.BoundsMin
+							= glm::min(CurClusterRange.BoundsMin, CurPosition);
+						CurClusterRange.BoundsMax
+							= glm::max(CurClusterRange.BoundsMax, CurPosition);
+					}
+				}
+			}
+		}
+
+		// Move the indices of each merged mesh into the region of its BSP,
+		// now that nothing else needs the offsets across all BSPs
+		if( MergeMeshes )
+		{
+			std::vector<std::vector<std::uint32_t>> RegionIndices(
+				NewScene.GeometryRegions.size()
+			);
+			for( LightmapMesh& CurLightmapMesh : NewScene.LightmapMeshs )
+			{
+				CurLightmapMesh.GeometryIndex = CurLightmapMesh.BSPIndex;
+				CurLightmapMesh.VertexIndexOffset
+					-= RegionVertexStarts[CurLightmapMesh.GeometryIndex];
+
+				std::vector<std::uint32_t>& CurIndices
+					= RegionIndices[CurLightmapMesh.GeometryIndex];
+				const std::uint32_t IndexOffset = CurIndices.size();
+
+				// Cluster-ranges are within the full-detail level
+				for( ClusterRange& CurClusterRange : std::span(
+						 NewScene.ClusterRanges.begin()
+							 + CurLightmapMesh.ClusterRangeStart,
+						 CurLightmapMesh.ClusterRangeCount
+					 ) )
+				{
+					CurClusterRange.IndexOffset
+						= CurClusterRange.IndexOffset
+						- CurLightmapMesh.IndexOffset + IndexOffset;
+				}
+
+				CurIndices.insert(
+					CurIndices.end(),
+					MergedIndices.begin() + CurLightmapMesh.IndexOffset,
+					MergedIndices.begin() + CurLightmapMesh.IndexOffset
+						+ CurLightmapMesh.IndexCount
+				);
+				CurLightmapMesh.IndexOffset        = IndexOffset;
+				CurLightmapMesh.LODIndexOffsets[0] = IndexOffset;
+
+				for( std::uint32_t LOD = 1; LOD < CurLightmapMesh.LODCount;
+					 ++LOD )
+				{
+					const auto LODBegin = MergedIndices.begin()
+										+ CurLightmapMesh.LODIndexOffsets[LOD];
+					CurLightmapMesh.LODIndexOffsets[LOD] = CurIndices.size();
+					CurIndices.insert(
+						CurIndices.end(), LODBegin,
+						LODBegin + CurLightmapMesh.LODIndexCounts[LOD]
+					);
+				}
+			}
+
+			for( std::size_t GeometryIndex = 0;
+				 GeometryIndex < NewScene.GeometryRegions.size();
+				 ++GeometryIndex )
+			{
+				const std::vector<std::uint32_t>& CurIndices
+					= RegionIndices[GeometryIndex];
+				std::vector<std::byte>& CurIndexData
+					= NewScene.GeometryRegions[GeometryIndex].IndexData;
+
+				if( NewScene.BSPIndexType == vk::IndexType::eUint32 )
+				{
+					const auto IndexBytes
+						= std::as_bytes(std::span(CurIndices));
+					CurIndexData.assign(IndexBytes.begin(), IndexBytes.end());
+				}
+				else
+				{
+					const std::vector<std::uint16_t> CurIndices16(
+						CurIndices.begin(), CurIndices.end()
+					);
+					const auto IndexBytes
+						= std::as_bytes(std::span(CurIndices16));
+					CurIndexData.assign(IndexBytes.begin(), IndexBytes.end());
+				}
+			}
+		}
+
+		// Without a budget, all regions are loaded up-front. Otherwise they
+		// are streamed in by `PrepareRender` once the view approaches them
+		NewScene.StreamGeometry = MergeMeshes && Config.BSPMemoryBudget;
+		for( std::size_t GeometryIndex = 0;
+			 GeometryIndex < NewScene.GeometryRegions.size(); ++GeometryIndex )
+		{
+			GeometryRegion& CurRegion = NewScene.GeometryRegions[GeometryIndex];
+
+			CurRegion.MemorySize
+				= CurRegion.VertexCount
+					* (sizeof(Blam::Vertex) + sizeof(Blam::LightmapVertex))
+				+ CurRegion.IndexData.size()
+				+ CurRegion.Positions.size() * sizeof(glm::f32vec3);
+
+			if( NewScene.StreamGeometry )
+			{
+				continue;
+			}
+
+			if( !NewScene.LoadGeometry(GeometryIndex) )
+			{
+				return {};
+			}
+			CurRegion.Residency = GeometryRegion::State::Resident;
+		}
+
+		// Visible surface compaction
+		if( Config.VisibleSurfaceCompaction != SurfaceCompaction::None )
+		{
+			const bool GPUCompaction
+				= Config.VisibleSurfaceCompaction == SurfaceCompaction::GPU;
+
+			// All surfaces are initially visible
+			for( auto& CurBSPVisibility : NewScene.BSPVisibilities )
+			{
+				CurBSPVisibility.VisibleSurfaces.assign(0x2'0000 / 32, ~0u);
+			}
+
+			// Avoid zero-sized buffers
+			const std::size_t MeshCount
+				= std::max<std::size_t>(NewScene.LightmapMeshs.size(), 1);
+
+			std::vector<vk::Buffer> CompactionBuffers;
+
+			NewScene.VisibleIndexBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice,
+				std::max<std::size_t>(IndexHeapIndexEnd, 1)
+					* (GPUCompaction ? sizeof(std::uint32_t)
+									 : sizeof(std::uint16_t)),
+				vk::BufferUsageFlagBits::eIndexBuffer
+					| (GPUCompaction ? vk::BufferUsageFlagBits::eStorageBuffer
+									 : vk::BufferUsageFlags()),
+				"BSP Visible Index Buffer"
+			);
+			if( !NewScene.VisibleIndexBuffer )
+			{
+				return {};
+			}
+			CompactionBuffers.push_back(NewScene.VisibleIndexBuffer.get());
+
+			if( GPUCompaction )
+			{
+				NewScene.VisibleSurfaceBitsBuffer = CreateSceneBuffer(
+					VulkanContext.LogicalDevice,
+					std::max<std::size_t>(NewScene.BSPVisibilities.size(), 1)
+						* (0x2'0000 / 8),
+					vk::BufferUsageFlagBits::eStorageBuffer,
+					"BSP Visible Surface Bits"
+				);
+				NewScene.CompactionMeshBuffer = CreateSceneBuffer(
+					VulkanContext.LogicalDevice,
+					MeshCount * sizeof(CompactionMesh),
+					vk::BufferUsageFlagBits::eStorageBuffer,
+					"BSP Compaction Meshes"
+				);
+				NewScene.DirtyMeshBuffer = CreateSceneBuffer(
+					VulkanContext.LogicalDevice,
+					MeshCount * sizeof(std::uint32_t),
+					vk::BufferUsageFlagBits::eStorageBuffer,
+					"BSP Compaction Dirty Meshes"
+				);
+				NewScene.VisibleDrawCommandBuffer = CreateSceneBuffer(
+					VulkanContext.LogicalDevice,
+					MeshCount * sizeof(vk::DrawIndexedIndirectCommand),
+					vk::BufferUsageFlagBits::eStorageBuffer
+						| vk::BufferUsageFlagBits::eIndirectBuffer,
+					"BSP Visible Draw Commands"
+				);
+				NewScene.SurfaceIDBuffer = CreateSceneBuffer(
+					VulkanContext.LogicalDevice,
+					std::max<std::size_t>(SortedSurfaceIDs.size(), 1)
+						* sizeof(std::uint32_t),
+					vk::BufferUsageFlagBits::eStorageBuffer,
+					"BSP Surface IDs"
+				);
+
+				if( !NewScene.VisibleSurfaceBitsBuffer
+					|| !NewScene.CompactionMeshBuffer
+					|| !NewScene.DirtyMeshBuffer
+					|| !NewScene.VisibleDrawCommandBuffer
+					|| !NewScene.SurfaceIDBuffer )
+				{
+					return {};
+				}
+				CompactionBuffers.push_back(
+					NewScene.VisibleSurfaceBitsBuffer.get()
+				);
+				CompactionBuffers.push_back(NewScene.CompactionMeshBuffer.get()
+				);
+				CompactionBuffers.push_back(NewScene.DirtyMeshBuffer.get());
+				CompactionBuffers.push_back(
+					NewScene.VisibleDrawCommandBuffer.get()
+				);
+				CompactionBuffers.push_back(NewScene.SurfaceIDBuffer.get());
+			}
+
+			if( auto [Result, Value] = Vulkan::CommitBufferHeap(
+					VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
+					CompactionBuffers
+				);
+				Result == vk::Result::eSuccess )
+			{
+				NewScene.VisibleSurfaceMemory = std::move(Value);
+			}
+			else
+			{
+				std::fprintf(
+					stderr, "Error committing visible-surface memory: %s\n",
+					vk::to_string(Result).c_str()
+				);
+				return {};
+			}
+
+			if( !GPUCompaction )
+			{
+				// The compacted index-buffer of an entirely visible BSP is
+				// identical to the original
+				for( const auto& CurBSPVisibility : NewScene.BSPVisibilities )
+				{
+					TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+						std::as_bytes(CurBSPVisibility.Surfaces),
+						NewScene.VisibleIndexBuffer.get(),
+						CurBSPVisibility.IndexOffset * sizeof(std::uint16_t)
+					);
+				}
+			}
+			else
+			{
+				for( std::size_t BSPIndex = 0;
+					 BSPIndex < NewScene.BSPVisibilities.size(); ++BSPIndex )
+				{
+					TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+						std::as_bytes(std::span(
+							NewScene.BSPVisibilities[BSPIndex].VisibleSurfaces
+						)),
+						NewScene.VisibleSurfaceBitsBuffer.get(),
+						BSPIndex * (0x2'0000 / 8)
+					);
+				}
+
+				std::vector<CompactionMesh> CompactionMeshes;
+				CompactionMeshes.reserve(NewScene.LightmapMeshs.size());
+				for( std::uint32_t MeshIndex = 0;
+					 MeshIndex < NewScene.LightmapMeshs.size(); ++MeshIndex )
+				{
+					const auto& CurLightmapMesh
+						= NewScene.LightmapMeshs[MeshIndex];
+					CompactionMeshes.push_back(CompactionMesh{
+						CurLightmapMesh.BSPIndex,
+						CurLightmapMesh.SurfaceCount,
+						CurLightmapMesh.IndexOffset,
+						static_cast<std::int32_t>(
+							CurLightmapMesh.VertexIndexOffset
+						),
+					});
+
+					// Compact every mesh upon the first frame
+					NewScene.DirtyMeshes.push_back(MeshIndex);
+				}
+
+				TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+					std::as_bytes(std::span(CompactionMeshes)),
+					NewScene.CompactionMeshBuffer.get()
+				);
+
+				TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+					std::as_bytes(std::span(SortedSurfaceIDs)),
+					NewScene.SurfaceIDBuffer.get()
+				);
+
+				// Pipeline
+				const auto CompactSurfacesShaderData
+					= VkBlam::OpenResource("shaders/CompactSurfaces.comp.spv")
+						  .value();
+
+				NewScene.CompactSurfacesShaderModule
+					= TargetRenderer.GetShaderModuleCache()
+						  .GetShaderModule(CompactSurfacesShaderData)
+						  .value();
+
+				NewScene.CompactionDescriptorPool
+					= std::make_unique<Vulkan::DescriptorHeap>(
+						Vulkan::DescriptorHeap::Create(
+							VulkanContext, CompactionBindings, 1
+						)
+							.value()
+					);
+
+				std::tie(
+					NewScene.CompactionPipeline,
+					NewScene.CompactionPipelineLayout
+				)
+					= CreateComputePipeline(
+						VulkanContext.LogicalDevice, PipelineCache, {},
+						{{NewScene.CompactionDescriptorPool
+							  ->GetDescriptorSetLayout()}},
+						NewScene.CompactSurfacesShaderModule
+					);
+
+				NewScene.CompactionDescriptor
+					= NewScene.CompactionDescriptorPool->AllocateDescriptorSet()
+						  .value();
+
+				Vulkan::DescriptorUpdateBatch& DescriptorUpdateBatch
+					= TargetRenderer.GetDescriptorUpdateBatch();
+				DescriptorUpdateBatch.AddBuffer(
+					NewScene.CompactionDescriptor, 0,
+					NewScene.VisibleSurfaceBitsBuffer.get(), 0
+				);
+				DescriptorUpdateBatch.AddBuffer(
+					NewScene.CompactionDescriptor, 1,
+					NewScene.GeometryRegions[0].Buffers.IndexBuffer.get(), 0
+				);
+				DescriptorUpdateBatch.AddBuffer(
+					NewScene.CompactionDescriptor, 2,
+					NewScene.CompactionMeshBuffer.get(), 0
+				);
+				DescriptorUpdateBatch.AddBuffer(
+					NewScene.CompactionDescriptor, 3,
+					NewScene.VisibleIndexBuffer.get(), 0
+				);
+				DescriptorUpdateBatch.AddBuffer(
+					NewScene.CompactionDescriptor, 4,
+					NewScene.VisibleDrawCommandBuffer.get(), 0
+				);
+				DescriptorUpdateBatch.AddBuffer(
+					NewScene.CompactionDescriptor, 5,
+					NewScene.DirtyMeshBuffer.get(), 0
+				);
+				DescriptorUpdateBatch.AddBuffer(
+					NewScene.CompactionDescriptor, 6,
+					NewScene.SurfaceIDBuffer.get(), 0
+				);
+			}
+		}
+	}
+
+	// Load bitmaps
+	{
+
+		// Create image handles
+		const auto CreateBitmapImage
+			= [&](VkBlam::BitmapHeapT::Bitmap&                   TargetBitmap,
+				  Blam::Tag<Blam::TagClass::Bitmap>::BitmapEntry BitmapEntry
+			  ) -> bool {
+			vk::ImageCreateInfo ImageInfo = {};
+			ImageInfo.imageType           = VkBlam::BlamToVk(BitmapEntry.Type);
+			ImageInfo.format = VkBlam::BlamToVk(BitmapEntry.Format);
+			ImageInfo.extent = vk::Extent3D(
+				BitmapEntry.Width, BitmapEntry.Height, BitmapEntry.Depth
+			);
+			ImageInfo.mipLevels
+				= std::max<std::uint16_t>(BitmapEntry.MipmapCount, 1);
+			ImageInfo.arrayLayers
+				= BitmapEntry.Type == Blam::BitmapEntryType::CubeMap ? 6 : 1;
+			ImageInfo.samples = vk::SampleCountFlagBits::e1;
+			ImageInfo.tiling  = vk::ImageTiling::eOptimal;
+			ImageInfo.usage   = vk::ImageUsageFlagBits::eSampled
+							| vk::ImageUsageFlagBits::eTransferDst
+							| vk::ImageUsageFlagBits::eTransferSrc;
+			ImageInfo.sharingMode   = vk::SharingMode::eExclusive;
+			ImageInfo.initialLayout = vk::ImageLayout::eUndefined;
+
+			if( BitmapEntry.Type == Blam::BitmapEntryType::CubeMap )
+			{
+				ImageInfo.flags = vk::ImageCreateFlagBits::eCubeCompatible;
+			}
+
+			auto& ImageDest = TargetBitmap.Image;
+
+			if( auto CreateResult
+				= VulkanContext.LogicalDevice.createImageUnique(ImageInfo);
+				CreateResult.result == vk::Result::eSuccess )
+			{
+				ImageDest = std::move(CreateResult.value);
+			}
+			else
+			{
+				std::fprintf(
+					stderr, "Error creating image: %s\n",
+					vk::to_string(CreateResult.result).c_str()
+				);
+				return false;
+			}
+			return true;
+		};
+
+		const auto CreateBitmap
+			= [&](const Blam::TagIndexEntry&               TagEntry,
+				  const Blam::Tag<Blam::TagClass::Bitmap>& Bitmap,
+				  const Blam::MapFile&                     Map) -> void {
+			// std::printf("%s\n",
+			// CurWorld.GetMapFile().GetTagName(TagEntry.TagID).data());
+			for( std::size_t CurSubTextureIdx = 0;
+				 CurSubTextureIdx < Bitmap.Bitmaps.Count; ++CurSubTextureIdx )
+			{
+				const auto& CurSubTexture
+					= Map.TagHeap.GetBlock(Bitmap.Bitmaps)[CurSubTextureIdx];
+
+				auto& BitmapDest
+					= NewScene.BitmapHeap
+						  .Bitmaps[TagEntry.TagID][CurSubTextureIdx];
+
+				CreateBitmapImage(BitmapDest, CurSubTexture);
+
+				Vulkan::SetObjectName(
+					VulkanContext.LogicalDevice, BitmapDest.Image.get(),
+					"VkBlam::Scene: Bitmap %08X[%2zu] | %s", TagEntry.TagID,
+					CurSubTextureIdx, Map.GetTagName(TagEntry.TagID).data()
+				);
+			}
+		};
+
+		Blam::TagVisitorProc& BitmapLoader = TagVisitors.emplace_back();
+
+		BitmapLoader.VisitClass = Blam::TagClass::Bitmap;
+
+		BitmapLoader.VisitTags
+			= [&](std::span<const Blam::TagIndexEntry> TagIndexEntries,
+				  const Blam::MapFile&                 Map) -> void {
+			for( const auto& TagIndexEntry : TagIndexEntries )
+			{
+				const auto& CurBitmap
+					= Map.GetTag<Blam::TagClass::Bitmap>(TagIndexEntry.TagID);
+				CreateBitmap(TagIndexEntry, *CurBitmap, Map);
+			}
+		};
+
+		BitmapLoader.EndVisits = [&](const Blam::MapFile& Map) -> void {
+			Map.VisitTagClass<Blam::TagClass::Globals>(
+				[&](const Blam::TagIndexEntry&                TagEntry,
+					const Blam::Tag<Blam::TagClass::Globals>& Globals) -> void {
+					const auto& CurGlobal = Globals;
+					for( const auto& RasterData :
+						 TargetWorld.GetMapFile().TagHeap.GetBlock(
+							 CurGlobal.RasterizerData
+						 ) )
+					{
+						NewScene.BitmapHeap.Default2D
+							= RasterData.Default2D.TagID;
+						NewScene.BitmapHeap.Default3D
+							= RasterData.Default3D.TagID;
+						NewScene.BitmapHeap.DefaultCube
+							= RasterData.DefaultCube.TagID;
+					}
+				}
+			);
+		};
+
+		Blam::TagVisitorProc& BitmapCommitter = TagVisitors.emplace_back();
+
+		BitmapCommitter.VisitClass = Blam::TagClass::Bitmap;
+
+		// Allocate and bind memory for all bitmaps
+		BitmapCommitter.BeginVisits = [&](const Blam::MapFile& Map) -> void {
+			std::vector<vk::Image> Bitmaps;
+			for( const auto& CurBitmap : NewScene.BitmapHeap.Bitmaps )
+			{
+				for( const auto& CurSubBitmap : CurBitmap.second )
+				{
+					Bitmaps.emplace_back(CurSubBitmap.second.Image.get());
+				}
+			}
+
+			if( auto [Result, Value] = Vulkan::CommitImageHeap(
+					VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
+					Bitmaps
+				);
+				Result == vk::Result::eSuccess )
+			{
+				NewScene.BitmapHeapMemory = std::move(Value);
+			}
+			else
+			{
+				std::fprintf(
+					stderr, "Error committing bitmap memory: %s\n",
+					vk::to_string(Result).c_str()
+				);
+				return;
+			}
+		};
+
+		// All images are now created and binded to memory
+		{
+			// Todo: This would be the draft of a bitmap manager's stream
+			// function
+			const auto StreamBitmapImage =
+				[&](VkBlam::BitmapHeapT::Bitmap&                   TargetBitmap,
+					Blam::Tag<Blam::TagClass::Bitmap>::BitmapEntry BitmapEntry,
+					std::span<const std::byte> PixelData) -> bool {
+				// Upload image data
+				const std::size_t MipCount
+					= std::max<std::uint16_t>(BitmapEntry.MipmapCount, 1);
+				const std::size_t LayerCount
+					= BitmapEntry.Type == Blam::BitmapEntryType::CubeMap ? 6
+																		 : 1;
+
+				const std::size_t BlockSize
+					= vk::blockSize(VkBlam::BlamToVk(BitmapEntry.Format));
+				const std::array<std::uint8_t, 3> BlockExtent
+					= vk::blockExtent(VkBlam::BlamToVk(BitmapEntry.Format));
+
+				std::size_t PixelDataOff = 0;
 
 				auto CurExtent = vk::Extent3D(
 					BitmapEntry.Width, BitmapEntry.Height, BitmapEntry.Depth
 				);
-				for( std::size_t CurMip = 0; CurMip < MipCount; ++CurMip )
+				for( std::size_t CurMip = 0; CurMip < MipCount; ++CurMip )
+				{
+					for( std::size_t CurLayer = 0; CurLayer < LayerCount;
+						 ++CurLayer )
+					{
+						const std::array<std::uint32_t, 3> CurBlockCount
+							= {std::max(1u, CurExtent.width / BlockExtent[0]),
+							   std::max(1u, CurExtent.height / BlockExtent[1]),
+							   std::max(1u, CurExtent.depth / BlockExtent[2])};
+
+						const std::size_t CurPixelDataSize
+							= CurBlockCount[0] * CurBlockCount[1]
+							* CurBlockCount[2] * BlockSize;
+
+						TargetRenderer.GetStreamBuffer().QueueImageUpload(
+							PixelData.subspan(PixelDataOff, CurPixelDataSize),
+							TargetBitmap.Image.get(), vk::Offset3D(0, 0, 0),
+							CurExtent,
+							vk::ImageSubresourceLayers(
+								vk::ImageAspectFlagBits::eColor, CurMip,
+								CurLayer, 1
+							)
+						);
+
+						PixelDataOff += CurPixelDataSize;
+					}
+
+					CurExtent.width  = std::max(1u, CurExtent.width / 2);
+					CurExtent.height = std::max(1u, CurExtent.height / 2);
+					CurExtent.depth  = std::max(1u, CurExtent.depth / 2);
+				}
+
+				// Create image view
+				vk::ImageViewCreateInfo BitmapImageViewInfo = {};
+				BitmapImageViewInfo.image = TargetBitmap.Image.get();
+				switch( BitmapEntry.Type )
+				{
+				default:
+				case Blam::BitmapEntryType::Texture2D:
+				{
+					BitmapImageViewInfo.viewType = vk::ImageViewType::e2D;
+					break;
+				}
+				case Blam::BitmapEntryType::Texture3D:
+				{
+					BitmapImageViewInfo.viewType = vk::ImageViewType::e3D;
+					break;
+				}
+				case Blam::BitmapEntryType::CubeMap:
+				{
+					BitmapImageViewInfo.viewType = vk::ImageViewType::eCube;
+					break;
+				}
+				}
+				BitmapImageViewInfo.format
+					= VkBlam::BlamToVk(BitmapEntry.Format);
+				;
+				BitmapImageViewInfo.components.r = vk::ComponentSwizzle::eR;
+				BitmapImageViewInfo.components.g = vk::ComponentSwizzle::eG;
+				BitmapImageViewInfo.components.b = vk::ComponentSwizzle::eB;
+				BitmapImageViewInfo.components.a = vk::ComponentSwizzle::eA;
+				BitmapImageViewInfo.subresourceRange.aspectMask
+					= vk::ImageAspectFlagBits::eColor;
+				BitmapImageViewInfo.subresourceRange.baseMipLevel   = 0;
+				BitmapImageViewInfo.subresourceRange.levelCount     = MipCount;
+				BitmapImageViewInfo.subresourceRange.baseArrayLayer = 0;
+				BitmapImageViewInfo.subresourceRange.layerCount = LayerCount;
+
+				if( auto CreateResult
+					= VulkanContext.LogicalDevice.createImageViewUnique(
+						BitmapImageViewInfo
+					);
+					CreateResult.result == vk::Result::eSuccess )
+				{
+					TargetBitmap.View     = std::move(CreateResult.value);
+					TargetBitmap.ViewType = BitmapImageViewInfo.viewType;
+				}
+				else
+				{
+					std::fprintf(
+						stderr, "Error bitmap view: %s\n",
+						vk::to_string(CreateResult.result).c_str()
+					);
+					return false;
+				}
+				return true;
+			};
+
+			const auto StreamBitmap
+				= [&](const Blam::TagIndexEntry&               TagEntry,
+					  const Blam::Tag<Blam::TagClass::Bitmap>& Bitmap) -> void {
+				for( std::size_t CurSubTextureIdx = 0;
+					 CurSubTextureIdx < Bitmap.Bitmaps.Count;
+					 ++CurSubTextureIdx )
+				{
+					const auto& CurSubTexture
+						= TargetWorld.GetMapFile().TagHeap.GetBlock(
+							Bitmap.Bitmaps
+						)[CurSubTextureIdx];
+					const auto PixelData = std::span<const std::byte>(
+						reinterpret_cast<const std::byte*>(
+							TargetWorld.GetMapFile().GetBitmapData().data()
+						) + CurSubTexture.PixelDataOffset,
+						CurSubTexture.PixelDataSize
+					);
+
+					auto& BitmapDest
+						= NewScene.BitmapHeap
+							  .Bitmaps[TagEntry.TagID][CurSubTextureIdx];
+
+					StreamBitmapImage(BitmapDest, CurSubTexture, PixelData);
+
+					Vulkan::SetObjectName(
+						VulkanContext.LogicalDevice, BitmapDest.View.get(),
+						"VkBlam::Scene: Bitmap View %08X[%2zu] | %s",
+						TagEntry.TagID, CurSubTextureIdx,
+						TargetWorld.GetMapFile()
+							.GetTagName(TagEntry.TagID)
+							.data()
+					);
+
+					// All bitmaps are within the single bindless descriptor-set
+					if( Config.BindlessTextures )
+					{
+						continue;
+					}
+
+					// Create descriptor set
+					vk::DescriptorSet& TargetSet
+						= NewScene.BitmapHeap
+							  .Sets[TagEntry.TagID][CurSubTextureIdx];
+
+					if( auto NewSet = NewScene.DebugDrawDescriptorPool
+										  ->AllocateDescriptorSet();
+						NewSet )
+					{
+						TargetSet = NewSet.value();
+					}
+					else
+					{
+						std::fprintf(
+							stderr, "Error allocating bitmap descriptor set\n"
+						);
+						return;
+					}
+
+					Vulkan::SetObjectName(
+						VulkanContext.LogicalDevice, TargetSet,
+						"VkBlam::Scene: Bitmap Descriptor Set %08X[%2zu] | %s",
+						TagEntry.TagID, CurSubTextureIdx,
+						TargetWorld.GetMapFile()
+							.GetTagName(TagEntry.TagID)
+							.data()
+					);
+
+					TargetRenderer.GetDescriptorUpdateBatch().AddImage(
+						TargetSet, 0, BitmapDest.View.get(),
+						vk::ImageLayout::eShaderReadOnlyOptimal
+					);
+				}
+			};
+
+			BitmapCommitter.VisitTags
+				= [&](std::span<const Blam::TagIndexEntry> TagIndexEntries,
+					  const Blam::MapFile&                 Map) -> void {
+				for( const auto& TagIndexEntry : TagIndexEntries )
+				{
+					const auto& CurBitmap
+						= Map.GetTag<Blam::TagClass::Bitmap>(TagIndexEntry.TagID
+						);
+					StreamBitmap(TagIndexEntry, *CurBitmap);
+				}
+			};
+		}
+	}
+
+	// Create Shader-Environment descriptor sets. Bindless materials are
+	// created once all bitmaps are loaded
+	if( !Config.BindlessTextures )
+	{
+		const auto CreateShaderEnvironmentDescriptor
+			= [&](const Blam::TagIndexEntry& TagEntry,
+				  const Blam::Tag<Blam::TagClass::ShaderEnvironment>&
+					  ShaderEnvironment) -> void {
+			const vk::DescriptorSet NewSet
+				= NewScene.ShaderEnvironmentDescriptorPool
+					  ->AllocateDescriptorSet()
+					  .value();
+			NewScene.ShaderEnvironmentDescriptors[TagEntry.TagID] = NewSet;
+
+			Vulkan::SetObjectName(
+				VulkanContext.LogicalDevice, NewSet,
+				"senv: %08X \'%s\' Descriptor Set", TagEntry.TagID,
+				TargetWorld.GetMapFile().GetTagName(TagEntry.TagID).data()
+			);
+
+			const vk::ImageView BaseMapView
+				= (ShaderEnvironment.BaseMap.Valid()
+					   ? NewScene.BitmapHeap.Bitmaps
+							 .at(ShaderEnvironment.BaseMap.TagID)
+							 .at(0)
+					   : NewScene.BitmapHeap.Bitmaps
+							 .at(NewScene.BitmapHeap.Default2D)
+							 .at(std::uint32_t(
+								 Blam::DefaultTextureIndex::Multiplicative
+							 )))
+					  .View.get();
+			const vk::ImageView PrimaryDetailMapView
+				= (ShaderEnvironment.PrimaryDetailMap.Valid()
+					   ? NewScene.BitmapHeap.Bitmaps
+							 .at(ShaderEnvironment.PrimaryDetailMap.TagID)
+							 .at(0)
+					   : NewScene.BitmapHeap.Bitmaps
+							 .at(NewScene.BitmapHeap.Default2D)
+							 .at(0))
+					  .View.get();
+			const vk::ImageView SecondaryDetailMapView
+				= (ShaderEnvironment.SecondaryDetailMap.Valid()
+					   ? NewScene.BitmapHeap.Bitmaps
+							 .at(ShaderEnvironment.SecondaryDetailMap.TagID)
+							 .at(0)
+					   : NewScene.BitmapHeap.Bitmaps
+							 .at(NewScene.BitmapHeap.Default2D)
+							 .at(0))
+					  .View.get();
+			const vk::ImageView MicroDetailMapView
+				= (ShaderEnvironment.MicroDetailMap.Valid()
+					   ? NewScene.BitmapHeap.Bitmaps
+							 .at(ShaderEnvironment.MicroDetailMap.TagID)
+							 .at(0)
+					   : NewScene.BitmapHeap.Bitmaps
+							 .at(NewScene.BitmapHeap.Default2D)
+							 .at(0))
+					  .View.get();
+			const vk::ImageView BumpMapView
+				= (ShaderEnvironment.BumpMap.Valid()
+					   ? NewScene.BitmapHeap.Bitmaps
+							 .at(ShaderEnvironment.BumpMap.TagID)
+							 .at(0)
+					   : NewScene.BitmapHeap.Bitmaps
+							 .at(NewScene.BitmapHeap.Default2D)
+							 .at(std::uint32_t(Blam::DefaultTextureIndex::Vector
+							 )))
+					  .View.get();
+			const vk::ImageView GlowMapView
+				= (ShaderEnvironment.GlowMap.Valid()
+					   ? NewScene.BitmapHeap.Bitmaps
+							 .at(ShaderEnvironment.GlowMap.TagID)
+							 .at(0)
+					   : NewScene.BitmapHeap.Bitmaps
+							 .at(NewScene.BitmapHeap.Default2D)
+							 .at(std::uint32_t(
+								 Blam::DefaultTextureIndex::Additive
+							 )))
+					  .View.get();
+			const vk::ImageView ReflectionCubeMapView
+				= (ShaderEnvironment.ReflectionCubeMap.Valid()
+					   ? NewScene.BitmapHeap.Bitmaps
+							 .at(ShaderEnvironment.ReflectionCubeMap.TagID)
+							 .at(0)
+					   : NewScene.BitmapHeap.Bitmaps
+							 .at(NewScene.BitmapHeap.DefaultCube)
+							 .at(0))
+					  .View.get();
+
+			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
+				NewSet, 0, BaseMapView, vk::ImageLayout::eShaderReadOnlyOptimal
+			);
+			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
+				NewSet, 1, PrimaryDetailMapView,
+				vk::ImageLayout::eShaderReadOnlyOptimal
+			);
+			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
+				NewSet, 2, SecondaryDetailMapView,
+				vk::ImageLayout::eShaderReadOnlyOptimal
+			);
+			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
+				NewSet, 3, MicroDetailMapView,
+				vk::ImageLayout::eShaderReadOnlyOptimal
+			);
+			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
+				NewSet, 4, BumpMapView, vk::ImageLayout::eShaderReadOnlyOptimal
+			);
+			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
+				NewSet, 5, GlowMapView, vk::ImageLayout::eShaderReadOnlyOptimal
+			);
+			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
+				NewSet, 6, ReflectionCubeMapView,
+				vk::ImageLayout::eShaderReadOnlyOptimal
+			);
+		};
+
+		Blam::TagVisitorProc& ShaderEnvironmentProc
+			= TagVisitors.emplace_back();
+
+		ShaderEnvironmentProc.VisitClass = Blam::TagClass::ShaderEnvironment;
+
+		ShaderEnvironmentProc.DependClasses
+			= {// Wait for bitmap loaders to finish
+			   Blam::TagClass::Bitmap};
+
+		ShaderEnvironmentProc.VisitTags
+			= [&](std::span<const Blam::TagIndexEntry> TagIndexEntries,
+				  const Blam::MapFile&                 Map) -> void {
+			for( const auto& TagIndexEntry : TagIndexEntries )
+			{
+				const auto& CurShader
+					= Map.GetTag<Blam::TagClass::ShaderEnvironment>(
+						TagIndexEntry.TagID
+					);
+				CreateShaderEnvironmentDescriptor(TagIndexEntry, *CurShader);
+			}
+		};
+	}
+
+	Blam::DispatchTagVisitors(TagVisitors, TargetWorld.GetMapFile());
+
+	// Material table
+	{
+		const Blam::MapFile& Map = TargetWorld.GetMapFile();
+
+		// Each shader-environment gets a slot within the table. Slot 0 is
+		// used by meshes without one
+		std::vector<const Blam::TagIndexEntry*> ShaderEntries = {nullptr};
+		std::unordered_map<std::uint32_t, std::uint32_t> ShaderSlots;
+		for( const auto& CurTagEntry : Map.GetTagIndexArray() )
+		{
+			if( CurTagEntry.ClassPrimary == Blam::TagClass::ShaderEnvironment )
+			{
+				ShaderSlots[CurTagEntry.TagID] = ShaderEntries.size();
+				ShaderEntries.push_back(&CurTagEntry);
+			}
+		}
+
+		std::vector<MaterialParameters> MaterialTable(ShaderEntries.size());
+
+		LoadWorkers.ParallelFor(
+			MaterialTable.size(),
+			[&](std::size_t Slot) -> void {
+				if( ShaderEntries[Slot] == nullptr )
+				{
+					MaterialTable[Slot] = DefaultMaterialParameters();
+					return;
+				}
+
+				MaterialTable[Slot] = FlattenShaderEnvironment(
+					*Map.GetTag<Blam::TagClass::ShaderEnvironment>(
+						ShaderEntries[Slot]->TagID
+					)
+				);
+			}
+		);
+
+		std::vector<std::uint32_t> MeshMaterialIndices;
+		MeshMaterialIndices.reserve(NewScene.LightmapMeshs.size());
+		for( auto& CurLightmapMesh : NewScene.LightmapMeshs )
+		{
+			const auto ShaderSlot = ShaderSlots.find(CurLightmapMesh.ShaderTag);
+			const std::uint32_t MaterialIndex
+				= ShaderSlot != ShaderSlots.end() ? ShaderSlot->second : 0;
+			MeshMaterialIndices.push_back(MaterialIndex);
+
+			CurLightmapMesh.AlphaTested
+				= MaterialTable[MaterialIndex].ShaderFlags
+				& std::uint32_t(Blam::Tag<Blam::TagClass::ShaderEnvironment>::
+									ShaderBitFlags::AlphaTested);
+		}
+
+		NewScene.MaterialTableBuffer = CreateSceneBuffer(
+			VulkanContext.LogicalDevice,
+			MaterialTable.size() * sizeof(MaterialParameters),
+			vk::BufferUsageFlagBits::eStorageBuffer, "Material Table"
+		);
+		NewScene.MeshMaterialIndexBuffer = CreateSceneBuffer(
+			VulkanContext.LogicalDevice,
+			std::max<std::size_t>(MeshMaterialIndices.size(), 1)
+				* sizeof(std::uint32_t),
+			vk::BufferUsageFlagBits::eStorageBuffer, "Mesh Material Indices"
+		);
+		if( !NewScene.MaterialTableBuffer || !NewScene.MeshMaterialIndexBuffer )
+		{
+			return {};
+		}
+
+		if( auto [Result, Value] = Vulkan::CommitBufferHeap(
+				VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
+				std::array{
+					NewScene.MaterialTableBuffer.get(),
+					NewScene.MeshMaterialIndexBuffer.get()
+				}
+			);
+			Result == vk::Result::eSuccess )
+		{
+			NewScene.MaterialTableMemory = std::move(Value);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error committing material table memory: %s\n",
+				vk::to_string(Result).c_str()
+			);
+			return {};
+		}
+
+		TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+			std::as_bytes(std::span(MaterialTable)),
+			NewScene.MaterialTableBuffer.get()
+		);
+		TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+			std::as_bytes(std::span(MeshMaterialIndices)),
+			NewScene.MeshMaterialIndexBuffer.get()
+		);
+
+		TargetRenderer.GetDescriptorUpdateBatch().AddBuffer(
+			NewScene.CurSceneDescriptor, 4, NewScene.MaterialTableBuffer.get(),
+			0
+		);
+		TargetRenderer.GetDescriptorUpdateBatch().AddBuffer(
+			NewScene.CurSceneDescriptor, 5,
+			NewScene.MeshMaterialIndexBuffer.get(), 0
+		);
+	}
+
+	// Index of each bitmap within the 2D bitmaps of the bindless textures,
+	// also used by the decals
+	using BitmapKey = std::pair<std::uint32_t, std::uint16_t>;
+	std::map<BitmapKey, std::uint32_t> Bitmap2DIndices;
+
+	// Bindless textures
+	if( Config.BindlessTextures )
+	{
+		const Blam::MapFile& Map = TargetWorld.GetMapFile();
+
+		// Assign each bitmap an index within the array of its view-type
+		std::map<BitmapKey, std::uint32_t> BitmapCubeIndices;
+		std::vector<vk::ImageView>         Bitmap2DViews;
+		std::vector<vk::ImageView>         BitmapCubeViews;
+
+		for( const auto& [TagID, SubBitmaps] : NewScene.BitmapHeap.Bitmaps )
+		{
+			for( const auto& [SubBitmapIndex, CurBitmap] : SubBitmaps )
+			{
+				if( !CurBitmap.View )
+				{
+					continue;
+				}
+
+				switch( CurBitmap.ViewType )
+				{
+				case vk::ImageViewType::e2D:
+				{
+					Bitmap2DIndices[{TagID, SubBitmapIndex}]
+						= Bitmap2DViews.size();
+					Bitmap2DViews.push_back(CurBitmap.View.get());
+					break;
+				}
+				case vk::ImageViewType::eCube:
+				{
+					BitmapCubeIndices[{TagID, SubBitmapIndex}]
+						= BitmapCubeViews.size();
+					BitmapCubeViews.push_back(CurBitmap.View.get());
+					break;
+				}
+				default:
+				{
+					break;
+				}
+				}
+			}
+		}
+
+		const auto GetBitmapIndex
+			= [](const std::map<BitmapKey, std::uint32_t>& Indices,
+				 std::uint32_t TagID, std::uint16_t SubBitmapIndex
+			  ) -> std::uint32_t {
+			const auto Found = Indices.find({TagID, SubBitmapIndex});
+			return Found != Indices.end() ? Found->second : 0;
+		};
+
+		// Same defaults as the shader-environment descriptor-sets
+		const auto Get2DIndex
+			= [&](const Blam::TagReference* Bitmap,
+				  Blam::DefaultTextureIndex DefaultIndex) -> std::uint32_t {
+			return (Bitmap && Bitmap->Valid())
+					 ? GetBitmapIndex(Bitmap2DIndices, Bitmap->TagID, 0)
+					 : GetBitmapIndex(
+						   Bitmap2DIndices, NewScene.BitmapHeap.Default2D,
+						   std::uint16_t(DefaultIndex)
+					   );
+		};
+
+		std::vector<BindlessMaterial> Materials;
+		Materials.reserve(NewScene.LightmapMeshs.size());
+		for( const auto& CurLightmapMesh : NewScene.LightmapMeshs )
+		{
+			BindlessMaterial& CurMaterial = Materials.emplace_back();
+
+			// Meshes without a shader-environment use the default bitmaps
+			const Blam::Tag<Blam::TagClass::ShaderEnvironment>* Shader
+				= nullptr;
+			if( const Blam::TagIndexEntry* ShaderEntry = Map.GetTagIndexEntry(
+					std::uint16_t(CurLightmapMesh.ShaderTag)
+				);
+				ShaderEntry
+				&& ShaderEntry->ClassPrimary
+					   == Blam::TagClass::ShaderEnvironment )
+			{
+				Shader = Map.GetTag<Blam::TagClass::ShaderEnvironment>(
+					CurLightmapMesh.ShaderTag
+				);
+			}
+
+			CurMaterial.BaseMap = Get2DIndex(
+				Shader ? &Shader->BaseMap : nullptr,
+				Blam::DefaultTextureIndex::Multiplicative
+			);
+			CurMaterial.PrimaryDetailMap = Get2DIndex(
+				Shader ? &Shader->PrimaryDetailMap : nullptr,
+				Blam::DefaultTextureIndex::Additive
+			);
+			CurMaterial.SecondaryDetailMap = Get2DIndex(
+				Shader ? &Shader->SecondaryDetailMap : nullptr,
+				Blam::DefaultTextureIndex::Additive
+			);
+			CurMaterial.MicroDetailMap = Get2DIndex(
+				Shader ? &Shader->MicroDetailMap : nullptr,
+				Blam::DefaultTextureIndex::Additive
+			);
+			CurMaterial.BumpMap = Get2DIndex(
+				Shader ? &Shader->BumpMap : nullptr,
+				Blam::DefaultTextureIndex::Vector
+			);
+			CurMaterial.GlowMap = Get2DIndex(
+				Shader ? &Shader->GlowMap : nullptr,
+				Blam::DefaultTextureIndex::Additive
+			);
+			CurMaterial.ReflectionCubeMap = GetBitmapIndex(
+				BitmapCubeIndices,
+				(Shader && Shader->ReflectionCubeMap.Valid())
+					? Shader->ReflectionCubeMap.TagID
+					: NewScene.BitmapHeap.DefaultCube,
+				0
+			);
+
+			if( CurLightmapMesh.LightmapTag.has_value()
+				&& CurLightmapMesh.LightmapIndex.has_value() )
+			{
+				CurMaterial.LightmapMap = GetBitmapIndex(
+					Bitmap2DIndices, CurLightmapMesh.LightmapTag.value(),
+					CurLightmapMesh.LightmapIndex.value()
+				);
+			}
+			else
+			{
+				CurMaterial.LightmapMap = GetBitmapIndex(
+					Bitmap2DIndices, NewScene.BitmapHeap.Default2D,
+					std::uint16_t(Blam::DefaultTextureIndex::Multiplicative)
+				);
+			}
+		}
+
+		// Descriptor set
+		const std::array BindlessBindings = {
+			vk::DescriptorSetLayoutBinding(
+				0, vk::DescriptorType::eSampledImage,
+				std::max<std::uint32_t>(Bitmap2DViews.size(), 1),
+				vk::ShaderStageFlagBits::eFragment
+			),
+			vk::DescriptorSetLayoutBinding(
+				1, vk::DescriptorType::eSampledImage,
+				std::max<std::uint32_t>(BitmapCubeViews.size(), 1),
+				vk::ShaderStageFlagBits::eFragment
+			),
+			vk::DescriptorSetLayoutBinding(
+				2, vk::DescriptorType::eStorageBuffer, 1,
+				vk::ShaderStageFlagBits::eFragment
+			),
+		};
+
+		NewScene.BindlessDescriptorPool
+			= std::make_unique<Vulkan::DescriptorHeap>(
+				Vulkan::DescriptorHeap::Create(
+					VulkanContext, BindlessBindings, 1
+				)
+					.value()
+			);
+		NewScene.BindlessDescriptor
+			= NewScene.BindlessDescriptorPool->AllocateDescriptorSet().value();
+
+		Vulkan::SetObjectName(
+			VulkanContext.LogicalDevice, NewScene.BindlessDescriptor,
+			"VkBlam::Scene: Bindless Descriptor Set( %zu 2D | %zu Cube )",
+			Bitmap2DViews.size(), BitmapCubeViews.size()
+		);
+
+		Vulkan::DescriptorUpdateBatch& DescriptorUpdateBatch
+			= TargetRenderer.GetDescriptorUpdateBatch();
+		for( std::uint32_t i = 0; i < Bitmap2DViews.size(); ++i )
+		{
+			DescriptorUpdateBatch.AddImage(
+				NewScene.BindlessDescriptor, 0, Bitmap2DViews[i],
+				vk::ImageLayout::eShaderReadOnlyOptimal, i
+			);
+		}
+		for( std::uint32_t i = 0; i < BitmapCubeViews.size(); ++i )
+		{
+			DescriptorUpdateBatch.AddImage(
+				NewScene.BindlessDescriptor, 1, BitmapCubeViews[i],
+				vk::ImageLayout::eShaderReadOnlyOptimal, i
+			);
+		}
+
+		// Materials
+		NewScene.BindlessMaterialBuffer = CreateSceneBuffer(
+			VulkanContext.LogicalDevice,
+			std::max<std::size_t>(Materials.size(), 1)
+				* sizeof(BindlessMaterial),
+			vk::BufferUsageFlagBits::eStorageBuffer, "Bindless Materials"
+		);
+		if( !NewScene.BindlessMaterialBuffer )
+		{
+			return {};
+		}
+
+		if( auto [Result, Value] = Vulkan::CommitBufferHeap(
+				VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
+				std::array{NewScene.BindlessMaterialBuffer.get()}
+			);
+			Result == vk::Result::eSuccess )
+		{
+			NewScene.BindlessMaterialMemory = std::move(Value);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error committing bindless material memory: %s\n",
+				vk::to_string(Result).c_str()
+			);
+			return {};
+		}
+
+		TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+			std::as_bytes(std::span(Materials)),
+			NewScene.BindlessMaterialBuffer.get()
+		);
+
+		DescriptorUpdateBatch.AddBuffer(
+			NewScene.BindlessDescriptor, 2,
+			NewScene.BindlessMaterialBuffer.get(), 0
+		);
+
+		// Pipeline
+		const auto BindlessFragShaderData
+			= VkBlam::OpenResource("shaders/DefaultBindless.frag.spv").value();
+
+		NewScene.BindlessFragmentShaderModule
+			= TargetRenderer.GetShaderModuleCache()
+				  .GetShaderModule(BindlessFragShaderData)
+				  .value();
+
+		const auto [VertexBindingDescriptions, VertexAttributeDescriptions]
+			= VkBlam::GetVertexInputDescriptions({{
+				Blam::VertexFormat::SBSPVertexUncompressed,
+				Blam::VertexFormat::SBSPLightmapVertexUncompressed,
+			}});
+
+		std::tie(
+			NewScene.BindlessDrawPipeline, NewScene.BindlessDrawPipelineLayout
+		)
+			= CreateGraphicsPipeline(
+				VulkanContext.LogicalDevice, PipelineCache, {},
+				{{NewScene.SceneDescriptorPool->GetDescriptorSetLayout(),
+				  NewScene.BindlessDescriptorPool->GetDescriptorSetLayout()}},
+				NewScene.DefaultVertexShaderModule,
+				NewScene.BindlessFragmentShaderModule,
+				VertexBindingDescriptions, VertexAttributeDescriptions,
+				TargetRenderer.GetDefaultRenderPass(RenderSamples),
+				RenderSamples, vk::PolygonMode::eFill
+			);
+
+		if( Config.DepthPrepass )
+		{
+			// Shares the layout of `BindlessDrawPipeline`
+			std::tie(NewScene.BindlessDrawDepthEqualPipeline, std::ignore)
+				= CreateGraphicsPipeline(
+					VulkanContext.LogicalDevice, PipelineCache, {},
+					{{NewScene.SceneDescriptorPool->GetDescriptorSetLayout(),
+					  NewScene.BindlessDescriptorPool
+						  ->GetDescriptorSetLayout()}},
+					NewScene.DefaultVertexShaderModule,
+					NewScene.BindlessFragmentShaderModule,
+					VertexBindingDescriptions, VertexAttributeDescriptions,
+					TargetRenderer.GetDefaultRenderPass(RenderSamples),
+					RenderSamples, vk::PolygonMode::eFill,
+					vk::CompareOp::eEqual, false
+				);
+		}
+	}
+
+	// Variants of `DebugDrawPipeline` that are specialized for the features
+	// of each shader-environment. They compile in the background while the
+	// draws use the generic pipeline, so loading never waits on them
+	Vulkan::PipelineRegistry& PipelineRegistry
+		= TargetRenderer.GetPipelineRegistry();
+
+	Vulkan::GraphicsPipelineState MaterialState = {};
+	if( !Config.BindlessTextures )
+	{
+		const auto [VertexBindingDescriptions, VertexAttributeDescriptions]
+			= VkBlam::GetVertexInputDescriptions({{
+				Blam::VertexFormat::SBSPVertexUncompressed,
+				Blam::VertexFormat::SBSPLightmapVertexUncompressed,
+			}});
+
+		MaterialState.Layout        = NewScene.DebugDrawPipelineLayout.get();
+		MaterialState.VertModule    = NewScene.DefaultVertexShaderModule;
+		MaterialState.FragModule    = NewScene.DefaultFragmentShaderModule;
+		MaterialState.RenderSamples = RenderSamples;
+
+		MaterialState.RenderPass
+			= TargetRenderer.GetDefaultRenderPass(RenderSamples);
+		MaterialState.VertexBindings.assign(
+			VertexBindingDescriptions.begin(), VertexBindingDescriptions.end()
+		);
+		MaterialState.VertexAttributes.assign(
+			VertexAttributeDescriptions.begin(),
+			VertexAttributeDescriptions.end()
+		);
+
+		// The mask of material-features is the only specialization-constant
+		MaterialState.FragSpecializationEntries
+			= {vk::SpecializationMapEntry(0, 0, sizeof(std::uint32_t))};
+		MaterialState.FragSpecializationData.resize(sizeof(std::uint32_t));
+	}
+
+	const auto RequestMaterialPipeline
+		= [&](std::uint32_t Features, bool DepthEqual) -> std::uint64_t {
+		MaterialState.DepthCompareOp
+			= DepthEqual ? vk::CompareOp::eEqual : vk::CompareOp::eLessOrEqual;
+		MaterialState.DepthWriteEnable = !DepthEqual;
+		std::memcpy(
+			MaterialState.FragSpecializationData.data(), &Features,
+			sizeof(std::uint32_t)
+		);
+
+		// Each variant is only requested once by the scene, so that each of
+		// its keys is released once
+		const std::uint64_t Key
+			= PipelineRegistry.RequestPipeline(MaterialState);
+		if( std::find(
+				NewScene.PipelineVariants.begin(),
+				NewScene.PipelineVariants.end(), Key
+			)
+			!= NewScene.PipelineVariants.end() )
+		{
+			PipelineRegistry.ReleasePipeline(Key);
+			return Key;
+		}
+
+		NewScene.PipelineVariants.push_back(Key);
+		NewScene.PendingPipelines.push_back(Key);
+		return Key;
+	};
+
+	// Resolve the draw-state of each mesh up-front and sort by it so that
+	// consecutive draws share as many binds as possible
+	NewScene.DrawList.reserve(NewScene.LightmapMeshs.size());
+	for( std::uint32_t MeshIndex = 0; MeshIndex < NewScene.LightmapMeshs.size();
+		 ++MeshIndex )
+	{
+		const auto& CurLightmapMesh = NewScene.LightmapMeshs[MeshIndex];
+
+		DrawItem& CurDraw     = NewScene.DrawList.emplace_back();
+		CurDraw.MeshIndex     = MeshIndex;
+		CurDraw.GeometryIndex = CurLightmapMesh.GeometryIndex;
+
+		// Draws that are part of the depth pre-pass only shade the samples
+		// of the pre-pass' depth
+		const bool DepthEqual
+			= Config.DepthPrepass && !CurLightmapMesh.AlphaTested;
+
+		// All bindless draws share the same state
+		if( Config.BindlessTextures )
+		{
+			CurDraw.Pipeline
+				= DepthEqual ? NewScene.BindlessDrawDepthEqualPipeline.get()
+							 : NewScene.BindlessDrawPipeline.get();
+			continue;
+		}
+
+		CurDraw.Pipeline = DepthEqual
+							 ? NewScene.DebugDrawDepthEqualPipeline.get()
+							 : NewScene.DebugDrawPipeline.get();
+
+		if( const auto ShaderSet
+			= NewScene.ShaderEnvironmentDescriptors.find(
+				CurLightmapMesh.ShaderTag
+			);
+			ShaderSet != NewScene.ShaderEnvironmentDescriptors.end() )
+		{
+			CurDraw.ShaderSet = ShaderSet->second;
+
+			// Only shader-environments have a descriptor-set
+			CurDraw.VariantKey = RequestMaterialPipeline(
+				GetMaterialFeatures(
+					*TargetWorld.GetMapFile()
+						 .GetTag<Blam::TagClass::ShaderEnvironment>(
+							 CurLightmapMesh.ShaderTag
+						 )
+				),
+				DepthEqual
+			);
+		}
+
+		if( CurLightmapMesh.LightmapTag.has_value()
+			&& CurLightmapMesh.LightmapIndex.has_value() )
+		{
+			CurDraw.LightmapSet
+				= NewScene.BitmapHeap.Sets
+					  .at(CurLightmapMesh.LightmapTag.value())
+					  .at(CurLightmapMesh.LightmapIndex.value());
+		}
+		else
+		{
+			CurDraw.LightmapSet
+				= NewScene.BitmapHeap.Sets.at(NewScene.BitmapHeap.Default2D)
+					  .at(std::uint32_t(
+						  Blam::DefaultTextureIndex::Multiplicative
+					  ));
+		}
+	}
+
+	std::stable_sort(
+		NewScene.DrawList.begin(), NewScene.DrawList.end(),
+		[](const DrawItem& A, const DrawItem& B) -> bool {
+			return A.GetStateKey() < B.GetStateKey();
+		}
+	);
+
+	// GPU culling
+	if( GPUCulling )
+	{
+		// Each cluster-range is culled individually, and each run of
+		// draw-items with the same state is drawn from its own range of
+		// draw-commands
+		std::vector<CullItem> CullItems;
+		for( std::uint32_t DrawIndex = 0; DrawIndex < NewScene.DrawList.size();
+			 ++DrawIndex )
+		{
+			const DrawItem& CurDraw = NewScene.DrawList[DrawIndex];
+
+			if( NewScene.CullGroups.empty()
+				|| NewScene.DrawList[NewScene.CullGroups.back().DrawItemIndex]
+						   .GetStateKey()
+					   != CurDraw.GetStateKey() )
+			{
+				NewScene.CullGroups.push_back(CullGroup{
+					DrawIndex, static_cast<std::uint32_t>(CullItems.size()),
+					0});
+			}
+
+			CullGroup& CurCullGroup = NewScene.CullGroups.back();
+
+			const auto& CurLightmapMesh
+				= NewScene.LightmapMeshs[CurDraw.MeshIndex];
+			for( const ClusterRange& CurClusterRange : std::span(
+					 NewScene.ClusterRanges.begin()
+						 + CurLightmapMesh.ClusterRangeStart,
+					 CurLightmapMesh.ClusterRangeCount
+				 ) )
+			{
+				CullItems.push_back(CullItem{
+					CurClusterRange.BoundsMin,
+					CurClusterRange.IndexCount,
+					CurClusterRange.BoundsMax,
+					CurClusterRange.IndexOffset,
+					static_cast<std::int32_t>(CurLightmapMesh.VertexIndexOffset
+					),
+					static_cast<std::uint32_t>(NewScene.CullGroups.size() - 1),
+					CurCullGroup.CommandStart,
+					CurDraw.MeshIndex,
+					0,
+				});
+				++CurCullGroup.CommandCount;
+			}
+
+			// Simplified levels are culled as a whole
+			for( std::uint32_t LOD = 1; LOD < CurLightmapMesh.LODCount; ++LOD )
+			{
+				CullItems.push_back(CullItem{
+					CurLightmapMesh.BoundsMin,
+					CurLightmapMesh.LODIndexCounts[LOD],
+					CurLightmapMesh.BoundsMax,
+					CurLightmapMesh.LODIndexOffsets[LOD],
+					static_cast<std::int32_t>(CurLightmapMesh.VertexIndexOffset
+					),
+					static_cast<std::uint32_t>(NewScene.CullGroups.size() - 1),
+					CurCullGroup.CommandStart,
+					CurDraw.MeshIndex,
+					LOD,
+				});
+				++CurCullGroup.CommandCount;
+			}
+		}
+		NewScene.CullItemCount = CullItems.size();
+
+		// The late phase of occlusion-culling writes its draw-commands and
+		// counts after those of the early phase
+		const std::size_t CullPhaseCount = Config.OcclusionCulling ? 2 : 1;
+
+		NewScene.CullItemBuffer = CreateSceneBuffer(
+			VulkanContext.LogicalDevice,
+			std::max<std::size_t>(CullItems.size(), 1) * sizeof(CullItem),
+			vk::BufferUsageFlagBits::eStorageBuffer, "Cull Items"
+		);
+		NewScene.CullCommandBuffer = CreateSceneBuffer(
+			VulkanContext.LogicalDevice,
+			std::max<std::size_t>(CullItems.size(), 1) * CullPhaseCount
+				* sizeof(vk::DrawIndexedIndirectCommand),
+			vk::BufferUsageFlagBits::eStorageBuffer
+				| vk::BufferUsageFlagBits::eIndirectBuffer,
+			"Cull Draw Commands"
+		);
+		NewScene.CullCountBuffer = CreateSceneBuffer(
+			VulkanContext.LogicalDevice,
+			std::max<std::size_t>(NewScene.CullGroups.size(), 1)
+				* CullPhaseCount * sizeof(std::uint32_t),
+			vk::BufferUsageFlagBits::eStorageBuffer
+				| vk::BufferUsageFlagBits::eIndirectBuffer,
+			"Cull Draw Counts"
+		);
+		NewScene.CullVisibilityBuffer = CreateSceneBuffer(
+			VulkanContext.LogicalDevice,
+			std::max<std::size_t>(CullItems.size(), 1) * sizeof(std::uint32_t),
+			vk::BufferUsageFlagBits::eStorageBuffer, "Cull Item Visibility"
+		);
+
+		NewScene.CullMeshLODBuffer = CreateSceneBuffer(
+			VulkanContext.LogicalDevice,
+			std::max<std::size_t>(NewScene.MeshLODs.size(), 1)
+				* sizeof(std::uint32_t),
+			vk::BufferUsageFlagBits::eStorageBuffer, "Cull Mesh LODs"
+		);
+
+		if( !NewScene.CullItemBuffer || !NewScene.CullCommandBuffer
+			|| !NewScene.CullCountBuffer || !NewScene.CullVisibilityBuffer
+			|| !NewScene.CullMeshLODBuffer )
+		{
+			return {};
+		}
+
+		if( auto [Result, Value] = Vulkan::CommitBufferHeap(
+				VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
+				std::array{
+					NewScene.CullItemBuffer.get(),
+					NewScene.CullCommandBuffer.get(),
+					NewScene.CullCountBuffer.get(),
+					NewScene.CullVisibilityBuffer.get(),
+					NewScene.CullMeshLODBuffer.get()}
+			);
+			Result == vk::Result::eSuccess )
+		{
+			NewScene.CullMemory = std::move(Value);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error committing culling memory: %s\n",
+				vk::to_string(Result).c_str()
+			);
+			return {};
+		}
+
+		TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+			std::as_bytes(std::span(CullItems)), NewScene.CullItemBuffer.get()
+		);
+
+		// Everything is drawn by the first early phase
+		const std::vector<std::uint32_t> CullVisibility(
+			std::max<std::size_t>(CullItems.size(), 1), 1
+		);
+		TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+			std::as_bytes(std::span(CullVisibility)),
+			NewScene.CullVisibilityBuffer.get()
+		);
+
+		if( !NewScene.MeshLODs.empty() )
+		{
+			TargetRenderer.GetStreamBuffer().QueueBufferUpload(
+				std::as_bytes(std::span(NewScene.MeshLODs)),
+				NewScene.CullMeshLODBuffer.get()
+			);
+		}
+
+		// Pipeline
+		const auto CullDrawsShaderData
+			= VkBlam::OpenResource("shaders/CullDraws.comp.spv").value();
+
+		NewScene.CullDrawsShaderModule
+			= TargetRenderer.GetShaderModuleCache()
+				  .GetShaderModule(CullDrawsShaderData)
+				  .value();
+
+		NewScene.CullDescriptorPool = std::make_unique<Vulkan::DescriptorHeap>(
+			Vulkan::DescriptorHeap::Create(VulkanContext, CullBindings, 1)
+				.value()
+		);
+
+		std::tie(NewScene.CullPipeline, NewScene.CullPipelineLayout)
+			= CreateComputePipeline(
+				VulkanContext.LogicalDevice, PipelineCache, {},
+				{{NewScene.CullDescriptorPool->GetDescriptorSetLayout()}},
+				NewScene.CullDrawsShaderModule
+			);
+
+		NewScene.CullDescriptor
+			= NewScene.CullDescriptorPool->AllocateDescriptorSet().value();
+
+		Vulkan::DescriptorUpdateBatch& DescriptorUpdateBatch
+			= TargetRenderer.GetDescriptorUpdateBatch();
+		DescriptorUpdateBatch.AddBuffer(
+			NewScene.CullDescriptor, 0, NewScene.CullItemBuffer.get(), 0
+		);
+		DescriptorUpdateBatch.AddBuffer(
+			NewScene.CullDescriptor, 1, NewScene.CullCommandBuffer.get(), 0
+		);
+		DescriptorUpdateBatch.AddBuffer(
+			NewScene.CullDescriptor, 2, NewScene.CullCountBuffer.get(), 0
+		);
+		DescriptorUpdateBatch.AddBuffer(
+			NewScene.CullDescriptor, 3,
+			TargetRenderer.GetUniformRingBuffer().GetBuffer(), 0,
+			sizeof(CullGlobals), vk::DescriptorType::eUniformBufferDynamic
+		);
+		DescriptorUpdateBatch.AddBuffer(
+			NewScene.CullDescriptor, 4, NewScene.CullVisibilityBuffer.get(), 0
+		);
+		DescriptorUpdateBatch.AddBuffer(
+			NewScene.CullDescriptor, 6, NewScene.CullMeshLODBuffer.get(), 0
+		);
+		// The depth-pyramid is bound once it is created by `PrepareRender`
+	}
+
+	// Occlusion culling
+	if( GPUCulling && Config.OcclusionCulling )
+	{
+		const auto DepthPyramidBaseShaderData
+			= VkBlam::OpenResource("shaders/DepthPyramidBase.comp.spv").value();
+		const auto DepthPyramidReduceShaderData
+			= VkBlam::OpenResource("shaders/DepthPyramidReduce.comp.spv")
+				  .value();
+
+		NewScene.DepthPyramidBaseShaderModule
+			= TargetRenderer.GetShaderModuleCache()
+				  .GetShaderModule(DepthPyramidBaseShaderData)
+				  .value();
+		NewScene.DepthPyramidReduceShaderModule
+			= TargetRenderer.GetShaderModuleCache()
+				  .GetShaderModule(DepthPyramidReduceShaderData)
+				  .value();
+
+		// One descriptor-set for each level
+		NewScene.DepthPyramidDescriptorPool
+			= std::make_unique<Vulkan::DescriptorHeap>(
+				Vulkan::DescriptorHeap::Create(
+					VulkanContext, DepthPyramidBindings, MaxDepthPyramidLevels
+				)
+					.value()
+			);
+		const vk::DescriptorSetLayout DepthPyramidSetLayout
+			= NewScene.DepthPyramidDescriptorPool->GetDescriptorSetLayout();
+
+		std::tie(
+			NewScene.DepthPyramidBasePipeline,
+			NewScene.DepthPyramidBasePipelineLayout
+		)
+			= CreateComputePipeline(
+				VulkanContext.LogicalDevice, PipelineCache, {},
+				{{DepthPyramidSetLayout}},
+				NewScene.DepthPyramidBaseShaderModule
+			);
+		std::tie(
+			NewScene.DepthPyramidReducePipeline,
+			NewScene.DepthPyramidReducePipelineLayout
+		)
+			= CreateComputePipeline(
+				VulkanContext.LogicalDevice, PipelineCache, {},
+				{{DepthPyramidSetLayout}},
+				NewScene.DepthPyramidReduceShaderModule
+			);
+
+		for( vk::DescriptorSet& CurDescriptor :
+			 NewScene.DepthPyramidDescriptors )
+		{
+			CurDescriptor
+				= NewScene.DepthPyramidDescriptorPool->AllocateDescriptorSet()
+					  .value();
+		}
+	}
+
+	// Scenario objects
+	if( const auto* ScenarioTag = TargetWorld.GetMapFile().GetScenarioTag();
+		ScenarioTag )
+	{
+		const Blam::MapFile& Map = TargetWorld.GetMapFile();
+
+		using ScenarioT = Blam::Tag<Blam::TagClass::Scenario>;
+
+		// The placements, grouped by the model of the placement's object
+		struct PlacementInstance
+		{
+			InstanceTransform Transform;
+			// World-space bounding-sphere
+			glm::f32vec3      Center;
+			float             Radius;
+		};
+		std::map<std::uint32_t, std::vector<PlacementInstance>> ModelInstances;
+
+		std::size_t PlacementCount = 0;
+
+		const auto AddPlacements = [&](const auto& PlacementBlock,
+									   const auto& PaletteBlock) -> void {
+			const auto Palette = Map.TagHeap.GetBlock(PaletteBlock);
+
+			for( const ScenarioT::ObjectPlacement& CurPlacement :
+				 Map.TagHeap.GetBlock(PlacementBlock) )
+			{
+				// Placed automatically by scripts, or an unused palette-entry
+				if( (CurPlacement.NotPlaced & 1)
+					|| CurPlacement.PaletteIndex >= Palette.size() )
+				{
+					continue;
+				}
+
+				const ScenarioT::PaletteEntry& CurPaletteEntry
+					= Palette[CurPlacement.PaletteIndex];
+				if( !CurPaletteEntry.Valid() )
+				{
+					continue;
+				}
+
+				const auto* ObjectTag
+					= Map.GetTag<Blam::TagClass::Object>(CurPaletteEntry.TagID
+					);
+				if( !ObjectTag || !ObjectTag->Model.Valid()
+					|| ObjectTag->Model.Class != Blam::TagClass::Gbxmodel )
+				{
+					continue;
+				}
+
+				const glm::f32vec3 Position(
+					CurPlacement.Position[0], CurPlacement.Position[1],
+					CurPlacement.Position[2]
+				);
+				const float Yaw   = CurPlacement.Rotation[0];
+				const float Pitch = CurPlacement.Rotation[1];
+				const float Roll  = CurPlacement.Rotation[2];
+
+				glm::f32mat4 Transform
+					= glm::translate(glm::f32mat4(1.0f), Position);
+				Transform = glm::rotate(Transform, Yaw, glm::f32vec3(0, 0, 1));
+				Transform
+					= glm::rotate(Transform, -Pitch, glm::f32vec3(0, 1, 0));
+				Transform = glm::rotate(Transform, Roll, glm::f32vec3(1, 0, 0));
+
+				const glm::f32vec3 BoundingOffset(
+					ObjectTag->BoundingOffset[0], ObjectTag->BoundingOffset[1],
+					ObjectTag->BoundingOffset[2]
+				);
+
+				const glm::f32vec3 Center = glm::f32vec3(
+					Transform * glm::f32vec4(BoundingOffset, 1.0f)
+				);
+
+				const glm::f32mat4 Rows = glm::transpose(Transform);
+				ModelInstances[ObjectTag->Model.TagID].push_back(
+					{{Rows[0], Rows[1], Rows[2]},
+					 Center,
+					 ObjectTag->BoundingRadius}
+				);
+				++PlacementCount;
+			}
+		};
+
+		AddPlacements(ScenarioTag->Scenery, ScenarioTag->SceneryPalette);
+		AddPlacements(ScenarioTag->Bipeds, ScenarioTag->BipedPalette);
+		AddPlacements(ScenarioTag->Vehicles, ScenarioTag->VehiclePalette);
+		AddPlacements(ScenarioTag->Equipment, ScenarioTag->EquipmentPalette);
+		AddPlacements(ScenarioTag->Weapons, ScenarioTag->WeaponPalette);
+		AddPlacements(ScenarioTag->Machines, ScenarioTag->MachinePalette);
+		AddPlacements(ScenarioTag->Controls, ScenarioTag->ControlPalette);
+		AddPlacements(
+			ScenarioTag->LightFixtures, ScenarioTag->LightFixturePalette
+		);
+		AddPlacements(
+			ScenarioTag->SoundScenery, ScenarioTag->SoundSceneryPalette
+		);
+
+		// The vertices and triangle-strips of all models follow the tag-data
+		// of the map
+		const std::span<const std::byte> ModelVertexData
+			= Map.GetMapData().subspan(
+				std::min<std::size_t>(
+					Map.TagIndexHeader.VertexOffset, Map.GetMapData().size()
+				)
+			);
+		const std::span<const std::byte> ModelIndexData
+			= ModelVertexData.subspan(std::min<std::size_t>(
+				Map.TagIndexHeader.IndexOffset, ModelVertexData.size()
+			));
+
+		// The vertices of each part are decoded in parallel into their place
+		// within the shared vertex-heap once the place of every part is known
+		struct PartVertexSource
+		{
+			// One of these is empty
+			std::span<const Blam::ModelVertex>           Vertices;
+			std::span<const Blam::CompressedModelVertex> CompressedVertices;
+
+			float         UScale       = 1.0f;
+			float         VScale       = 1.0f;
+			std::uint32_t VertexOffset = 0;
+		};
+		std::vector<PartVertexSource> PartSources;
+		std::uint32_t                 ObjectVertexCount = 0;
+
+		std::vector<std::uint32_t> ObjectIndices;
+
+		ObjectInstanceSet& Instances = NewScene.ObjectInstances;
+
+		for( const auto& [ModelTagID, Placements] : ModelInstances )
+		{
+			const auto* ModelTag
+				= Map.GetTag<Blam::TagClass::Gbxmodel>(ModelTagID);
+			if( !ModelTag )
+			{
+				continue;
+			}
+
+			const auto Geometries = Map.TagHeap.GetBlock(ModelTag->Geometries);
+			if( Geometries.empty() )
+			{
+				continue;
+			}
+
+			// The geometries of each level-of-detail, from the first
+			// permutation of each region
+			std::array<std::vector<std::uint32_t>, ObjectLODCount>
+				LODGeometries;
+			for( const auto& CurRegion :
+				 Map.TagHeap.GetBlock(ModelTag->Regions) )
+			{
+				const auto Permutations
+					= Map.TagHeap.GetBlock(CurRegion.Permutations);
+				if( Permutations.empty() )
+				{
+					continue;
+				}
+
+				const std::array<std::int16_t, ObjectLODCount> GeometryIndices
+					= {Permutations[0].SuperHighGeometry,
+					   Permutations[0].HighGeometry,
+					   Permutations[0].MediumGeometry,
+					   Permutations[0].LowGeometry,
+					   Permutations[0].SuperLowGeometry};
+				for( std::size_t LOD = 0; LOD < ObjectLODCount; ++LOD )
+				{
+					if( GeometryIndices[LOD] >= 0
+						&& std::size_t(GeometryIndices[LOD])
+							   < Geometries.size() )
+					{
+						LODGeometries[LOD].push_back(GeometryIndices[LOD]);
+					}
+				}
+			}
+
+			// Models without any regions draw their first geometry, and
+			// missing levels fall back to the previous level
+			if( LODGeometries[0].empty() )
+			{
+				LODGeometries[0] = {0};
+			}
+			for( std::size_t LOD = 1; LOD < ObjectLODCount; ++LOD )
+			{
+				if( LODGeometries[LOD].empty() )
 				{
-					for( std::size_t CurLayer = 0; CurLayer < LayerCount;
-						 ++CurLayer )
+					LODGeometries[LOD] = LODGeometries[LOD - 1];
+				}
+			}
+
+			ObjectModel CurModel  = {};
+			CurModel.ModelTag     = ModelTagID;
+			CurModel.VertexOffset = ObjectVertexCount;
+
+			const std::size_t PartStart  = PartSources.size();
+			const std::size_t IndexStart = ObjectIndices.size();
+
+			// The vertices of each geometry are shared by all levels that
+			// draw it. All parts of a geometry are drawn together, so each
+			// part's strip is converted into a list of triangles that is
+			// rebased onto the part's vertices
+			std::map<std::uint32_t, std::vector<std::uint32_t>>
+				GeometryTriangles;
+			const auto AddGeometry = [&](std::uint32_t GeometryIndex) -> void {
+				std::vector<std::uint32_t>& CurTriangles
+					= GeometryTriangles[GeometryIndex];
+
+				for( const auto& CurPart :
+					 Map.TagHeap.GetBlock(Geometries[GeometryIndex].Parts) )
+				{
+					const bool Compressed
+						= CurPart.VertexFormat
+						== Blam::VertexFormat::ModelCompressed;
+					const std::size_t VertexStride
+						= Compressed ? sizeof(Blam::CompressedModelVertex)
+									 : sizeof(Blam::ModelVertex);
+
+					const std::size_t VertexCount = CurPart.VertexCount;
+					const std::size_t StripLength = CurPart.TriangleCount + 2;
+
+					if( (!Compressed
+						 && CurPart.VertexFormat
+								!= Blam::VertexFormat::ModelUncompressed)
+						|| CurPart.VertexCount <= 0
+						|| CurPart.TriangleCount <= 0
+						|| CurPart.VertexBufferData < 0
+						|| CurPart.TriangleDataOffset < 0
+						|| CurPart.VertexBufferData + VertexCount * VertexStride
+							   > ModelVertexData.size()
+						|| CurPart.TriangleDataOffset
+								   + StripLength * sizeof(std::uint16_t)
+							   > ModelIndexData.size() )
 					{
-						const std::array<std::uint32_t, 3> CurBlockCount
-							= {std::max(1u, CurExtent.width / BlockExtent[0]),
-							   std::max(1u, CurExtent.height / BlockExtent[1]),
-							   std::max(1u, CurExtent.depth / BlockExtent[2])};
+						continue;
+					}
 
-						const std::size_t CurPixelDataSize
-							= CurBlockCount[0] * CurBlockCount[1]
-							* CurBlockCount[2] * BlockSize;
+					PartVertexSource& CurSource = PartSources.emplace_back();
+					CurSource.VertexOffset      = ObjectVertexCount;
 
-						TargetRenderer.GetStreamBuffer().QueueImageUpload(
-							PixelData.subspan(PixelDataOff, CurPixelDataSize),
-							TargetBitmap.Image.get(), vk::Offset3D(0, 0, 0),
-							CurExtent,
-							vk::ImageSubresourceLayers(
-								vk::ImageAspectFlagBits::eColor, CurMip,
-								CurLayer, 1
-							)
-						);
+					const std::byte* PartVertexData
+						= ModelVertexData.data() + CurPart.VertexBufferData;
+					if( Compressed )
+					{
+						CurSource.CompressedVertices = {
+							reinterpret_cast<
+								const Blam::CompressedModelVertex*>(
+								PartVertexData
+							),
+							VertexCount};
+						// A scale of zero is treated as no scale at all
+						CurSource.UScale = ModelTag->BaseMapUScale
+											 ? ModelTag->BaseMapUScale
+											 : 1.0f;
+						CurSource.VScale = ModelTag->BaseMapVScale
+											 ? ModelTag->BaseMapVScale
+											 : 1.0f;
+					}
+					else
+					{
+						CurSource.Vertices = {
+							reinterpret_cast<const Blam::ModelVertex*>(
+								PartVertexData
+							),
+							VertexCount};
+					}
 
-						PixelDataOff += CurPixelDataSize;
+					const std::span<const std::uint16_t> PartStrip(
+						reinterpret_cast<const std::uint16_t*>(
+							ModelIndexData.data() + CurPart.TriangleDataOffset
+						),
+						StripLength
+					);
+
+					const std::uint32_t PartVertexStart
+						= ObjectVertexCount - CurModel.VertexOffset;
+
+					for( std::size_t i = 2; i < PartStrip.size(); ++i )
+					{
+						std::uint32_t A = PartStrip[i - 2];
+						std::uint32_t B = PartStrip[i - 1];
+						std::uint32_t C = PartStrip[i];
+
+						// Degenerate triangles join the runs of the strip
+						if( A == B || B == C || C == A || A >= VertexCount
+							|| B >= VertexCount || C >= VertexCount )
+						{
+							continue;
+						}
+
+						// The winding of a strip alternates with each
+						// triangle
+						if( i % 2 )
+						{
+							std::swap(A, B);
+						}
+
+						CurTriangles.push_back(PartVertexStart + A);
+						CurTriangles.push_back(PartVertexStart + B);
+						CurTriangles.push_back(PartVertexStart + C);
 					}
 
-					CurExtent.width  = std::max(1u, CurExtent.width / 2);
-					CurExtent.height = std::max(1u, CurExtent.height / 2);
-					CurExtent.depth  = std::max(1u, CurExtent.depth / 2);
+					ObjectVertexCount += VertexCount;
 				}
+			};
 
-				// Create image view
-				vk::ImageViewCreateInfo BitmapImageViewInfo = {};
-				BitmapImageViewInfo.image = TargetBitmap.Image.get();
-				switch( BitmapEntry.Type )
-				{
-				default:
-				case Blam::BitmapEntryType::Texture2D:
+			// Levels that draw the same geometries as the previous level
+			// share its range of indices
+			for( std::size_t LOD = 0; LOD < ObjectLODCount; ++LOD )
+			{
+				if( LOD > 0 && LODGeometries[LOD] == LODGeometries[LOD - 1] )
 				{
-					BitmapImageViewInfo.viewType = vk::ImageViewType::e2D;
-					break;
+					CurModel.LODIndexOffsets[LOD]
+						= CurModel.LODIndexOffsets[LOD - 1];
+					CurModel.LODIndexCounts[LOD]
+						= CurModel.LODIndexCounts[LOD - 1];
+					continue;
 				}
-				case Blam::BitmapEntryType::Texture3D:
+
+				CurModel.LODIndexOffsets[LOD] = ObjectIndices.size();
+				for( const std::uint32_t& GeometryIndex : LODGeometries[LOD] )
 				{
-					BitmapImageViewInfo.viewType = vk::ImageViewType::e3D;
-					break;
+					if( !GeometryTriangles.contains(GeometryIndex) )
+					{
+						AddGeometry(GeometryIndex);
+					}
+
+					const std::vector<std::uint32_t>& CurTriangles
+						= GeometryTriangles[GeometryIndex];
+					ObjectIndices.insert(
+						ObjectIndices.end(), CurTriangles.begin(),
+						CurTriangles.end()
+					);
 				}
-				case Blam::BitmapEntryType::CubeMap:
+				CurModel.LODIndexCounts[LOD]
+					= ObjectIndices.size() - CurModel.LODIndexOffsets[LOD];
+
+				// Levels without any triangles are drawn at the previous
+				// level
+				if( LOD > 0 && CurModel.LODIndexCounts[LOD] == 0 )
 				{
-					BitmapImageViewInfo.viewType = vk::ImageViewType::eCube;
-					break;
+					CurModel.LODIndexOffsets[LOD]
+						= CurModel.LODIndexOffsets[LOD - 1];
+					CurModel.LODIndexCounts[LOD]
+						= CurModel.LODIndexCounts[LOD - 1];
 				}
-				}
-				BitmapImageViewInfo.format
-					= VkBlam::BlamToVk(BitmapEntry.Format);
-				;
-				BitmapImageViewInfo.components.r = vk::ComponentSwizzle::eR;
-				BitmapImageViewInfo.components.g = vk::ComponentSwizzle::eG;
-				BitmapImageViewInfo.components.b = vk::ComponentSwizzle::eB;
-				BitmapImageViewInfo.components.a = vk::ComponentSwizzle::eA;
-				BitmapImageViewInfo.subresourceRange.aspectMask
-					= vk::ImageAspectFlagBits::eColor;
-				BitmapImageViewInfo.subresourceRange.baseMipLevel   = 0;
-				BitmapImageViewInfo.subresourceRange.levelCount     = MipCount;
-				BitmapImageViewInfo.subresourceRange.baseArrayLayer = 0;
-				BitmapImageViewInfo.subresourceRange.layerCount = LayerCount;
+			}
 
-				if( auto CreateResult
-					= VulkanContext.LogicalDevice.createImageViewUnique(
-						BitmapImageViewInfo
-					);
-					CreateResult.result == vk::Result::eSuccess )
+			if( CurModel.LODIndexCounts[0] == 0 )
+			{
+				PartSources.resize(PartStart);
+				ObjectIndices.resize(IndexStart);
+				ObjectVertexCount = CurModel.VertexOffset;
+				continue;
+			}
+
+			// Detail-cutoffs of the model, from the high-detail cutoff to the
+			// super-low cutoff
+			const std::array<float, ObjectLODCount - 1> Cutoffs
+				= {ModelTag->HighDetailCutoff, ModelTag->MediumDetailCutoff,
+				   ModelTag->LowDetailCutoff, ModelTag->SuperLowCutoff};
+
+			CurModel.InstanceOffset = Instances.Transforms.size();
+			CurModel.InstanceCount  = Placements.size();
+			for( const PlacementInstance& CurPlacement : Placements )
+			{
+				Instances.Transforms.push_back(CurPlacement.Transform);
+				Instances.CenterX.push_back(CurPlacement.Center.x);
+				Instances.CenterY.push_back(CurPlacement.Center.y);
+				Instances.CenterZ.push_back(CurPlacement.Center.z);
+				Instances.Radius.push_back(CurPlacement.Radius);
+				for( std::size_t i = 0; i < Cutoffs.size(); ++i )
 				{
-					TargetBitmap.View = std::move(CreateResult.value);
+					Instances.Cutoffs[i].push_back(Cutoffs[i]);
 				}
-				else
+				Instances.LODs.push_back(0);
+			}
+
+			NewScene.ObjectModels.push_back(CurModel);
+		}
+
+		std::vector<Blam::ModelVertex> ObjectVertices(ObjectVertexCount);
+		LoadWorkers.ParallelFor(
+			PartSources.size(),
+			[&](std::size_t PartIndex) -> void {
+				const PartVertexSource& CurSource = PartSources[PartIndex];
+				if( CurSource.CompressedVertices.empty() )
 				{
-					std::fprintf(
-						stderr, "Error bitmap view: %s\n",
-						vk::to_string(CreateResult.result).c_str()
+					std::copy(
+						CurSource.Vertices.begin(), CurSource.Vertices.end(),
+						ObjectVertices.begin() + CurSource.VertexOffset
 					);
-					return false;
+					return;
 				}
-				return true;
-			};
 
-			const auto StreamBitmap
-				= [&](const Blam::TagIndexEntry&               TagEntry,
-					  const Blam::Tag<Blam::TagClass::Bitmap>& Bitmap) -> void {
-				for( std::size_t CurSubTextureIdx = 0;
-					 CurSubTextureIdx < Bitmap.Bitmaps.Count;
-					 ++CurSubTextureIdx )
+				Blam::DecodeCompressedVertices(
+					CurSource.CompressedVertices, CurSource.UScale,
+					CurSource.VScale,
+					std::span(ObjectVertices)
+						.subspan(
+							CurSource.VertexOffset,
+							CurSource.CompressedVertices.size()
+						)
+				);
+			}
+		);
+
+		std::printf(
+			"Objects: %zu placements | %zu models | %zu vertices | %zu "
+			"triangles\n",
+			PlacementCount, NewScene.ObjectModels.size(), ObjectVertices.size(),
+			ObjectIndices.size() / 3
+		);
+
+		if( !NewScene.ObjectModels.empty() )
+		{
+			NewScene.ObjectVertexBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice,
+				ObjectVertices.size() * sizeof(Blam::ModelVertex),
+				vk::BufferUsageFlagBits::eVertexBuffer, "Object Vertices"
+			);
+			NewScene.ObjectIndexBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice,
+				ObjectIndices.size() * sizeof(std::uint32_t),
+				vk::BufferUsageFlagBits::eIndexBuffer, "Object Indices"
+			);
+			NewScene.ObjectInstanceBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice,
+				Instances.Transforms.size() * sizeof(InstanceTransform),
+				vk::BufferUsageFlagBits::eVertexBuffer, "Object Instances"
+			);
+			NewScene.ObjectDrawCommandBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice,
+				NewScene.ObjectModels.size() * ObjectLODCount
+					* sizeof(vk::DrawIndexedIndirectCommand),
+				vk::BufferUsageFlagBits::eIndirectBuffer, "Object Draw Commands"
+			);
+
+			if( !NewScene.ObjectVertexBuffer || !NewScene.ObjectIndexBuffer
+				|| !NewScene.ObjectInstanceBuffer
+				|| !NewScene.ObjectDrawCommandBuffer )
+			{
+				return {};
+			}
+
+			if( auto [Result, Value] = Vulkan::CommitBufferHeap(
+					VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
+					std::array{
+						NewScene.ObjectVertexBuffer.get(),
+						NewScene.ObjectIndexBuffer.get(),
+						NewScene.ObjectInstanceBuffer.get(),
+						NewScene.ObjectDrawCommandBuffer.get()}
+				);
+				Result == vk::Result::eSuccess )
+			{
+				NewScene.ObjectMemory = std::move(Value);
+			}
+			else
+			{
+				std::fprintf(
+					stderr, "Error committing object memory: %s\n",
+					vk::to_string(Result).c_str()
+				);
+				return {};
+			}
+
+			Vulkan::StreamBuffer& StreamBuffer
+				= TargetRenderer.GetStreamBuffer();
+			StreamBuffer.QueueBufferUpload(
+				std::as_bytes(std::span(ObjectVertices)),
+				NewScene.ObjectVertexBuffer.get()
+			);
+			StreamBuffer.QueueBufferUpload(
+				std::as_bytes(std::span(ObjectIndices)),
+				NewScene.ObjectIndexBuffer.get()
+			);
+
+			// All placements start at their most detailed level until the
+			// first view selects their levels
+			std::vector<vk::DrawIndexedIndirectCommand> DrawCommands;
+			std::vector<InstanceTransform>              Transforms;
+			NewScene.SortObjectInstances(DrawCommands, Transforms);
+			StreamBuffer.QueueBufferUpload(
+				std::as_bytes(std::span(Transforms)),
+				NewScene.ObjectInstanceBuffer.get()
+			);
+			StreamBuffer.QueueBufferUpload(
+				std::as_bytes(std::span(DrawCommands)),
+				NewScene.ObjectDrawCommandBuffer.get()
+			);
+
+			// Pipeline
+			const auto ObjectVertShaderData
+				= VkBlam::OpenResource("shaders/Object.vert.spv").value();
+			const auto ObjectFragShaderData
+				= VkBlam::OpenResource("shaders/Object.frag.spv").value();
+
+			NewScene.ObjectVertexShaderModule
+				= TargetRenderer.GetShaderModuleCache()
+					  .GetShaderModule(ObjectVertShaderData)
+					  .value();
+			NewScene.ObjectFragmentShaderModule
+				= TargetRenderer.GetShaderModuleCache()
+					  .GetShaderModule(ObjectFragShaderData)
+					  .value();
+
+			// Model vertices, followed by the transform of each instance
+			auto [ObjectBindings, ObjectAttributes]
+				= VkBlam::GetVertexInputDescriptions({{
+					Blam::VertexFormat::ModelUncompressed,
+				}});
+
+			const auto InstanceBinding
+				= static_cast<std::uint32_t>(ObjectBindings.size());
+			ObjectBindings.emplace_back(
+				InstanceBinding, sizeof(InstanceTransform),
+				vk::VertexInputRate::eInstance
+			);
+			for( std::uint32_t Row = 0; Row < 3; ++Row )
+			{
+				ObjectAttributes.emplace_back(
+					static_cast<std::uint32_t>(ObjectAttributes.size()),
+					InstanceBinding,
+					vk::Format::eR32G32B32A32Sfloat,
+					Row * sizeof(glm::f32vec4)
+				);
+			}
+
+			std::tie(NewScene.ObjectPipeline, NewScene.ObjectPipelineLayout)
+				= CreateGraphicsPipeline(
+					VulkanContext.LogicalDevice, PipelineCache, {},
+					{{NewScene.SceneDescriptorPool->GetDescriptorSetLayout()}},
+					NewScene.ObjectVertexShaderModule,
+					NewScene.ObjectFragmentShaderModule, ObjectBindings,
+					ObjectAttributes,
+					TargetRenderer.GetDefaultRenderPass(RenderSamples),
+					RenderSamples, vk::PolygonMode::eFill
+				);
+		}
+	}
+
+	// Scenario decals, which sample their bitmaps from the bindless textures
+	if( const auto* ScenarioTag = TargetWorld.GetMapFile().GetScenarioTag();
+		ScenarioTag && Config.BindlessTextures )
+	{
+		const Blam::MapFile& Map = TargetWorld.GetMapFile();
+
+		// Decals of an invalid palette-entry have no radius and are never
+		// rasterized
+		const auto DecalPalette
+			= Map.TagHeap.GetBlock(ScenarioTag->DecalPalette);
+		std::vector<DecalPaletteEntry> PaletteEntries(DecalPalette.size());
+		for( std::size_t i = 0; i < DecalPalette.size(); ++i )
+		{
+			const auto* DecalTag
+				= DecalPalette[i].Valid()
+					? Map.GetTag<Blam::TagClass::Decal>(DecalPalette[i].TagID)
+					: nullptr;
+			if( !DecalTag )
+			{
+				continue;
+			}
+
+			// The randomized properties of each decal are fixed to the
+			// midpoint of their bounds
+			const glm::f32vec3 ColorLower(
+				DecalTag->ColorLowerBound[0], DecalTag->ColorLowerBound[1],
+				DecalTag->ColorLowerBound[2]
+			);
+			const glm::f32vec3 ColorUpper(
+				DecalTag->ColorUpperBound[0], DecalTag->ColorUpperBound[1],
+				DecalTag->ColorUpperBound[2]
+			);
+
+			DecalPaletteEntry& CurEntry = PaletteEntries[i];
+
+			CurEntry.Color = glm::f32vec4(
+				0.5f * (ColorLower + ColorUpper),
+				0.5f * (DecalTag->Intensity[0] + DecalTag->Intensity[1])
+			);
+			CurEntry.Radius
+				= 0.5f * (DecalTag->Radius[0] + DecalTag->Radius[1]);
+
+			const auto Found
+				= DecalTag->Map.Valid()
+					? Bitmap2DIndices.find({DecalTag->Map.TagID, 0})
+					: Bitmap2DIndices.end();
+			if( Found == Bitmap2DIndices.end() )
+			{
+				CurEntry.Radius = 0.0f;
+				continue;
+			}
+			CurEntry.TextureIndex = Found->second;
+		}
+
+		// Yaw and pitch are stored as fractions of a half-turn
+		constexpr float AngleScale = std::numbers::pi_v<float> / 127.0f;
+
+		std::vector<Blam::Vector3f> DecalPositions;
+		for( const auto& CurDecal : Map.TagHeap.GetBlock(ScenarioTag->Decals) )
+		{
+			if( CurDecal.DecalIndex >= PaletteEntries.size() )
+			{
+				continue;
+			}
+
+			DecalInstance& CurInstance = NewScene.Decals.emplace_back();
+
+			CurInstance.Position = glm::f32vec3(
+				CurDecal.Position[0], CurDecal.Position[1], CurDecal.Position[2]
+			);
+			CurInstance.PaletteIndex = CurDecal.DecalIndex;
+			CurInstance.Orientation
+				= glm::f32vec2(CurDecal.Yaw, CurDecal.Pitch) * AngleScale;
+
+			DecalPositions.push_back(CurDecal.Position);
+		}
+
+		// Each decal belongs to the first BSP with a cluster that contains it
+		NewScene.DecalLocations.resize(NewScene.Decals.size());
+		std::vector<std::int16_t> DecalClusters(NewScene.Decals.size());
+		const auto ScenarioBSPs = Map.GetScenarioBSPs();
+		for( std::size_t BSPIndex = 0; BSPIndex < ScenarioBSPs.size();
+			 ++BSPIndex )
+		{
+			const Blam::VirtualHeap SBSPHeap
+				= ScenarioBSPs[BSPIndex].GetSBSPHeap(Map.GetMapData());
+
+			Blam::FindClusters(
+				SBSPHeap, ScenarioBSPs[BSPIndex].GetSBSP(SBSPHeap),
+				DecalPositions, DecalClusters
+			);
+
+			for( std::size_t i = 0; i < DecalClusters.size(); ++i )
+			{
+				DecalLocation& CurLocation = NewScene.DecalLocations[i];
+				if( CurLocation.Cluster == NoCluster && DecalClusters[i] >= 0 )
 				{
-					const auto& CurSubTexture
-						= TargetWorld.GetMapFile().TagHeap.GetBlock(
-							Bitmap.Bitmaps
-						)[CurSubTextureIdx];
-					const auto PixelData = std::span<const std::byte>(
-						reinterpret_cast<const std::byte*>(
-							TargetWorld.GetMapFile().GetBitmapData().data()
-						) + CurSubTexture.PixelDataOffset,
-						CurSubTexture.PixelDataSize
-					);
+					CurLocation.BSPIndex = BSPIndex;
+					CurLocation.Cluster  = DecalClusters[i];
+				}
+			}
+		}
 
-					auto& BitmapDest
-						= NewScene.BitmapHeap
-							  .Bitmaps[TagEntry.TagID][CurSubTextureIdx];
+		std::printf(
+			"Decals: %zu decals | %zu palette-entries\n",
+			NewScene.Decals.size(), PaletteEntries.size()
+		);
 
-					StreamBitmapImage(BitmapDest, CurSubTexture, PixelData);
+		if( !NewScene.Decals.empty() )
+		{
+			NewScene.DecalPaletteBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice,
+				PaletteEntries.size() * sizeof(DecalPaletteEntry),
+				vk::BufferUsageFlagBits::eStorageBuffer, "Decal Palette"
+			);
+			NewScene.DecalInstanceBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice,
+				NewScene.Decals.size() * sizeof(DecalInstance),
+				vk::BufferUsageFlagBits::eVertexBuffer, "Decal Instances"
+			);
+			NewScene.DecalDrawCommandBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice, sizeof(vk::DrawIndirectCommand),
+				vk::BufferUsageFlagBits::eIndirectBuffer, "Decal Draw Command"
+			);
 
-					Vulkan::SetObjectName(
-						VulkanContext.LogicalDevice, BitmapDest.View.get(),
-						"VkBlam::Scene: Bitmap View %08X[%2zu] | %s",
-						TagEntry.TagID, CurSubTextureIdx,
-						TargetWorld.GetMapFile()
-							.GetTagName(TagEntry.TagID)
-							.data()
-					);
+			if( !NewScene.DecalPaletteBuffer || !NewScene.DecalInstanceBuffer
+				|| !NewScene.DecalDrawCommandBuffer )
+			{
+				return {};
+			}
+
+			if( auto [Result, Value] = Vulkan::CommitBufferHeap(
+					VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
+					std::array{
+						NewScene.DecalPaletteBuffer.get(),
+						NewScene.DecalInstanceBuffer.get(),
+						NewScene.DecalDrawCommandBuffer.get()}
+				);
+				Result == vk::Result::eSuccess )
+			{
+				NewScene.DecalMemory = std::move(Value);
+			}
+			else
+			{
+				std::fprintf(
+					stderr, "Error committing decal memory: %s\n",
+					vk::to_string(Result).c_str()
+				);
+				return {};
+			}
+
+			// Nothing is drawn until the first view gathers the visible
+			// decals
+			const vk::DrawIndirectCommand EmptyDrawCommand(6, 0, 0, 0);
+
+			Vulkan::StreamBuffer& StreamBuffer
+				= TargetRenderer.GetStreamBuffer();
+			StreamBuffer.QueueBufferUpload(
+				std::as_bytes(std::span(PaletteEntries)),
+				NewScene.DecalPaletteBuffer.get()
+			);
+			StreamBuffer.QueueBufferUpload(
+				std::as_bytes(std::span(&EmptyDrawCommand, 1)),
+				NewScene.DecalDrawCommandBuffer.get()
+			);
+
+			// Descriptor set
+			const std::array DecalBindings = {
+				vk::DescriptorSetLayoutBinding(
+					0, vk::DescriptorType::eStorageBuffer, 1,
+					vk::ShaderStageFlagBits::eVertex
+						| vk::ShaderStageFlagBits::eFragment
+				),
+			};
+
+			NewScene.DecalDescriptorPool
+				= std::make_unique<Vulkan::DescriptorHeap>(
+					Vulkan::DescriptorHeap::Create(
+						VulkanContext, DecalBindings, 1
+					)
+						.value()
+				);
+			NewScene.DecalDescriptor
+				= NewScene.DecalDescriptorPool->AllocateDescriptorSet().value();
+
+			TargetRenderer.GetDescriptorUpdateBatch().AddBuffer(
+				NewScene.DecalDescriptor, 0, NewScene.DecalPaletteBuffer.get(),
+				0
+			);
+
+			// Pipeline
+			const auto DecalVertShaderData
+				= VkBlam::OpenResource("shaders/Decal.vert.spv").value();
+			const auto DecalFragShaderData
+				= VkBlam::OpenResource("shaders/Decal.frag.spv").value();
+
+			NewScene.DecalVertexShaderModule
+				= TargetRenderer.GetShaderModuleCache()
+					  .GetShaderModule(DecalVertShaderData)
+					  .value();
+			NewScene.DecalFragmentShaderModule
+				= TargetRenderer.GetShaderModuleCache()
+					  .GetShaderModule(DecalFragShaderData)
+					  .value();
+
+			// Only instance data, the corners of each quad are generated by
+			// the vertex shader
+			const std::array DecalBindingDescriptions = {
+				vk::VertexInputBindingDescription(
+					0, sizeof(DecalInstance), vk::VertexInputRate::eInstance
+				),
+			};
+			const std::array DecalAttributeDescriptions = {
+				vk::VertexInputAttributeDescription(
+					0, 0, vk::Format::eR32G32B32Sfloat,
+					offsetof(DecalInstance, Position)
+				),
+				vk::VertexInputAttributeDescription(
+					1, 0, vk::Format::eR32Uint,
+					offsetof(DecalInstance, PaletteIndex)
+				),
+				vk::VertexInputAttributeDescription(
+					2, 0, vk::Format::eR32G32Sfloat,
+					offsetof(DecalInstance, Orientation)
+				),
+			};
+
+			// Decals are depth-tested against the BSP without writing any
+			// depth of their own
+			std::tie(NewScene.DecalPipeline, NewScene.DecalPipelineLayout)
+				= CreateGraphicsPipeline(
+					VulkanContext.LogicalDevice, PipelineCache, {},
+					{{NewScene.SceneDescriptorPool->GetDescriptorSetLayout(),
+					  NewScene.BindlessDescriptorPool->GetDescriptorSetLayout(),
+					  NewScene.DecalDescriptorPool->GetDescriptorSetLayout()}},
+					NewScene.DecalVertexShaderModule,
+					NewScene.DecalFragmentShaderModule,
+					DecalBindingDescriptions, DecalAttributeDescriptions,
+					TargetRenderer.GetDefaultRenderPass(RenderSamples),
+					RenderSamples, vk::PolygonMode::eFill,
+					vk::CompareOp::eLessOrEqual, false
+				);
+		}
+	}
+
+	// Detail objects of all BSPs, expanded and culled on the GPU
+	if( Config.DetailObjectDistance > 0.0f )
+	{
+		const Blam::MapFile& Map = TargetWorld.GetMapFile();
 
-					// Create descriptor set
-					vk::DescriptorSet& TargetSet
-						= NewScene.BitmapHeap
-							  .Sets[TagEntry.TagID][CurSubTextureIdx];
+		std::vector<DetailCell>     DetailCells;
+		std::vector<DetailInstance> DetailInstances;
+		for( const Blam::Tag<Blam::TagClass::Scenario>::StructureBSP& CurSBSP :
+			 Map.GetScenarioBSPs() )
+		{
+			const Blam::VirtualHeap SBSPHeap
+				= CurSBSP.GetSBSPHeap(Map.GetMapData());
 
-					if( auto NewSet = NewScene.DebugDrawDescriptorPool
-										  ->AllocateDescriptorSet();
-						NewSet )
+			const Blam::Tag<Blam::TagClass::ScenarioStructureBsp>& ScenarioBSP
+				= CurSBSP.GetSBSP(SBSPHeap);
+
+			for( const auto& CurData :
+				 SBSPHeap.GetBlock(ScenarioBSP.DetailObjects) )
+			{
+				const auto Cells     = SBSPHeap.GetBlock(CurData.Cells);
+				const auto Instances = SBSPHeap.GetBlock(CurData.Instances);
+				const auto Counts    = SBSPHeap.GetBlock(CurData.Counts);
+
+				for( const auto& CurCell : Cells )
+				{
+					// The instances of a cell are grouped by type, with one
+					// count for each of its types
+					const std::size_t TypeCount
+						= std::popcount(CurCell.ValidLayers);
+					if( CurCell.StartIndex < 0 || CurCell.CountIndex < 0
+						|| std::size_t(CurCell.CountIndex) + TypeCount
+							   > Counts.size() )
 					{
-						TargetSet = NewSet.value();
+						continue;
 					}
-					else
+
+					std::size_t InstanceCount = 0;
+					for( std::size_t i = 0; i < TypeCount; ++i )
 					{
-						std::fprintf(
-							stderr, "Error allocating bitmap descriptor set\n"
+						InstanceCount += std::max<std::int16_t>(
+							Counts[CurCell.CountIndex + i], 0
 						);
-						return;
+					}
+					if( std::size_t(CurCell.StartIndex) + InstanceCount
+						> Instances.size() )
+					{
+						continue;
 					}
 
-					Vulkan::SetObjectName(
-						VulkanContext.LogicalDevice, TargetSet,
-						"VkBlam::Scene: Bitmap Descriptor Set %08X[%2zu] | %s",
-						TagEntry.TagID, CurSubTextureIdx,
-						TargetWorld.GetMapFile()
-							.GetTagName(TagEntry.TagID)
-							.data()
-					);
+					const std::uint32_t CellIndex = DetailCells.size();
 
-					TargetRenderer.GetDescriptorUpdateBatch().AddImage(
-						TargetSet, 0, BitmapDest.View.get(),
-						vk::ImageLayout::eShaderReadOnlyOptimal
+					const glm::f32vec3 CellCoord(
+						CurCell.CellX, CurCell.CellY, CurCell.CellZ
 					);
-				}
-			};
 
-			BitmapCommitter.VisitTags
-				= [&](std::span<const Blam::TagIndexEntry> TagIndexEntries,
-					  const Blam::MapFile&                 Map) -> void {
-				for( const auto& TagIndexEntry : TagIndexEntries )
-				{
-					const auto& CurBitmap
-						= Map.GetTag<Blam::TagClass::Bitmap>(TagIndexEntry.TagID
-						);
-					StreamBitmap(TagIndexEntry, *CurBitmap);
+					DetailCell& NewCell = DetailCells.emplace_back();
+					NewCell.Origin      = CellCoord * DetailObjectCellSize;
+
+					for( const auto& CurInstance :
+						 Instances.subspan(CurCell.StartIndex, InstanceCount) )
+					{
+						DetailInstance& NewInstance
+							= DetailInstances.emplace_back();
+
+						NewInstance.PositionData
+							= (std::uint32_t(CurInstance.PositionX) << 0)
+							| (std::uint32_t(CurInstance.PositionY) << 8)
+							| (std::uint32_t(CurInstance.PositionZ) << 16)
+							| (std::uint32_t(CurInstance.Data & 0x3F) << 24);
+						NewInstance.Color     = CurInstance.Color;
+						NewInstance.CellIndex = CellIndex;
+					}
 				}
-			};
+			}
 		}
-	}
 
-	// Create Shader-Environment descriptor sets
-	{
-		const auto CreateShaderEnvironmentDescriptor
-			= [&](const Blam::TagIndexEntry& TagEntry,
-				  const Blam::Tag<Blam::TagClass::ShaderEnvironment>&
-					  ShaderEnvironment) -> void {
-			const vk::DescriptorSet NewSet
-				= NewScene.ShaderEnvironmentDescriptorPool
-					  ->AllocateDescriptorSet()
-					  .value();
-			NewScene.ShaderEnvironmentDescriptors[TagEntry.TagID] = NewSet;
+		NewScene.DetailObjectCount = DetailInstances.size();
 
-			Vulkan::SetObjectName(
-				VulkanContext.LogicalDevice, NewSet,
-				"senv: %08X \'%s\' Descriptor Set", TagEntry.TagID,
-				TargetWorld.GetMapFile().GetTagName(TagEntry.TagID).data()
+		std::printf(
+			"Detail objects: %zu instances | %zu cells\n",
+			DetailInstances.size(), DetailCells.size()
+		);
+
+		if( !DetailInstances.empty() )
+		{
+			NewScene.DetailCellBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice,
+				DetailCells.size() * sizeof(DetailCell),
+				vk::BufferUsageFlagBits::eStorageBuffer, "Detail Cells"
+			);
+			NewScene.DetailInstanceBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice,
+				DetailInstances.size() * sizeof(DetailInstance),
+				vk::BufferUsageFlagBits::eStorageBuffer, "Detail Instances"
+			);
+			// Sized for the worst-case of all instances being visible
+			NewScene.DetailVisibleBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice,
+				DetailInstances.size() * sizeof(VisibleDetail),
+				vk::BufferUsageFlagBits::eStorageBuffer,
+				"Visible Detail Objects"
+			);
+			NewScene.DetailObjectDrawCommandBuffer = CreateSceneBuffer(
+				VulkanContext.LogicalDevice, sizeof(vk::DrawIndirectCommand),
+				vk::BufferUsageFlagBits::eIndirectBuffer
+					| vk::BufferUsageFlagBits::eStorageBuffer,
+				"Detail Object Draw Command"
 			);
 
-			const vk::ImageView BaseMapView
-				= (ShaderEnvironment.BaseMap.Valid()
-					   ? NewScene.BitmapHeap.Bitmaps
-							 .at(ShaderEnvironment.BaseMap.TagID)
-							 .at(0)
-					   : NewScene.BitmapHeap.Bitmaps
-							 .at(NewScene.BitmapHeap.Default2D)
-							 .at(std::uint32_t(
-								 Blam::DefaultTextureIndex::Multiplicative
-							 )))
-					  .View.get();
-			const vk::ImageView PrimaryDetailMapView
-				= (ShaderEnvironment.PrimaryDetailMap.Valid()
-					   ? NewScene.BitmapHeap.Bitmaps
-							 .at(ShaderEnvironment.PrimaryDetailMap.TagID)
-							 .at(0)
-					   : NewScene.BitmapHeap.Bitmaps
-							 .at(NewScene.BitmapHeap.Default2D)
-							 .at(0))
-					  .View.get();
-			const vk::ImageView SecondaryDetailMapView
-				= (ShaderEnvironment.SecondaryDetailMap.Valid()
-					   ? NewScene.BitmapHeap.Bitmaps
-							 .at(ShaderEnvironment.SecondaryDetailMap.TagID)
-							 .at(0)
-					   : NewScene.BitmapHeap.Bitmaps
-							 .at(NewScene.BitmapHeap.Default2D)
-							 .at(0))
-					  .View.get();
-			const vk::ImageView MicroDetailMapView
-				= (ShaderEnvironment.MicroDetailMap.Valid()
-					   ? NewScene.BitmapHeap.Bitmaps
-							 .at(ShaderEnvironment.MicroDetailMap.TagID)
-							 .at(0)
-					   : NewScene.BitmapHeap.Bitmaps
-							 .at(NewScene.BitmapHeap.Default2D)
-							 .at(0))
-					  .View.get();
-			const vk::ImageView BumpMapView
-				= (ShaderEnvironment.BumpMap.Valid()
-					   ? NewScene.BitmapHeap.Bitmaps
-							 .at(ShaderEnvironment.BumpMap.TagID)
-							 .at(0)
-					   : NewScene.BitmapHeap.Bitmaps
-							 .at(NewScene.BitmapHeap.Default2D)
-							 .at(std::uint32_t(Blam::DefaultTextureIndex::Vector
-							 )))
-					  .View.get();
-			const vk::ImageView GlowMapView
-				= (ShaderEnvironment.GlowMap.Valid()
-					   ? NewScene.BitmapHeap.Bitmaps
-							 .at(ShaderEnvironment.GlowMap.TagID)
-							 .at(0)
-					   : NewScene.BitmapHeap.Bitmaps
-							 .at(NewScene.BitmapHeap.Default2D)
-							 .at(std::uint32_t(
-								 Blam::DefaultTextureIndex::Additive
-							 )))
-					  .View.get();
-			const vk::ImageView ReflectionCubeMapView
-				= (ShaderEnvironment.ReflectionCubeMap.Valid()
-					   ? NewScene.BitmapHeap.Bitmaps
-							 .at(ShaderEnvironment.ReflectionCubeMap.TagID)
-							 .at(0)
-					   : NewScene.BitmapHeap.Bitmaps
-							 .at(NewScene.BitmapHeap.DefaultCube)
-							 .at(0))
-					  .View.get();
+			if( !NewScene.DetailCellBuffer || !NewScene.DetailInstanceBuffer
+				|| !NewScene.DetailVisibleBuffer
+				|| !NewScene.DetailObjectDrawCommandBuffer )
+			{
+				return {};
+			}
 
-			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
-				NewSet, 0, BaseMapView, vk::ImageLayout::eShaderReadOnlyOptimal
+			if( auto [Result, Value] = Vulkan::CommitBufferHeap(
+					VulkanContext.LogicalDevice, VulkanContext.PhysicalDevice,
+					std::array{
+						NewScene.DetailCellBuffer.get(),
+						NewScene.DetailInstanceBuffer.get(),
+						NewScene.DetailVisibleBuffer.get(),
+						NewScene.DetailObjectDrawCommandBuffer.get()}
+				);
+				Result == vk::Result::eSuccess )
+			{
+				NewScene.DetailObjectMemory = std::move(Value);
+			}
+			else
+			{
+				std::fprintf(
+					stderr, "Error committing detail-object memory: %s\n",
+					vk::to_string(Result).c_str()
+				);
+				return {};
+			}
+
+			// The instance-count is written by the culling-shader
+			const vk::DrawIndirectCommand InitialDrawCommand(6, 0, 0, 0);
+
+			Vulkan::StreamBuffer& StreamBuffer
+				= TargetRenderer.GetStreamBuffer();
+			StreamBuffer.QueueBufferUpload(
+				std::as_bytes(std::span(DetailCells)),
+				NewScene.DetailCellBuffer.get()
 			);
-			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
-				NewSet, 1, PrimaryDetailMapView,
-				vk::ImageLayout::eShaderReadOnlyOptimal
+			StreamBuffer.QueueBufferUpload(
+				std::as_bytes(std::span(DetailInstances)),
+				NewScene.DetailInstanceBuffer.get()
 			);
-			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
-				NewSet, 2, SecondaryDetailMapView,
-				vk::ImageLayout::eShaderReadOnlyOptimal
+			StreamBuffer.QueueBufferUpload(
+				std::as_bytes(std::span(&InitialDrawCommand, 1)),
+				NewScene.DetailObjectDrawCommandBuffer.get()
 			);
-			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
-				NewSet, 3, MicroDetailMapView,
-				vk::ImageLayout::eShaderReadOnlyOptimal
+
+			// Culling pipeline
+			const auto DetailCullShaderData
+				= VkBlam::OpenResource("shaders/DetailObjects.comp.spv")
+					  .value();
+
+			NewScene.DetailCullShaderModule
+				= TargetRenderer.GetShaderModuleCache()
+					  .GetShaderModule(DetailCullShaderData)
+					  .value();
+
+			NewScene.DetailCullDescriptorPool
+				= std::make_unique<Vulkan::DescriptorHeap>(
+					Vulkan::DescriptorHeap::Create(
+						VulkanContext, DetailCullBindings, 1
+					)
+						.value()
+				);
+			NewScene.DetailCullDescriptor
+				= NewScene.DetailCullDescriptorPool->AllocateDescriptorSet()
+					  .value();
+
+			std::tie(
+				NewScene.DetailCullPipeline, NewScene.DetailCullPipelineLayout
+			)
+				= CreateComputePipeline(
+					VulkanContext.LogicalDevice, PipelineCache, {},
+					{{NewScene.DetailCullDescriptorPool->GetDescriptorSetLayout(
+					)}},
+					NewScene.DetailCullShaderModule
+				);
+
+			Vulkan::DescriptorUpdateBatch& DescriptorUpdateBatch
+				= TargetRenderer.GetDescriptorUpdateBatch();
+			DescriptorUpdateBatch.AddBuffer(
+				NewScene.DetailCullDescriptor, 0,
+				NewScene.DetailCellBuffer.get(), 0
 			);
-			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
-				NewSet, 4, BumpMapView, vk::ImageLayout::eShaderReadOnlyOptimal
+			DescriptorUpdateBatch.AddBuffer(
+				NewScene.DetailCullDescriptor, 1,
+				NewScene.DetailInstanceBuffer.get(), 0
 			);
-			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
-				NewSet, 5, GlowMapView, vk::ImageLayout::eShaderReadOnlyOptimal
+			DescriptorUpdateBatch.AddBuffer(
+				NewScene.DetailCullDescriptor, 2,
+				NewScene.DetailVisibleBuffer.get(), 0
 			);
-			TargetRenderer.GetDescriptorUpdateBatch().AddImage(
-				NewSet, 6, ReflectionCubeMapView,
-				vk::ImageLayout::eShaderReadOnlyOptimal
+			DescriptorUpdateBatch.AddBuffer(
+				NewScene.DetailCullDescriptor, 3,
+				NewScene.DetailObjectDrawCommandBuffer.get(), 0
+			);
+			DescriptorUpdateBatch.AddBuffer(
+				NewScene.DetailCullDescriptor, 4,
+				TargetRenderer.GetUniformRingBuffer().GetBuffer(), 0,
+				sizeof(DetailGlobals),
+				vk::DescriptorType::eUniformBufferDynamic
 			);
-		};
 
-		Blam::TagVisitorProc& ShaderEnvironmentProc
-			= TagVisitors.emplace_back();
+			// Draw pipeline
+			const std::array DetailObjectBindings = {
+				vk::DescriptorSetLayoutBinding(
+					0, vk::DescriptorType::eStorageBuffer, 1,
+					vk::ShaderStageFlagBits::eVertex
+				),
+			};
 
-		ShaderEnvironmentProc.VisitClass = Blam::TagClass::ShaderEnvironment;
+			NewScene.DetailObjectDescriptorPool
+				= std::make_unique<Vulkan::DescriptorHeap>(
+					Vulkan::DescriptorHeap::Create(
+						VulkanContext, DetailObjectBindings, 1
+					)
+						.value()
+				);
+			NewScene.DetailObjectDescriptor
+				= NewScene.DetailObjectDescriptorPool->AllocateDescriptorSet()
+					  .value();
 
-		ShaderEnvironmentProc.DependClasses
-			= {// Wait for bitmap loaders to finish
-			   Blam::TagClass::Bitmap};
+			DescriptorUpdateBatch.AddBuffer(
+				NewScene.DetailObjectDescriptor, 0,
+				NewScene.DetailVisibleBuffer.get(), 0
+			);
 
-		ShaderEnvironmentProc.VisitTags
-			= [&](std::span<const Blam::TagIndexEntry> TagIndexEntries,
-				  const Blam::MapFile&                 Map) -> void {
-			for( const auto& TagIndexEntry : TagIndexEntries )
+			const auto DetailObjectVertShaderData
+				= VkBlam::OpenResource("shaders/DetailObject.vert.spv").value();
+			const auto DetailObjectFragShaderData
+				= VkBlam::OpenResource("shaders/DetailObject.frag.spv").value();
+
+			NewScene.DetailObjectVertexShaderModule
+				= TargetRenderer.GetShaderModuleCache()
+					  .GetShaderModule(DetailObjectVertShaderData)
+					  .value();
+			NewScene.DetailObjectFragmentShaderModule
+				= TargetRenderer.GetShaderModuleCache()
+					  .GetShaderModule(DetailObjectFragShaderData)
+					  .value();
+
+			// No vertex input, the vertex shader reads the visible
+			// detail-objects and generates the corners of each quad
+			std::tie(
+				NewScene.DetailObjectPipeline,
+				NewScene.DetailObjectPipelineLayout
+			)
+				= CreateGraphicsPipeline(
+					VulkanContext.LogicalDevice, PipelineCache, {},
+					{{NewScene.SceneDescriptorPool->GetDescriptorSetLayout(),
+					  NewScene.DetailObjectDescriptorPool
+						  ->GetDescriptorSetLayout()}},
+					NewScene.DetailObjectVertexShaderModule,
+					NewScene.DetailObjectFragmentShaderModule, {}, {},
+					TargetRenderer.GetDefaultRenderPass(RenderSamples),
+					RenderSamples, vk::PolygonMode::eFill
+				);
+		}
+	}
+
+	// Recording contexts, the calling thread always records with the first
+	for( std::uint32_t ThreadIndex = 0;
+		 ThreadIndex < std::max(Config.RecordingThreads, 1u); ++ThreadIndex )
+	{
+		RecordingContext& CurContext
+			= NewScene.RecordingContexts.emplace_back();
+
+		vk::CommandPoolCreateInfo CommandPoolInfo = {};
+		CommandPoolInfo.queueFamilyIndex
+			= VulkanContext.RenderQueueFamilyIndex;
+
+		if( auto CreateResult
+			= VulkanContext.LogicalDevice.createCommandPoolUnique(
+				CommandPoolInfo
+			);
+			CreateResult.result == vk::Result::eSuccess )
+		{
+			CurContext.CommandPool = std::move(CreateResult.value);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error creating recording command pool: %s\n",
+				vk::to_string(CreateResult.result).c_str()
+			);
+			return {};
+		}
+
+		vk::CommandBufferAllocateInfo CommandBufferInfo = {};
+		CommandBufferInfo.commandPool = CurContext.CommandPool.get();
+		CommandBufferInfo.level       = vk::CommandBufferLevel::eSecondary;
+		// One command-buffer for the shading and one for the depth pre-pass
+		// of each render-phase
+		const std::uint32_t PhaseCount = NewScene.HasLatePhase() ? 2 : 1;
+		const std::uint32_t PhaseCommandBufferCount
+			= Config.DepthPrepass ? 2 : 1;
+		CommandBufferInfo.commandBufferCount
+			= PhaseCount * PhaseCommandBufferCount;
+
+		if( auto AllocateResult
+			= VulkanContext.LogicalDevice.allocateCommandBuffersUnique(
+				CommandBufferInfo
+			);
+			AllocateResult.result == vk::Result::eSuccess )
+		{
+			for( std::uint32_t Phase = 0; Phase < PhaseCount; ++Phase )
 			{
-				const auto& CurShader
-					= Map.GetTag<Blam::TagClass::ShaderEnvironment>(
-						TagIndexEntry.TagID
-					);
-				CreateShaderEnvironmentDescriptor(TagIndexEntry, *CurShader);
+				auto CurCommandBuffer = AllocateResult.value.begin()
+									  + Phase * PhaseCommandBufferCount;
+				CurContext.CommandBuffers[Phase]
+					= std::move(CurCommandBuffer[0]);
+				if( Config.DepthPrepass )
+				{
+					CurContext.DepthCommandBuffers[Phase]
+						= std::move(CurCommandBuffer[1]);
+				}
 			}
-		};
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error allocating recording command buffer: %s\n",
+				vk::to_string(AllocateResult.result).c_str()
+			);
+			return {};
+		}
+
+		for( std::uint32_t Phase = 0; Phase < PhaseCount; ++Phase )
+		{
+			Vulkan::SetObjectName(
+				VulkanContext.LogicalDevice,
+				CurContext.CommandBuffers[Phase].get(),
+				"VkBlam::Scene: Recording Command Buffer %u | Phase %u",
+				ThreadIndex, Phase
+			);
+			if( CurContext.DepthCommandBuffers[Phase] )
+			{
+				Vulkan::SetObjectName(
+					VulkanContext.LogicalDevice,
+					CurContext.DepthCommandBuffers[Phase].get(),
+					"VkBlam::Scene: Depth Recording Command Buffer %u | Phase "
+					"%u",
+					ThreadIndex, Phase
+				);
+			}
+		}
 	}
 
-	Blam::DispatchTagVisitors(TagVisitors, TargetWorld.GetMapFile());
+	NewScene.RecordingWorkers = std::make_unique<Common::WorkerPool>(
+		NewScene.RecordingContexts.size() - 1
+	);
 
 	return {std::move(NewScene)};
 }
@@ -1,5 +1,6 @@
 #include <VkBlam/World.hpp>
 
+#include <algorithm>
 #include <limits>
 
 namespace VkBlam
@@ -14,6 +15,59 @@ World::~World()
 {
 }
 
+static_assert(sizeof(glm::f32vec3) == sizeof(Blam::Vector3f));
+
+std::optional<std::uint16_t>
+	World::FindCluster(const glm::f32vec3& Position, std::size_t BSPIndex) const
+{
+	const auto ScenarioBSPs = MapFile.GetScenarioBSPs();
+	if( BSPIndex >= ScenarioBSPs.size() )
+	{
+		return std::nullopt;
+	}
+
+	const Blam::Tag<Blam::TagClass::Scenario>::StructureBSP& CurBSPEntry
+		= ScenarioBSPs[BSPIndex];
+	const Blam::VirtualHeap SBSPHeap
+		= CurBSPEntry.GetSBSPHeap(MapFile.GetMapData());
+
+	const std::int16_t Cluster = Blam::FindCluster(
+		SBSPHeap, CurBSPEntry.GetSBSP(SBSPHeap),
+		{Position.x, Position.y, Position.z}
+	);
+
+	if( Cluster < 0 )
+	{
+		return std::nullopt;
+	}
+	return static_cast<std::uint16_t>(Cluster);
+}
+
+void World::FindClusters(
+	std::span<const glm::f32vec3> Positions, std::span<std::int16_t> Clusters,
+	std::size_t BSPIndex
+) const
+{
+	const auto ScenarioBSPs = MapFile.GetScenarioBSPs();
+	if( BSPIndex >= ScenarioBSPs.size() )
+	{
+		std::fill(Clusters.begin(), Clusters.end(), std::int16_t(-1));
+		return;
+	}
+
+	const Blam::Tag<Blam::TagClass::Scenario>::StructureBSP& CurBSPEntry
+		= ScenarioBSPs[BSPIndex];
+	const Blam::VirtualHeap SBSPHeap
+		= CurBSPEntry.GetSBSPHeap(MapFile.GetMapData());
+
+	Blam::FindClusters(
+		SBSPHeap, CurBSPEntry.GetSBSP(SBSPHeap),
+		{reinterpret_cast<const Blam::Vector3f*>(Positions.data()),
+		 Positions.size()},
+		Clusters
+	);
+}
+
 std::optional<World> World::Create(const Blam::MapFile& MapFile)
 {
 	World NewWorld(MapFile);
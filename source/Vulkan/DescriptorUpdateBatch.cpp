@@ -19,7 +19,8 @@ void DescriptorUpdateBatch::Flush()
 
 void DescriptorUpdateBatch::AddImage(
 	vk::DescriptorSet TargetDescriptor, std::uint8_t TargetBinding,
-	vk::ImageView ImageView, vk::ImageLayout ImageLayout
+	vk::ImageView ImageView, vk::ImageLayout ImageLayout,
+	std::uint32_t TargetArrayElement
 )
 {
 	if( DescriptorWriteEnd >= DescriptorWriteMax )
@@ -33,7 +34,7 @@ void DescriptorUpdateBatch::AddImage(
 		);
 
 	DescriptorWrites[DescriptorWriteEnd] = vk::WriteDescriptorSet(
-		TargetDescriptor, TargetBinding, 0, 1,
+		TargetDescriptor, TargetBinding, TargetArrayElement, 1,
 		vk::DescriptorType::eSampledImage, &ImageInfo, nullptr, nullptr
 	);
 
@@ -88,7 +89,8 @@ void DescriptorUpdateBatch::AddImageSampler(
 
 void DescriptorUpdateBatch::AddBuffer(
 	vk::DescriptorSet TargetDescriptor, std::uint8_t TargetBinding,
-	vk::Buffer Buffer, vk::DeviceSize Offset, vk::DeviceSize Size
+	vk::Buffer Buffer, vk::DeviceSize Offset, vk::DeviceSize Size,
+	vk::DescriptorType DescriptorType
 )
 {
 	if( DescriptorWriteEnd >= DescriptorWriteMax )
@@ -102,8 +104,8 @@ void DescriptorUpdateBatch::AddBuffer(
 		);
 
 	DescriptorWrites[DescriptorWriteEnd] = vk::WriteDescriptorSet(
-		TargetDescriptor, TargetBinding, 0, 1,
-		vk::DescriptorType::eStorageImage, nullptr, &BufferInfo, nullptr
+		TargetDescriptor, TargetBinding, 0, 1, DescriptorType, nullptr,
+		&BufferInfo, nullptr
 	);
 
 	++DescriptorWriteEnd;
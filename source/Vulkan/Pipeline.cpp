@@ -1,7 +1,228 @@
-
 #include <Vulkan/Pipeline.hpp>
 
+#include <Common/Hash.hpp>
+
+#include <cstdio>
+
 namespace Vulkan
 {
 
+template<typename T>
+static std::uint64_t HashValues(std::uint64_t Hash, std::span<const T> Values)
+{
+	// Also hashes the count so that adjacent arrays can not alias
+	const std::uint64_t Count = Values.size();
+	Hash = Common::HashFNV1a(
+		std::as_bytes(std::span<const std::uint64_t, 1>(&Count, 1)), Hash
+	);
+	return Common::HashFNV1a(std::as_bytes(Values), Hash);
+}
+
+template<typename T>
+static std::uint64_t HashValue(std::uint64_t Hash, const T& Value)
+{
+	return Common::HashFNV1a(
+		std::as_bytes(std::span<const T, 1>(&Value, 1)), Hash
+	);
+}
+
+std::uint64_t GraphicsPipelineState::Hash() const
+{
+	std::uint64_t Hash = Common::FNV1aOffsetBasis;
+
+	Hash = HashValue(Hash, static_cast<VkPipelineLayout>(Layout));
+	Hash = HashValue(Hash, static_cast<VkShaderModule>(VertModule));
+	Hash = HashValue(Hash, static_cast<VkShaderModule>(FragModule));
+
+	Hash = HashValues<vk::VertexInputBindingDescription>(Hash, VertexBindings);
+	Hash = HashValues<vk::VertexInputAttributeDescription>(
+		Hash, VertexAttributes
+	);
+
+	Hash = HashValue(Hash, static_cast<VkRenderPass>(RenderPass));
+	Hash = HashValue(Hash, RenderSamples);
+	Hash = HashValue(Hash, PolygonMode);
+	Hash = HashValue(Hash, DepthCompareOp);
+	Hash = HashValue(Hash, DepthWriteEnable);
+	Hash = HashValue(Hash, BlendEnable);
+
+	Hash = HashValues<vk::SpecializationMapEntry>(
+		Hash, FragSpecializationEntries
+	);
+	Hash = HashValues<std::byte>(Hash, FragSpecializationData);
+
+	return Hash;
+}
+
+vk::UniquePipeline CreateGraphicsPipeline(
+	vk::Device Device, vk::PipelineCache PipelineCache,
+	const GraphicsPipelineState& State
+)
+{
+	const vk::SpecializationInfo FragSpecialization(
+		State.FragSpecializationEntries.size(),
+		State.FragSpecializationEntries.data(),
+		State.FragSpecializationData.size(),
+		State.FragSpecializationData.data()
+	);
+
+	// Describe the stage and entry point of each shader
+	const vk::PipelineShaderStageCreateInfo ShaderStagesInfo[2] = {
+		vk::PipelineShaderStageCreateInfo(
+			{},                               // Flags
+			vk::ShaderStageFlagBits::eVertex, // Shader Stage
+			State.VertModule,                 // Shader Module
+			"main", // Shader entry point function name
+			{}      // Shader specialization info
+		),
+		vk::PipelineShaderStageCreateInfo(
+			{},                                 // Flags
+			vk::ShaderStageFlagBits::eFragment, // Shader Stage
+			State.FragModule,                   // Shader Module
+			"main", // Shader entry point function name
+			State.FragSpecializationEntries.empty()
+				? nullptr
+				: &FragSpecialization // Shader specialization info
+		),
+	};
+
+	vk::PipelineVertexInputStateCreateInfo VertexInputState = {};
+
+	VertexInputState.vertexBindingDescriptionCount
+		= State.VertexBindings.size();
+	VertexInputState.pVertexBindingDescriptions = State.VertexBindings.data();
+
+	VertexInputState.vertexAttributeDescriptionCount
+		= State.VertexAttributes.size();
+	VertexInputState.pVertexAttributeDescriptions
+		= State.VertexAttributes.data();
+
+	vk::PipelineInputAssemblyStateCreateInfo InputAssemblyState = {};
+	InputAssemblyState.topology = vk::PrimitiveTopology::eTriangleList;
+	InputAssemblyState.primitiveRestartEnable = false;
+
+	vk::PipelineViewportStateCreateInfo ViewportState = {};
+
+	static const vk::Viewport DefaultViewport = {0, 0, 16, 16, 0.0f, 1.0f};
+	static const vk::Rect2D   DefaultScissor  = {{0, 0}, {16, 16}};
+	ViewportState.viewportCount               = 1;
+	ViewportState.pViewports                  = &DefaultViewport;
+	ViewportState.scissorCount                = 1;
+	ViewportState.pScissors                   = &DefaultScissor;
+
+	vk::PipelineRasterizationStateCreateInfo RasterizationState = {};
+
+	RasterizationState.depthClampEnable        = false;
+	RasterizationState.rasterizerDiscardEnable = false;
+	RasterizationState.polygonMode             = State.PolygonMode;
+	RasterizationState.cullMode                = vk::CullModeFlagBits::eBack;
+	RasterizationState.frontFace               = vk::FrontFace::eClockwise;
+	RasterizationState.depthBiasEnable         = false;
+	RasterizationState.depthBiasConstantFactor = 0.0f;
+	RasterizationState.depthBiasClamp          = 0.0f;
+	RasterizationState.depthBiasSlopeFactor    = 0.0;
+	RasterizationState.lineWidth               = 1.0f;
+
+	vk::PipelineMultisampleStateCreateInfo MultisampleState = {};
+
+	// Pipelines without a fragment shader only write depth
+	MultisampleState.rasterizationSamples  = State.RenderSamples;
+	MultisampleState.sampleShadingEnable   = bool(State.FragModule);
+	MultisampleState.minSampleShading      = 1.0f;
+	MultisampleState.pSampleMask           = nullptr;
+	MultisampleState.alphaToCoverageEnable = bool(State.FragModule);
+	MultisampleState.alphaToOneEnable      = false;
+
+	vk::PipelineDepthStencilStateCreateInfo DepthStencilState = {};
+
+	DepthStencilState.depthTestEnable       = true;
+	DepthStencilState.depthWriteEnable      = State.DepthWriteEnable;
+	DepthStencilState.depthCompareOp        = State.DepthCompareOp;
+	DepthStencilState.depthBoundsTestEnable = false;
+	DepthStencilState.stencilTestEnable     = false;
+	DepthStencilState.front                 = vk::StencilOp::eKeep;
+	DepthStencilState.back                  = vk::StencilOp::eKeep;
+	DepthStencilState.minDepthBounds        = 0.0f;
+	DepthStencilState.maxDepthBounds        = 1.0f;
+
+	vk::PipelineColorBlendStateCreateInfo ColorBlendState = {};
+
+	ColorBlendState.logicOpEnable   = false;
+	ColorBlendState.logicOp         = vk::LogicOp::eClear;
+	ColorBlendState.attachmentCount = 1;
+
+	vk::PipelineColorBlendAttachmentState BlendAttachmentState = {};
+
+	BlendAttachmentState.blendEnable         = false;
+	BlendAttachmentState.srcColorBlendFactor = vk::BlendFactor::eZero;
+	BlendAttachmentState.dstColorBlendFactor = vk::BlendFactor::eZero;
+	BlendAttachmentState.colorBlendOp        = vk::BlendOp::eAdd;
+	BlendAttachmentState.srcAlphaBlendFactor = vk::BlendFactor::eZero;
+	BlendAttachmentState.dstAlphaBlendFactor = vk::BlendFactor::eZero;
+	BlendAttachmentState.alphaBlendOp        = vk::BlendOp::eAdd;
+	if( State.BlendEnable )
+	{
+		// Non-premultiplied "over" blending
+		BlendAttachmentState.blendEnable = true;
+		BlendAttachmentState.srcColorBlendFactor
+			= vk::BlendFactor::eSrcAlpha;
+		BlendAttachmentState.dstColorBlendFactor
+			= vk::BlendFactor::eOneMinusSrcAlpha;
+		BlendAttachmentState.srcAlphaBlendFactor = vk::BlendFactor::eOne;
+		BlendAttachmentState.dstAlphaBlendFactor
+			= vk::BlendFactor::eOneMinusSrcAlpha;
+	}
+	if( State.FragModule )
+	{
+		BlendAttachmentState.colorWriteMask
+			= vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG
+			| vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA;
+	}
+
+	ColorBlendState.pAttachments = &BlendAttachmentState;
+
+	vk::PipelineDynamicStateCreateInfo DynamicState = {};
+	vk::DynamicState                   DynamicStates[]
+		= {// The viewport and scissor of the framebuffer will be dynamic at
+		   // run-time
+		   // so we definately add these
+		   vk::DynamicState::eViewport, vk::DynamicState::eScissor};
+	DynamicState.dynamicStateCount = std::size(DynamicStates);
+	DynamicState.pDynamicStates    = DynamicStates;
+
+	vk::GraphicsPipelineCreateInfo RenderPipelineInfo = {};
+
+	// Vert(+Frag)
+	RenderPipelineInfo.stageCount          = State.FragModule ? 2 : 1;
+	RenderPipelineInfo.pStages             = ShaderStagesInfo;
+	RenderPipelineInfo.pVertexInputState   = &VertexInputState;
+	RenderPipelineInfo.pInputAssemblyState = &InputAssemblyState;
+	RenderPipelineInfo.pViewportState      = &ViewportState;
+	RenderPipelineInfo.pRasterizationState = &RasterizationState;
+	RenderPipelineInfo.pMultisampleState   = &MultisampleState;
+	RenderPipelineInfo.pDepthStencilState  = &DepthStencilState;
+	RenderPipelineInfo.pColorBlendState    = &ColorBlendState;
+	RenderPipelineInfo.pDynamicState       = &DynamicState;
+	RenderPipelineInfo.subpass             = 0;
+	RenderPipelineInfo.renderPass          = State.RenderPass;
+	RenderPipelineInfo.layout              = State.Layout;
+
+	// Create Pipeline
+	if( auto CreateResult = Device.createGraphicsPipelineUnique(
+			PipelineCache, RenderPipelineInfo
+		);
+		CreateResult.result == vk::Result::eSuccess )
+	{
+		return std::move(CreateResult.value);
+	}
+	else
+	{
+		std::fprintf(
+			stderr, "Error creating graphics pipeline: %s\n",
+			vk::to_string(CreateResult.result).c_str()
+		);
+		return {};
+	}
+}
+
 } // namespace Vulkan
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include <Vulkan/PipelineCache.hpp>
+
+#include <Common/Hash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <span>
+#include <vector>
+
+namespace Vulkan
+{
+
+static constexpr std::uint32_t PipelineCacheMagic   = 0x43504B56; // "VKPC"
+static constexpr std::uint32_t PipelineCacheVersion = 1;
+
+// Precedes the data of the `vk::PipelineCache`. The driver validates its own
+// header as well, but some drivers are more lenient than others about which
+// data they accept, so the file is only given to the exact same device and
+// driver that wrote it
+struct PipelineCacheHeader
+{
+	std::uint32_t Magic;
+	std::uint32_t Version;
+	std::uint32_t VendorID;
+	std::uint32_t DeviceID;
+	std::uint32_t DriverVersion;
+	std::uint32_t DataSize;
+	// `vk::PhysicalDeviceProperties::pipelineCacheUUID`
+	std::array<std::uint8_t, VK_UUID_SIZE> PipelineCacheUUID;
+	// 64-bit FNV-1a of the data
+	std::uint64_t DataHash;
+};
+
+static PipelineCacheHeader
+	GetDeviceHeader(const vk::PhysicalDeviceProperties& Properties)
+{
+	PipelineCacheHeader Header = {};
+	Header.Magic               = PipelineCacheMagic;
+	Header.Version             = PipelineCacheVersion;
+	Header.VendorID            = Properties.vendorID;
+	Header.DeviceID            = Properties.deviceID;
+	Header.DriverVersion       = Properties.driverVersion;
+
+	std::copy(
+		Properties.pipelineCacheUUID.begin(),
+		Properties.pipelineCacheUUID.end(), Header.PipelineCacheUUID.begin()
+	);
+	return Header;
+}
+
+// Returns the data of the cache-file if it was written by this device and
+// driver
+static std::vector<std::byte> ReadPipelineCache(
+	const std::filesystem::path& CachePath, const PipelineCacheHeader& Expected
+)
+{
+	std::ifstream CacheFile(CachePath, std::ios::binary);
+	if( !CacheFile )
+	{
+		return {};
+	}
+
+	PipelineCacheHeader Header = {};
+	CacheFile.read(reinterpret_cast<char*>(&Header), sizeof(Header));
+	if( !CacheFile || Header.Magic != Expected.Magic
+		|| Header.Version != Expected.Version
+		|| Header.VendorID != Expected.VendorID
+		|| Header.DeviceID != Expected.DeviceID
+		|| Header.DriverVersion != Expected.DriverVersion
+		|| Header.PipelineCacheUUID != Expected.PipelineCacheUUID )
+	{
+		return {};
+	}
+
+	// Guards against allocating the size of a truncated or corrupt file
+	std::error_code ErrorCode;
+	if( std::filesystem::file_size(CachePath, ErrorCode)
+		!= sizeof(Header) + Header.DataSize )
+	{
+		return {};
+	}
+
+	std::vector<std::byte> Data(Header.DataSize);
+	CacheFile.read(reinterpret_cast<char*>(Data.data()), Data.size());
+	if( !CacheFile || Common::HashFNV1a(Data) != Header.DataHash )
+	{
+		return {};
+	}
+
+	return Data;
+}
+
+PipelineCache::PipelineCache(const Vulkan::Context& VulkanContext)
+	: VulkanContext(VulkanContext)
+{
+}
+
+const vk::PipelineCache& PipelineCache::GetPipelineCache() const
+{
+	return Cache.get();
+}
+
+bool PipelineCache::Save() const
+{
+	if( CachePath.empty() )
+	{
+		return true;
+	}
+
+	std::vector<std::uint8_t> CacheData;
+	if( auto DataResult
+		= VulkanContext.LogicalDevice.getPipelineCacheData(Cache.get());
+		DataResult.result == vk::Result::eSuccess )
+	{
+		CacheData = std::move(DataResult.value);
+	}
+	else
+	{
+		std::fprintf(
+			stderr, "Error getting pipeline cache data: %s\n",
+			vk::to_string(DataResult.result).c_str()
+		);
+		return false;
+	}
+
+	PipelineCacheHeader Header
+		= GetDeviceHeader(VulkanContext.PhysicalDevice.getProperties());
+	Header.DataSize = CacheData.size();
+	Header.DataHash = Common::HashFNV1a(std::as_bytes(std::span(CacheData)));
+
+	std::error_code ErrorCode;
+	std::filesystem::create_directories(CachePath.parent_path(), ErrorCode);
+
+	// Written to a temporary file first so that an interrupted write never
+	// leaves a partial cache behind
+	std::filesystem::path TempPath = CachePath;
+	TempPath += ".tmp";
+	{
+		std::ofstream CacheFile(TempPath, std::ios::binary | std::ios::trunc);
+		CacheFile.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+		CacheFile.write(
+			reinterpret_cast<const char*>(CacheData.data()), CacheData.size()
+		);
+		if( !CacheFile )
+		{
+			std::fprintf(
+				stderr, "Error writing pipeline cache: %s\n",
+				TempPath.string().c_str()
+			);
+			return false;
+		}
+	}
+
+	std::filesystem::rename(TempPath, CachePath, ErrorCode);
+	if( ErrorCode )
+	{
+		std::fprintf(
+			stderr, "Error writing pipeline cache: %s\n",
+			ErrorCode.message().c_str()
+		);
+		return false;
+	}
+	return true;
+}
+
+std::optional<PipelineCache> PipelineCache::Create(
+	const Vulkan::Context& VulkanContext, const std::filesystem::path& CachePath
+)
+{
+	PipelineCache NewPipelineCache(VulkanContext);
+	NewPipelineCache.CachePath = CachePath;
+
+	std::vector<std::byte> InitialData;
+	if( !CachePath.empty() )
+	{
+		InitialData = ReadPipelineCache(
+			CachePath,
+			GetDeviceHeader(VulkanContext.PhysicalDevice.getProperties())
+		);
+	}
+
+	vk::PipelineCacheCreateInfo PipelineCacheInfo = {};
+	PipelineCacheInfo.initialDataSize = InitialData.size();
+	PipelineCacheInfo.pInitialData    = InitialData.data();
+
+	if( auto CreateResult
+		= VulkanContext.LogicalDevice.createPipelineCacheUnique(
+			PipelineCacheInfo
+		);
+		CreateResult.result == vk::Result::eSuccess )
+	{
+		NewPipelineCache.Cache = std::move(CreateResult.value);
+	}
+	else
+	{
+		std::fprintf(
+			stderr, "Error creating pipeline cache: %s\n",
+			vk::to_string(CreateResult.result).c_str()
+		);
+		return std::nullopt;
+	}
+
+	return {std::move(NewPipelineCache)};
+}
+} // namespace Vulkan
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <Vulkan/PipelineRegistry.hpp>
+
+#include <algorithm>
+
+namespace Vulkan
+{
+
+PipelineRegistry::PipelineRegistry(
+	const Vulkan::Context& VulkanContext, vk::PipelineCache PipelineCache,
+	std::uint32_t WorkerCount
+)
+	: VulkanContext(VulkanContext), PipelineCache(PipelineCache)
+{
+	Workers.reserve(std::max(WorkerCount, 1u));
+	for( std::uint32_t i = 0; i < std::max(WorkerCount, 1u); ++i )
+	{
+		Workers.emplace_back(&PipelineRegistry::WorkerProc, this);
+	}
+}
+
+PipelineRegistry::~PipelineRegistry()
+{
+	{
+		std::scoped_lock Lock(Mutex);
+		Stopping = true;
+		for( const auto& CurJob : Jobs )
+		{
+			PendingKeys.erase(CurJob.first);
+		}
+		Jobs.clear();
+	}
+	JobCondition.notify_all();
+
+	for( std::thread& CurWorker : Workers )
+	{
+		CurWorker.join();
+	}
+}
+
+void PipelineRegistry::WorkerProc()
+{
+	while( true )
+	{
+		std::pair<std::uint64_t, GraphicsPipelineState> CurJob;
+		{
+			std::unique_lock Lock(Mutex);
+			JobCondition.wait(Lock, [&]() -> bool {
+				return Stopping || !Jobs.empty();
+			});
+			if( Stopping )
+			{
+				return;
+			}
+			CurJob = std::move(Jobs.front());
+			Jobs.pop_front();
+		}
+
+		// Pipeline-caches are internally synchronized, so all workers share
+		// the same one
+		vk::UniquePipeline NewPipeline = CreateGraphicsPipeline(
+			VulkanContext.LogicalDevice, PipelineCache, CurJob.second
+		);
+
+		{
+			std::scoped_lock Lock(Mutex);
+			if( const auto CurVariant = Variants.find(CurJob.first);
+				CurVariant != Variants.end() )
+			{
+				CurVariant->second.Pipeline = std::move(NewPipeline);
+			}
+			PendingKeys.erase(CurJob.first);
+			if( PendingKeys.empty() )
+			{
+				IdleCondition.notify_all();
+			}
+		}
+	}
+}
+
+std::uint64_t
+	PipelineRegistry::RequestPipeline(const GraphicsPipelineState& State)
+{
+	const std::uint64_t Hash = State.Hash();
+
+	std::uint64_t Key = 0;
+	{
+		std::scoped_lock Lock(Mutex);
+
+		// The hash only narrows down the variants, the states themselves
+		// must match
+		const auto [MatchBegin, MatchEnd] = VariantKeys.equal_range(Hash);
+		for( auto CurMatch = MatchBegin; CurMatch != MatchEnd; ++CurMatch )
+		{
+			Variant& CurVariant = Variants.at(CurMatch->second);
+			if( CurVariant.State == State )
+			{
+				++CurVariant.References;
+				return CurMatch->second;
+			}
+		}
+
+		Key = NextKey++;
+		VariantKeys.emplace(Hash, Key);
+		Variants.emplace(Key, Variant{State, Hash, {}, 1});
+		PendingKeys.insert(Key);
+		Jobs.emplace_back(Key, State);
+	}
+	JobCondition.notify_one();
+
+	return Key;
+}
+
+void PipelineRegistry::ReleasePipeline(std::uint64_t Key)
+{
+	std::scoped_lock Lock(Mutex);
+
+	const auto CurVariant = Variants.find(Key);
+	if( CurVariant == Variants.end() || --CurVariant->second.References )
+	{
+		return;
+	}
+
+	const auto [MatchBegin, MatchEnd]
+		= VariantKeys.equal_range(CurVariant->second.Hash);
+	VariantKeys.erase(std::find_if(
+		MatchBegin, MatchEnd,
+		[&](const auto& CurMatch) -> bool { return CurMatch.second == Key; }
+	));
+	Variants.erase(CurVariant);
+}
+
+vk::Pipeline PipelineRegistry::FindPipeline(std::uint64_t Key) const
+{
+	std::scoped_lock Lock(Mutex);
+	if( const auto CurVariant = Variants.find(Key);
+		CurVariant != Variants.end() )
+	{
+		return CurVariant->second.Pipeline.get();
+	}
+	return {};
+}
+
+bool PipelineRegistry::IsPending(std::uint64_t Key) const
+{
+	std::scoped_lock Lock(Mutex);
+	return PendingKeys.contains(Key);
+}
+
+void PipelineRegistry::WaitIdle()
+{
+	std::unique_lock Lock(Mutex);
+	IdleCondition.wait(Lock, [&]() -> bool { return PendingKeys.empty(); });
+}
+
+} // namespace Vulkan
\ No newline at end of file
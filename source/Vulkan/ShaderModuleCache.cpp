@@ -1,7 +1,11 @@
 #include <Vulkan/ShaderModuleCache.hpp>
 
+#include <Common/Hash.hpp>
+
 #include <vulkan/vulkan_hash.hpp>
 
+#include <algorithm>
+
 namespace Vulkan
 {
 
@@ -10,14 +14,19 @@ ShaderModuleCache::ShaderModuleCache(const Vulkan::Context& VulkanContext)
 {
 }
 
-std::optional<const vk::ShaderModule> ShaderModuleCache::GetShaderModule(
-	std::size_t Hash, std::span<const std::byte> ShaderCode
-)
+std::optional<const vk::ShaderModule>
+	ShaderModuleCache::GetShaderModule(std::span<const std::byte> ShaderCode)
 {
-	// Cache hit
-	if( ShaderModuleMap.contains(Hash) )
+	const std::uint64_t Hash = Common::HashFNV1a(ShaderCode);
+
+	// Cache hit, only if the code itself matches
+	const auto [MatchBegin, MatchEnd] = ShaderModuleMap.equal_range(Hash);
+	for( auto CurMatch = MatchBegin; CurMatch != MatchEnd; ++CurMatch )
 	{
-		return {ShaderModuleMap.at(Hash).get()};
+		if( std::ranges::equal(CurMatch->second.ShaderCode, ShaderCode) )
+		{
+			return {CurMatch->second.ShaderModule.get()};
+		}
 	}
 
 	vk::ShaderModuleCreateInfo ShaderModuleInfo = {};
@@ -30,10 +39,13 @@ std::optional<const vk::ShaderModule> ShaderModuleCache::GetShaderModule(
 		);
 		CreateResult.result == vk::Result::eSuccess )
 	{
-		const auto Iterator
-			= ShaderModuleMap.insert({Hash, std::move(CreateResult.value)});
+		const auto Iterator = ShaderModuleMap.insert(
+			{Hash,
+			 {std::vector<std::byte>(ShaderCode.begin(), ShaderCode.end()),
+			  std::move(CreateResult.value)}}
+		);
 
-		return {Iterator.first->second.get()};
+		return {Iterator->second.ShaderModule.get()};
 	}
 	else
 	{
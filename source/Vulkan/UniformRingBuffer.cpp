@@ -0,0 +1,318 @@
+#include <Vulkan/UniformRingBuffer.hpp>
+
+#include "Common/Alignment.hpp"
+#include "Common/Format.hpp"
+#include <Vulkan/Debug.hpp>
+#include <Vulkan/Memory.hpp>
+
+#include <algorithm>
+
+namespace Vulkan
+{
+UniformRingBuffer::UniformRingBuffer(
+	const Vulkan::Context& VulkanContext, vk::DeviceSize BufferSize
+)
+	: VulkanContext(VulkanContext), BufferSize(BufferSize), FenceTick(0),
+	  RingOffset(0), RingUsed(0), UnfencedSize(0)
+{
+	OffsetAlignment = VulkanContext.PhysicalDevice.getProperties()
+						  .limits.minUniformBufferOffsetAlignment;
+
+	//// Create Semaphore
+	{
+		vk::StructureChain<vk::SemaphoreCreateInfo, vk::SemaphoreTypeCreateInfo>
+			FenceSemaphoreInfoChain = {};
+
+		auto& FenceSemaphoreTypeInfo
+			= FenceSemaphoreInfoChain.get<vk::SemaphoreTypeCreateInfo>();
+
+		FenceSemaphoreTypeInfo.initialValue  = 0;
+		FenceSemaphoreTypeInfo.semaphoreType = vk::SemaphoreType::eTimeline;
+
+		if( auto CreateResult
+			= VulkanContext.LogicalDevice.createSemaphoreUnique(
+				FenceSemaphoreInfoChain.get()
+			);
+			CreateResult.result == vk::Result::eSuccess )
+		{
+			FenceSemaphore = std::move(CreateResult.value);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error creating uniform ring semaphore: %s\n",
+				vk::to_string(CreateResult.result).c_str()
+			);
+			/// ??? should we exit the program
+		}
+		Vulkan::SetObjectName(
+			VulkanContext.LogicalDevice, FenceSemaphore.get(),
+			"UniformRingBuffer: Fence Semaphore"
+		);
+	}
+
+	//// Create buffer
+	{
+		vk::BufferCreateInfo RingBufferInfo;
+		RingBufferInfo.size  = BufferSize;
+		RingBufferInfo.usage = vk::BufferUsageFlagBits::eUniformBuffer
+							 | vk::BufferUsageFlagBits::eTransferSrc;
+
+		if( auto CreateResult
+			= VulkanContext.LogicalDevice.createBufferUnique(RingBufferInfo);
+			CreateResult.result == vk::Result::eSuccess )
+		{
+			RingBuffer = std::move(CreateResult.value);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error creating uniform ring buffer: %s\n",
+				vk::to_string(CreateResult.result).c_str()
+			);
+			/// ??? should we exit the program
+		}
+		Vulkan::SetObjectName(
+			VulkanContext.LogicalDevice, RingBuffer.get(),
+			"UniformRingBuffer: Ring Buffer( %s )",
+			Common::FormatByteCount(BufferSize).c_str()
+		);
+	}
+
+	//// Allocate memory for the ring buffer
+	{
+		const vk::MemoryRequirements RingBufferMemoryRequirements
+			= VulkanContext.LogicalDevice.getBufferMemoryRequirements(
+				RingBuffer.get()
+			);
+
+		vk::MemoryAllocateInfo RingBufferAllocInfo = {};
+		RingBufferAllocInfo.allocationSize = RingBufferMemoryRequirements.size;
+
+		// Try to get some shared memory
+		std::int32_t RingBufferHeapIndex = Vulkan::FindMemoryTypeIndex(
+			VulkanContext.PhysicalDevice,
+			RingBufferMemoryRequirements.memoryTypeBits,
+			vk::MemoryPropertyFlagBits::eHostVisible
+				| vk::MemoryPropertyFlagBits::eHostCoherent
+				| vk::MemoryPropertyFlagBits::eDeviceLocal
+		);
+
+		// If that failed, then just get some host memory
+		if( RingBufferHeapIndex < 0 )
+		{
+			RingBufferHeapIndex = Vulkan::FindMemoryTypeIndex(
+				VulkanContext.PhysicalDevice,
+				RingBufferMemoryRequirements.memoryTypeBits,
+				vk::MemoryPropertyFlagBits::eHostVisible
+					| vk::MemoryPropertyFlagBits::eHostCoherent
+			);
+		}
+
+		RingBufferAllocInfo.memoryTypeIndex = RingBufferHeapIndex;
+
+		if( auto AllocResult = VulkanContext.LogicalDevice.allocateMemoryUnique(
+				RingBufferAllocInfo
+			);
+			AllocResult.result == vk::Result::eSuccess )
+		{
+			RingBufferMemory = std::move(AllocResult.value);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error allocating memory for uniform ring buffer: %s\n",
+				vk::to_string(AllocResult.result).c_str()
+			);
+			/// ??? should we exit the program
+		}
+		Vulkan::SetObjectName(
+			VulkanContext.LogicalDevice, RingBufferMemory.get(),
+			"UniformRingBuffer: Ring Buffer Memory( %s )",
+			Common::FormatByteCount(BufferSize).c_str()
+		);
+
+		if( auto BindResult = VulkanContext.LogicalDevice.bindBufferMemory(
+				RingBuffer.get(), RingBufferMemory.get(), 0
+			);
+			BindResult != vk::Result::eSuccess )
+		{
+			std::fprintf(
+				stderr, "Error binding memory to uniform ring buffer: %s\n",
+				vk::to_string(BindResult).c_str()
+			);
+			/// ??? should we exit the program
+		}
+	}
+
+	//// Map the device memory
+	if( auto MapResult = VulkanContext.LogicalDevice.mapMemory(
+			RingBufferMemory.get(), 0, BufferSize
+		);
+		MapResult.result == vk::Result::eSuccess )
+	{
+		RingMemoryMapped = std::span<std::byte>(
+			reinterpret_cast<std::byte*>(MapResult.value), BufferSize
+		);
+	}
+	else
+	{
+		std::fprintf(
+			stderr, "Error mapping uniform ring buffer memory: %s\n",
+			vk::to_string(MapResult.result).c_str()
+		);
+		/// ??? should we exit the program
+	}
+}
+
+UniformRingBuffer::~UniformRingBuffer()
+{
+	VulkanContext.LogicalDevice.unmapMemory(RingBufferMemory.get());
+}
+
+bool UniformRingBuffer::Reclaim(bool Wait)
+{
+	if( FencedRegions.empty() )
+	{
+		return false;
+	}
+
+	if( Wait )
+	{
+		vk::SemaphoreWaitInfo WaitInfo;
+		WaitInfo.semaphoreCount = 1;
+		WaitInfo.pSemaphores    = &GetSemaphore();
+		WaitInfo.pValues        = &FencedRegions.front().Tick;
+		if( auto WaitResult
+			= VulkanContext.LogicalDevice.waitSemaphores(WaitInfo, ~0ULL);
+			WaitResult != vk::Result::eSuccess )
+		{
+			std::fprintf(
+				stderr, "Error waiting on uniform ring buffer semaphore \n"
+			);
+			return false;
+		}
+	}
+
+	// Get where the GPU is at in our fence-timeline
+	std::uint64_t GpuFenceTick = 0;
+	if( auto GetResult = VulkanContext.LogicalDevice.getSemaphoreCounterValue(
+			FenceSemaphore.get()
+		);
+		GetResult.result == vk::Result::eSuccess )
+	{
+		GpuFenceTick = GetResult.value;
+	}
+	else
+	{
+		std::fprintf(
+			stderr, "Error getting timeline semaphore value: %s\n",
+			vk::to_string(GetResult.result).c_str()
+		);
+		return false;
+	}
+
+	while( !FencedRegions.empty()
+		   && FencedRegions.front().Tick <= GpuFenceTick )
+	{
+		RingUsed -= FencedRegions.front().Size;
+		FencedRegions.pop_front();
+	}
+
+	return true;
+}
+
+std::optional<std::uint32_t>
+	UniformRingBuffer::Push(const std::span<const std::byte> Data)
+{
+	if( Data.size_bytes() > BufferSize )
+	{
+		std::fprintf(
+			stderr, "Uniform ring buffer overflow: %zu > %zu \n",
+			Data.size_bytes(), BufferSize
+		);
+		return std::nullopt;
+	}
+
+	// Restart at the beginning whenever the ring is empty
+	if( RingUsed == 0 )
+	{
+		RingOffset = 0;
+	}
+
+	while( true )
+	{
+		// The bytes skipped by alignment or by wrapping around to the start
+		// of the ring are consumed along with the data
+		std::uint64_t CurRingOffset
+			= Common::AlignUp(RingOffset, OffsetAlignment);
+		if( CurRingOffset + Data.size_bytes() > BufferSize )
+		{
+			CurRingOffset = 0;
+		}
+
+		const vk::DeviceSize ConsumedSize
+			= (CurRingOffset >= RingOffset
+				   ? CurRingOffset - RingOffset
+				   : BufferSize - RingOffset + CurRingOffset)
+			+ Data.size_bytes();
+
+		if( RingUsed + ConsumedSize <= BufferSize )
+		{
+			RingOffset = CurRingOffset + Data.size_bytes();
+			RingUsed += ConsumedSize;
+			UnfencedSize += ConsumedSize;
+
+			std::copy(
+				Data.begin(), Data.end(),
+				RingMemoryMapped.subspan(CurRingOffset).begin()
+			);
+
+			return static_cast<std::uint32_t>(CurRingOffset);
+		}
+
+		// Blocking wait since the ring is full of work that is still in
+		// flight
+		if( !Reclaim(true) )
+		{
+			std::fprintf(
+				stderr, "Uniform ring buffer full of unfenced data: %zu\n",
+				UnfencedSize
+			);
+			return std::nullopt;
+		}
+	}
+}
+
+std::uint64_t UniformRingBuffer::Fence()
+{
+	++FenceTick;
+
+	if( UnfencedSize )
+	{
+		FencedRegions.push_back(FencedRegion{UnfencedSize, FenceTick});
+		UnfencedSize = 0;
+	}
+
+	// Free up anything that the GPU is already done with
+	Reclaim(false);
+
+	return FenceTick;
+}
+
+std::uint64_t UniformRingBuffer::GetPendingTick() const
+{
+	return FenceTick + 1;
+}
+
+vk::Buffer UniformRingBuffer::GetBuffer() const
+{
+	return RingBuffer.get();
+}
+
+const vk::Semaphore& UniformRingBuffer::GetSemaphore() const
+{
+	return FenceSemaphore.get();
+}
+
+} // namespace Vulkan
\ No newline at end of file
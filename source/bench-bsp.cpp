@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <mio/mmap.hpp>
+
+#include <Blam/Blam.hpp>
+
+// Microbenchmarks of the BSP visibility routines and the model-vertex decoder
+// against their reference implementations
+
+static constexpr std::size_t IterationCount = 1024;
+
+// Random overlap-tests within the world bounds of the BSP
+static std::vector<Blam::Bounds3D>
+	GenerateOverlapTests(const Blam::Bounds3D& WorldBounds, std::size_t Count)
+{
+	std::mt19937                          RNG(0x5B5B);
+	std::uniform_real_distribution<float> Unit(0.0f, 1.0f);
+
+	const auto Lerp = [&](const Blam::Vector2f& Range) -> float {
+		return Range[0] + (Range[1] - Range[0]) * Unit(RNG);
+	};
+
+	std::vector<Blam::Bounds3D> Tests(Count);
+	for( Blam::Bounds3D& CurTest : Tests )
+	{
+		const float CenterX = Lerp(WorldBounds.BoundsX);
+		const float CenterY = Lerp(WorldBounds.BoundsY);
+		const float CenterZ = Lerp(WorldBounds.BoundsZ);
+		const float Extent  = 1.0f + 8.0f * Unit(RNG);
+
+		CurTest.BoundsX = {CenterX - Extent, CenterX + Extent};
+		CurTest.BoundsY = {CenterY - Extent, CenterY + Extent};
+		CurTest.BoundsZ = {CenterZ - Extent, CenterZ + Extent};
+	}
+	return Tests;
+}
+
+template<typename FuncT>
+static double BenchmarkMicroseconds(FuncT Func)
+{
+	const auto Start = std::chrono::high_resolution_clock::now();
+	for( std::size_t i = 0; i < IterationCount; ++i )
+	{
+		Func(i);
+	}
+	const auto End = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::micro>(End - Start).count()
+		 / IterationCount;
+}
+
+static void BenchmarkSubClusterBounds(
+	const Blam::VirtualHeap&                                SBSPHeap,
+	const Blam::Tag<Blam::TagClass::ScenarioStructureBsp>& ScenarioBSP
+)
+{
+	const auto Clusters = SBSPHeap.GetBlock(ScenarioBSP.Clusters);
+
+	const Blam::BakedSubClusterBounds Baked
+		= Blam::BakeSubClusterBounds(SBSPHeap, ScenarioBSP);
+
+	const std::vector<Blam::Bounds3D> Tests
+		= GenerateOverlapTests(ScenarioBSP.WorldBounds, IterationCount);
+
+	std::vector<std::uint32_t> ReferenceBits(0x2'0000 / 32);
+	std::vector<std::uint32_t> BakedBits(0x2'0000 / 32);
+
+	std::vector<std::uint8_t> HitMask(Baked.GetPaddedCount() / 8);
+
+	std::size_t Mismatches = 0;
+
+	const double ReferenceTime = BenchmarkMicroseconds([&](std::size_t i) {
+		std::fill(ReferenceBits.begin(), ReferenceBits.end(), 0);
+		for( const auto& CurCluster : Clusters )
+		{
+			Blam::GenerateVisibleSurfaceIndices(
+				SBSPHeap, SBSPHeap.GetBlock(CurCluster.SubClusters), Tests[i],
+				Blam::SurfaceOcclusionBitArray(ReferenceBits)
+			);
+		}
+	});
+
+	const double BakedTime = BenchmarkMicroseconds([&](std::size_t i) {
+		std::fill(BakedBits.begin(), BakedBits.end(), 0);
+		Blam::GenerateVisibleSurfaceIndices(
+			SBSPHeap, Baked, Tests[i], HitMask,
+			Blam::SurfaceOcclusionBitArray(BakedBits)
+		);
+	});
+
+	// Validate the last iteration of each
+	Mismatches += !std::equal(
+		ReferenceBits.begin(), ReferenceBits.end(), BakedBits.begin()
+	);
+
+	const double ReferenceKernelTime
+		= BenchmarkMicroseconds([&](std::size_t i) {
+			  std::size_t SubClusterIndex = 0;
+			  std::fill(HitMask.begin(), HitMask.end(), 0);
+			  for( const auto& CurCluster : Clusters )
+			  {
+				  for( const auto& CurSubCluster :
+					   SBSPHeap.GetBlock(CurCluster.SubClusters) )
+				  {
+					  HitMask[SubClusterIndex / 8]
+						  |= Tests[i].Intersects(CurSubCluster.WorldBounds)
+						  << (SubClusterIndex % 8);
+					  ++SubClusterIndex;
+				  }
+			  }
+		  });
+
+	const double BakedKernelTime = BenchmarkMicroseconds([&](std::size_t i) {
+		Blam::IntersectSubClusterBounds(Baked, Tests[i], HitMask);
+	});
+
+	std::printf(
+		"\tSub-clusters: %zu (%zu clusters)\n"
+		"\tOverlap-test only: %8.3fus -> %8.3fus (%.2fx)\n"
+		"\tVisible surfaces:  %8.3fus -> %8.3fus (%.2fx)\n"
+		"\tMismatches: %zu\n",
+		Baked.SurfaceIndices.size(), Clusters.size(), ReferenceKernelTime,
+		BakedKernelTime, ReferenceKernelTime / BakedKernelTime, ReferenceTime,
+		BakedTime, ReferenceTime / BakedTime, Mismatches
+	);
+}
+
+static void BenchmarkModelVertexDecode()
+{
+	// Random compressed vertices, every bit-pattern of a packed vector or
+	// texture-coordinate is valid
+	constexpr std::size_t VertexCount = 0x1'0000;
+
+	std::mt19937 RNG(0x5B5B);
+
+	std::vector<Blam::CompressedModelVertex> Source(VertexCount);
+	for( Blam::CompressedModelVertex& CurVertex : Source )
+	{
+		std::array<std::uint32_t, sizeof(Blam::CompressedModelVertex) / 4>
+			Words;
+		for( std::uint32_t& CurWord : Words )
+		{
+			CurWord = RNG();
+		}
+		std::memcpy(&CurVertex, Words.data(), sizeof(CurVertex));
+	}
+
+	constexpr float UScale = 2.5f;
+	constexpr float VScale = 0.75f;
+
+	std::vector<Blam::ModelVertex> ReferenceVertices(VertexCount);
+	std::vector<Blam::ModelVertex> DecodedVertices(VertexCount);
+
+	const double ReferenceTime = BenchmarkMicroseconds([&](std::size_t) {
+		for( std::size_t i = 0; i < VertexCount; ++i )
+		{
+			ReferenceVertices[i]
+				= Blam::DecodeCompressedVertex(Source[i], UScale, VScale);
+		}
+	});
+
+	const double DecodeTime = BenchmarkMicroseconds([&](std::size_t) {
+		Blam::DecodeCompressedVertices(
+			Source, UScale, VScale, DecodedVertices
+		);
+	});
+
+	std::size_t Mismatches = 0;
+	for( std::size_t i = 0; i < VertexCount; ++i )
+	{
+		Mismatches += std::memcmp(
+						  &ReferenceVertices[i], &DecodedVertices[i],
+						  sizeof(Blam::ModelVertex)
+					  )
+				   != 0;
+	}
+
+	std::printf(
+		"Model-vertex decode\n"
+		"\tVertices: %zu\n"
+		"\tDecode: %8.3fus -> %8.3fus (%.2fx) | %.1f vertices/us\n"
+		"\tMismatches: %zu\n",
+		VertexCount, ReferenceTime, DecodeTime, ReferenceTime / DecodeTime,
+		double(VertexCount) / DecodeTime, Mismatches
+	);
+}
+
+int main(int argc, char* argv[])
+{
+	if( argc < 2 )
+	{
+		// Not enough arguments
+		std::fprintf(stderr, "Usage: %s (map file)\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	auto MapFile = mio::mmap_source(argv[1]);
+
+	Blam::MapFile CurMap(
+		std::span<const std::byte>(
+			reinterpret_cast<const std::byte*>(MapFile.data()), MapFile.size()
+		),
+		{}
+	);
+
+	const auto MapData = CurMap.GetMapData();
+
+	for( const Blam::Tag<Blam::TagClass::Scenario>::StructureBSP& CurSBSP :
+		 CurMap.GetScenarioBSPs() )
+	{
+		const Blam::VirtualHeap SBSPHeap = CurSBSP.GetSBSPHeap(MapData);
+		const Blam::Tag<Blam::TagClass::ScenarioStructureBsp>& ScenarioBSP
+			= CurSBSP.GetSBSP(SBSPHeap);
+
+		std::printf(
+			"%s\n",
+			CurSBSP.BSP.PathVirtualOffset
+				? &CurMap.TagHeap.Read<char>(CurSBSP.BSP.PathVirtualOffset)
+				: "(Unnamed BSP)"
+		);
+
+		BenchmarkSubClusterBounds(SBSPHeap, ScenarioBSP);
+	}
+
+	BenchmarkModelVertexDecode();
+
+	return EXIT_SUCCESS;
+}
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cinttypes>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
@@ -7,6 +8,9 @@
 #include <filesystem>
 #include <map>
 #include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include <Common/Alignment.hpp>
 #include <Common/Format.hpp>
@@ -45,7 +49,9 @@ static constexpr glm::uvec2 RenderSize = {1024, 1024};
 
 vk::UniqueRenderPass CreateMainRenderPass(
 	vk::Device              Device,
-	vk::SampleCountFlagBits SampleCount = vk::SampleCountFlagBits::e1
+	vk::SampleCountFlagBits SampleCount = vk::SampleCountFlagBits::e1,
+	vk::AttachmentLoadOp    LoadOp      = vk::AttachmentLoadOp::eClear,
+	vk::AttachmentStoreOp   StoreOp     = vk::AttachmentStoreOp::eDontCare
 );
 
 vk::UniqueFramebuffer CreateMainFrameBuffer(
@@ -87,6 +93,46 @@ int main(int argc, char* argv[])
 	std::filesystem::path MapPath(argv[1]);
 	std::filesystem::path BitmapPath(argv[2]);
 
+	// Optional arguments
+	bool                  DepthPrepass      = true;
+	bool                  OcclusionCulling  = true;
+	std::uint32_t         LODCount          = 0;
+	std::filesystem::path LODCachePath      = {};
+	std::filesystem::path PipelineCachePath = {};
+	vk::DeviceSize        BSPMemoryBudget   = 0;
+	for( int ArgIndex = 3; ArgIndex < argc; ++ArgIndex )
+	{
+		if( std::string_view(argv[ArgIndex]) == "--no-depth-prepass" )
+		{
+			DepthPrepass = false;
+		}
+		else if( std::string_view(argv[ArgIndex]) == "--no-occlusion-culling" )
+		{
+			OcclusionCulling = false;
+		}
+		else if( std::string_view(argv[ArgIndex]) == "--lods" )
+		{
+			LODCount = 3;
+		}
+		else if( std::string_view(argv[ArgIndex]) == "--lod-cache"
+				 && ArgIndex + 1 < argc )
+		{
+			LODCachePath = argv[++ArgIndex];
+		}
+		else if( std::string_view(argv[ArgIndex]) == "--pipeline-cache"
+				 && ArgIndex + 1 < argc )
+		{
+			PipelineCachePath = argv[++ArgIndex];
+		}
+		else if( std::string_view(argv[ArgIndex]) == "--bsp-budget"
+				 && ArgIndex + 1 < argc )
+		{
+			// Mebibytes
+			BSPMemoryBudget
+				= std::strtoull(argv[++ArgIndex], nullptr, 10) * 1_MiB;
+		}
+	}
+
 	auto MapFile    = mio::mmap_source(MapPath.c_str());
 	auto BitmapFile = mio::mmap_source(BitmapPath.c_str());
 
@@ -110,7 +156,7 @@ int main(int argc, char* argv[])
 	//// Create Instance
 
 	vk::ApplicationInfo ApplicationInfo = {};
-	ApplicationInfo.apiVersion          = VK_API_VERSION_1_1;
+	ApplicationInfo.apiVersion          = VK_API_VERSION_1_2;
 
 	ApplicationInfo.pEngineName   = "VkBlam";
 	ApplicationInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
@@ -196,17 +242,30 @@ int main(int argc, char* argv[])
 	//// Create Device
 	vk::DeviceCreateInfo DeviceInfo = {};
 
-	static const char* DeviceExtensions[] = {
+	std::vector<const char*> DeviceExtensions = {};
 #if defined(__APPLE__)
-		"VK_KHR_portability_subset",
+	DeviceExtensions.push_back("VK_KHR_portability_subset");
 #endif
-		VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME
-	};
-	DeviceInfo.ppEnabledExtensionNames = DeviceExtensions;
-	DeviceInfo.enabledExtensionCount   = std::size(DeviceExtensions);
+
+	// The Vulkan 1.2 features may only be queried and enabled on devices that
+	// implement 1.2. Older devices get timeline-semaphores from the extension
+	// and go without GPU-culling and bindless-textures
+	const bool Vulkan12Supported
+		= PhysicalDevice.getProperties().apiVersion >= VK_API_VERSION_1_2;
+
+	vk::StructureChain<
+		vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>
+		SupportedFeatureChain = {};
+	if( !Vulkan12Supported )
+	{
+		SupportedFeatureChain.unlink<vk::PhysicalDeviceVulkan12Features>();
+	}
+	PhysicalDevice.getFeatures2(
+		&SupportedFeatureChain.get<vk::PhysicalDeviceFeatures2>()
+	);
 
 	vk::StructureChain<
-		vk::PhysicalDeviceFeatures2,
+		vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features,
 		vk::PhysicalDeviceTimelineSemaphoreFeatures>
 		DeviceFeatureChain = {};
 
@@ -216,11 +275,57 @@ int main(int argc, char* argv[])
 	DeviceFeatures.sampleRateShading = true;
 	// DeviceFeatures.wideLines         = true; // Not supported on MoltenVK
 	DeviceFeatures.fillModeNonSolid = true;
+	// Used to measure the fragment-shader invocations of the scene's draws
+	const bool PipelineStatisticsSupported
+		= SupportedFeatureChain.get<vk::PhysicalDeviceFeatures2>()
+			  .features.pipelineStatisticsQuery
+	   && SupportedFeatureChain.get<vk::PhysicalDeviceFeatures2>()
+			  .features.inheritedQueries;
+	DeviceFeatures.pipelineStatisticsQuery = PipelineStatisticsSupported;
+	DeviceFeatures.inheritedQueries        = PipelineStatisticsSupported;
+	// Used by the indirect draws of the scenario objects and of GPU-culling
+	DeviceFeatures.multiDrawIndirect
+		= SupportedFeatureChain.get<vk::PhysicalDeviceFeatures2>()
+			  .features.multiDrawIndirect;
+	DeviceFeatures.drawIndirectFirstInstance
+		= SupportedFeatureChain.get<vk::PhysicalDeviceFeatures2>()
+			  .features.drawIndirectFirstInstance;
+
+	auto& DeviceVulkan12Features
+		= DeviceFeatureChain.get<vk::PhysicalDeviceVulkan12Features>();
+	DeviceVulkan12Features.timelineSemaphore = true;
+	// Used by GPU-culling
+	DeviceVulkan12Features.drawIndirectCount
+		= SupportedFeatureChain.get<vk::PhysicalDeviceVulkan12Features>()
+			  .drawIndirectCount;
+	// Used by bindless-textures
+	const bool BindlessSupported
+		= SupportedFeatureChain.get<vk::PhysicalDeviceVulkan12Features>()
+			  .shaderSampledImageArrayNonUniformIndexing
+	   && SupportedFeatureChain.get<vk::PhysicalDeviceVulkan12Features>()
+			  .runtimeDescriptorArray;
+	DeviceVulkan12Features.shaderSampledImageArrayNonUniformIndexing
+		= BindlessSupported;
+	DeviceVulkan12Features.runtimeDescriptorArray = BindlessSupported;
 
 	auto& DeviceTimelineFeatures
 		= DeviceFeatureChain.get<vk::PhysicalDeviceTimelineSemaphoreFeatures>();
 	DeviceTimelineFeatures.timelineSemaphore = true;
 
+	if( Vulkan12Supported )
+	{
+		DeviceFeatureChain
+			.unlink<vk::PhysicalDeviceTimelineSemaphoreFeatures>();
+	}
+	else
+	{
+		DeviceFeatureChain.unlink<vk::PhysicalDeviceVulkan12Features>();
+		DeviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+	}
+
+	DeviceInfo.ppEnabledExtensionNames = DeviceExtensions.data();
+	DeviceInfo.enabledExtensionCount   = DeviceExtensions.size();
+
 	DeviceInfo.pNext = &DeviceFeatureChain.get();
 
 	static const float QueuePriority = 1.0f;
@@ -265,13 +370,46 @@ int main(int argc, char* argv[])
 	const Vulkan::Context VulkanContext{
 		Device.get(), PhysicalDevice, RenderQueue, 0, TransferQueue, 0};
 
-	VkBlam::Renderer Renderer = VkBlam::Renderer::Create(VulkanContext).value();
+	VkBlam::RendererConfig RendererConfig = {};
+	RendererConfig.PipelineCachePath      = PipelineCachePath;
+
+	VkBlam::Renderer Renderer
+		= VkBlam::Renderer::Create(VulkanContext, RendererConfig).value();
+
+	VkBlam::SceneConfig SceneConfig = {};
+	SceneConfig.GPUCulling
+		= Vulkan12Supported && DeviceVulkan12Features.drawIndirectCount;
+	SceneConfig.DrawIndirectFirstInstance
+		= DeviceFeatures.drawIndirectFirstInstance;
+	SceneConfig.MultiDrawIndirect = DeviceFeatures.multiDrawIndirect;
+	SceneConfig.OcclusionCulling = OcclusionCulling;
+	SceneConfig.BindlessTextures = Vulkan12Supported && BindlessSupported;
+	SceneConfig.RecordingThreads = std::thread::hardware_concurrency();
+	SceneConfig.DepthPrepass     = DepthPrepass;
+	SceneConfig.LODCount         = LODCount;
+	SceneConfig.LODCachePath     = LODCachePath;
+	SceneConfig.BSPMemoryBudget  = BSPMemoryBudget;
+	if( PipelineStatisticsSupported )
+	{
+		SceneConfig.InheritedPipelineStatistics
+			= vk::QueryPipelineStatisticFlagBits::eFragmentShaderInvocations;
+	}
 
-	VkBlam::Scene CurScene = VkBlam::Scene::Create(Renderer, CurWorld).value();
+	VkBlam::Scene CurScene
+		= VkBlam::Scene::Create(Renderer, CurWorld, SceneConfig).value();
 
 	//// Main Render Pass
-	vk::UniqueRenderPass MainRenderPass
-		= CreateMainRenderPass(Device.get(), VkBlam::RenderSamples);
+	// With a late phase, the frame is split across two render passes around
+	// the building of the scene's depth-pyramid. The attachments are kept
+	// between them
+	vk::UniqueRenderPass MainRenderPass = CreateMainRenderPass(
+		Device.get(), VkBlam::RenderSamples, vk::AttachmentLoadOp::eClear,
+		CurScene.HasLatePhase() ? vk::AttachmentStoreOp::eStore
+								: vk::AttachmentStoreOp::eDontCare
+	);
+	vk::UniqueRenderPass LateRenderPass = CreateMainRenderPass(
+		Device.get(), VkBlam::RenderSamples, vk::AttachmentLoadOp::eLoad
+	);
 
 	vk::UniqueBuffer       StagingBuffer       = {};
 	vk::UniqueDeviceMemory StagingBufferMemory = {};
@@ -410,8 +548,9 @@ int main(int argc, char* argv[])
 	RenderImageDepthInfo.mipLevels   = 1;
 	RenderImageDepthInfo.arrayLayers = 1;
 	RenderImageDepthInfo.tiling      = vk::ImageTiling::eOptimal;
-	RenderImageDepthInfo.usage
-		= vk::ImageUsageFlagBits::eDepthStencilAttachment;
+	// Sampled when building the scene's depth-pyramid
+	RenderImageDepthInfo.usage = vk::ImageUsageFlagBits::eDepthStencilAttachment
+							   | vk::ImageUsageFlagBits::eSampled;
 	RenderImageDepthInfo.sharingMode   = vk::SharingMode::eExclusive;
 	RenderImageDepthInfo.initialLayout = vk::ImageLayout::eUndefined;
 
@@ -601,6 +740,31 @@ int main(int argc, char* argv[])
 		return EXIT_FAILURE;
 	}
 
+	//// Create Query Pool
+	vk::UniqueQueryPool StatisticsQueryPool = {};
+	if( PipelineStatisticsSupported )
+	{
+		vk::QueryPoolCreateInfo QueryPoolInfo = {};
+		QueryPoolInfo.queryType  = vk::QueryType::ePipelineStatistics;
+		QueryPoolInfo.queryCount = 1;
+		QueryPoolInfo.pipelineStatistics
+			= SceneConfig.InheritedPipelineStatistics;
+
+		if( auto CreateResult = Device->createQueryPoolUnique(QueryPoolInfo);
+			CreateResult.result == vk::Result::eSuccess )
+		{
+			StatisticsQueryPool = std::move(CreateResult.value);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error creating query pool: %s\n",
+				vk::to_string(CreateResult.result).c_str()
+			);
+			return EXIT_FAILURE;
+		}
+	}
+
 	//// Create Command Buffer
 	vk::CommandBufferAllocateInfo CommandBufferInfo = {};
 	CommandBufferInfo.commandPool                   = CommandPool.get();
@@ -639,6 +803,40 @@ int main(int argc, char* argv[])
 			CommandBuffer.get(), {1.0, 0.0, 1.0, 1.0}, "Frame"
 		);
 
+		const auto WorldBounds = CurWorld.GetWorldBounds();
+
+		const glm::vec3 WorldCenter
+			= glm::mix(WorldBounds[0], WorldBounds[1], 0.5);
+
+		const glm::f32 MaxExtent
+			= glm::compMax(glm::xyz(WorldBounds[1] - WorldBounds[0])) / 2.0f;
+
+		const glm::vec3 ViewPosition
+			= glm::vec3(WorldBounds[1].x, WorldBounds[1].y, MaxExtent) * 1.5f;
+
+		const auto View = glm::lookAt<glm::f32>(
+			ViewPosition,
+			// glm::vec3(WorldCenter.x, WorldCenter.y, WorldBoundMax.z),
+			glm::vec3(WorldCenter.x, WorldCenter.y, WorldBounds[0].z),
+			glm::vec3(0, 0, 1)
+		);
+
+		const auto Projection
+			// = glm::ortho<glm::f32>(
+			// 	-MaxExtent, MaxExtent, -MaxExtent, MaxExtent, 0.0f,
+			// 	WorldBoundMax.z - WorldBoundMin.z);
+			= glm::perspective<glm::f32>(
+				glm::radians(60.0f),
+				static_cast<float>(RenderSize.x) / RenderSize.y, 1.0f, 1000.0f
+			);
+
+		VkBlam::SceneView SceneView(View, Projection, RenderSize);
+
+		// Cull clusters that are not potentially-visible from the view
+		CurScene.SetViewPosition(ViewPosition);
+
+		CurScene.PrepareRender(SceneView, CommandBuffer.get());
+
 		{
 			Vulkan::DebugLabelScope RenderPassScope(
 				CommandBuffer.get(), {1.0, 1.0, 0.0, 1.0}, "Main Render Pass"
@@ -658,43 +856,54 @@ int main(int argc, char* argv[])
 			RenderBeginInfo.renderArea.extent.width  = RenderSize.x;
 			RenderBeginInfo.renderArea.extent.height = RenderSize.y;
 			RenderBeginInfo.framebuffer              = RenderFramebuffer.get();
+
+			if( StatisticsQueryPool )
+			{
+				CommandBuffer->resetQueryPool(StatisticsQueryPool.get(), 0, 1);
+				CommandBuffer->beginQuery(StatisticsQueryPool.get(), 0, {});
+			}
+
 			CommandBuffer->beginRenderPass(
-				RenderBeginInfo, vk::SubpassContents::eInline
+				RenderBeginInfo, CurScene.GetSubpassContents()
 			);
 
 			// Draw
+			CurScene.Render(SceneView, CommandBuffer.get());
 
-			const auto WorldBounds = CurWorld.GetWorldBounds();
-
-			const glm::vec3 WorldCenter
-				= glm::mix(WorldBounds[0], WorldBounds[1], 0.5);
-
-			const glm::f32 MaxExtent
-				= glm::compMax(glm::xyz(WorldBounds[1] - WorldBounds[0]))
-				/ 2.0f;
+			CommandBuffer->endRenderPass();
 
-			const auto View = glm::lookAt<glm::f32>(
-				glm::vec3(WorldBounds[1].x, WorldBounds[1].y, MaxExtent) * 1.5f,
-				// glm::vec3(WorldCenter.x, WorldCenter.y, WorldBoundMax.z),
-				glm::vec3(WorldCenter.x, WorldCenter.y, WorldBounds[0].z),
-				glm::vec3(0, 0, 1)
-			);
+			// Draw anything that the depth of the first render pass did not
+			// occlude
+			if( CurScene.HasLatePhase() )
+			{
+				CurScene.PrepareLateRender(
+					SceneView, CommandBuffer.get(), RenderImageDepth.get(),
+					RenderImageDepthView.get()
+				);
 
-			const auto Projection
-				// = glm::ortho<glm::f32>(
-				// 	-MaxExtent, MaxExtent, -MaxExtent, MaxExtent, 0.0f,
-				// 	WorldBoundMax.z - WorldBoundMin.z);
-				= glm::perspective<glm::f32>(
-					glm::radians(60.0f),
-					static_cast<float>(RenderSize.x) / RenderSize.y, 1.0f,
-					1000.0f
+				RenderBeginInfo.renderPass = LateRenderPass.get();
+				CommandBuffer->beginRenderPass(
+					RenderBeginInfo, CurScene.GetSubpassContents()
 				);
 
-			VkBlam::SceneView SceneView(View, Projection, RenderSize);
+				CurScene.RenderLate(SceneView, CommandBuffer.get());
 
-			CurScene.Render(SceneView, CommandBuffer.get());
+				CommandBuffer->endRenderPass();
+			}
 
-			CommandBuffer->endRenderPass();
+			const VkBlam::RenderStats& SceneStats = CurScene.GetRenderStats();
+			std::fprintf(
+				stdout,
+				"Draws: %u | Binds: %u | State changes: %u | Depth pre-pass "
+				"draws: %u | Object triangles saved: %u\n",
+				SceneStats.Draws, SceneStats.Binds, SceneStats.StateChanges,
+				SceneStats.DepthPrepassDraws, SceneStats.ObjectTrianglesSaved
+			);
+
+			if( StatisticsQueryPool )
+			{
+				CommandBuffer->endQuery(StatisticsQueryPool.get(), 0);
+			}
 		}
 
 		// Wait for image data to be ready
@@ -746,6 +955,10 @@ int main(int argc, char* argv[])
 
 	const std::uint64_t UploadTick = Renderer.GetStreamBuffer().Flush();
 
+	// Uniform data pushed by this frame is in use until this submission is
+	// done
+	const std::uint64_t UniformTick = Renderer.GetUniformRingBuffer().Fence();
+
 	// Submit work
 	vk::UniqueFence Fence = {};
 	if( auto CreateResult = Device->createFenceUnique({});
@@ -773,8 +986,9 @@ int main(int argc, char* argv[])
 	SubmitInfo.waitSemaphoreCount = 1;
 	SubmitInfo.pWaitSemaphores    = &Renderer.GetStreamBuffer().GetSemaphore();
 
+	// Streamed data may be read by compute as well as graphics work
 	static const vk::PipelineStageFlags WaitStage
-		= vk::PipelineStageFlagBits::eTransfer;
+		= vk::PipelineStageFlagBits::eAllCommands;
 	SubmitInfo.pWaitDstStageMask = &WaitStage;
 
 	auto& SubmitTimelineInfo
@@ -783,6 +997,13 @@ int main(int argc, char* argv[])
 	SubmitTimelineInfo.waitSemaphoreValueCount = 1;
 	SubmitTimelineInfo.pWaitSemaphoreValues    = &UploadTick;
 
+	SubmitInfo.signalSemaphoreCount = 1;
+	SubmitInfo.pSignalSemaphores
+		= &Renderer.GetUniformRingBuffer().GetSemaphore();
+
+	SubmitTimelineInfo.signalSemaphoreValueCount = 1;
+	SubmitTimelineInfo.pSignalSemaphoreValues    = &UniformTick;
+
 	if( auto SubmitResult = RenderQueue.submit(SubmitInfo, Fence.get());
 		SubmitResult != vk::Result::eSuccess )
 	{
@@ -804,6 +1025,32 @@ int main(int argc, char* argv[])
 		return EXIT_FAILURE;
 	}
 
+	if( StatisticsQueryPool )
+	{
+		std::uint64_t FragmentInvocations = 0;
+		if( auto GetResult = Device->getQueryPoolResults(
+				StatisticsQueryPool.get(), 0, 1, sizeof(FragmentInvocations),
+				&FragmentInvocations, sizeof(FragmentInvocations),
+				vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait
+			);
+			GetResult == vk::Result::eSuccess )
+		{
+			std::fprintf(
+				stdout,
+				"Fragment-shader invocations: %" PRIu64
+				" | Depth pre-pass: %s\n",
+				FragmentInvocations, DepthPrepass ? "on" : "off"
+			);
+		}
+		else
+		{
+			std::fprintf(
+				stderr, "Error getting query pool results: %s\n",
+				vk::to_string(GetResult).c_str()
+			);
+		}
+	}
+
 #ifdef CAPTURE
 	if( rdoc_api )
 		rdoc_api->EndFrameCapture(